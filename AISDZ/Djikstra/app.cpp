@@ -15,6 +15,8 @@
     do wydruku;
   - maksymalna ilosc linii do wydruku na ekranie mozna ograniczyc ze wzgledow
     praktycznych wartoscia identyfikatora MAX_LINES (przyjeto 1000 linii);
+  - macierze odleglosci drukowane sa na ekranie tylko dla malych grafow
+    (o ilosci wezlow nie wiekszej niz MAX_COLUMNS, tj. 20);
   - jedna instancja aplikacji moze pracowac nad jednym projektem.
 
   Autor:  Artur Cyrwus                                    Data:  08-06-2021 r.
@@ -22,12 +24,24 @@
 ---------------------------------------------------------------------------- */
 
 #include <string>
+#include <cstdio>
 #include <iostream>
 #include <fstream>
+#include <sstream>
+#include <chrono>
 #include "app.h"
 #include "project.h"
 #include "engine/graph.h"
 #include "engine/dsp.h"
+#include "engine/alt.h"
+#include "engine/ch.h"
+#include "engine/delta.h"
+#include "engine/bfs.h"
+#include "engine/floyd.h"
+#include "engine/table.h"
+#include "engine/many.h"
+#include "engine/parallel.h"
+#include "engine/dynamic.h"
 #include "shell/dlgs.h"
 
 using namespace std;
@@ -56,6 +70,16 @@ int cmdGraphInfo(TProject *P);
 int cmdNodeInfo(TProject *P);
 int cmdEdgeInfo(TProject *P);
 int cmdPathfinder(TProject *P);
+int cmdQueueSetup(TProject *P);
+int cmdModeSetup(TProject *P);
+int cmdBatchQueries(TProject *P);
+int cmdOracle(TProject *P);
+int cmdParallel(TProject *P);
+int cmdAllPairs(TProject *P);
+int cmdWeightUpdates(TProject *P);
+int cmdDetour(TProject *P);
+int cmdAlternatives(TProject *P);
+int cmdFacilities(TProject *P);
 
 //---
 
@@ -146,6 +170,80 @@ int runApp() {
                         status = cmdPathfinder(P);
                       break;
 
+            /* Obsluga polecenia "wybor rodzaju kolejki priorytetowej" */
+            case 'k': cKey = 'K';
+            case 'K': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdQueueSetup(P);
+                      break;
+
+            /* Obsluga polecenia "wybor trybu wyszukiwania najkrotszej sciezki" */
+            case 'm': cKey = 'M';
+            case 'M': status = cmdModeSetup(P);
+                      break;
+
+            /* Obsluga polecenia "obliczenia wsadowe" */
+            case 'b': cKey = 'B';
+            case 'B': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdBatchQueries(P);
+                      break;
+
+            /* Obsluga polecenia "wyrocznia dystansow" */
+            case 'o': cKey = 'O';
+            case 'O': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdOracle(P);
+                      break;
+
+            /* Obsluga polecenia "obliczenia rownolegle" */
+            case 'w': cKey = 'W';
+            case 'W': status = cmdParallel(P);
+                      break;
+
+            /* Obsluga polecenia "odleglosci pomiedzy wszystkimi parami wezlow" */
+            case 'a': cKey = 'A';
+            case 'A': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdAllPairs(P);
+                      break;
+
+            /* Obsluga polecenia "zmiany wag krawedzi" */
+            case 'u': cKey = 'U';
+            case 'U': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdWeightUpdates(P);
+                      break;
+
+            /* Obsluga polecenia "objazdy" */
+            case 'z': cKey = 'Z';
+            case 'Z': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdDetour(P);
+                      break;
+
+            /* Obsluga polecenia "sciezki alternatywne" */
+            case 'y': cKey = 'Y';
+            case 'Y': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdAlternatives(P);
+                      break;
+
+            /* Obsluga polecenia "obiekty uslugowe" */
+            case 'f': cKey = 'F';
+            case 'F': if (P->blank)
+                          msgEmptyProject();
+                      else
+                        status = cmdFacilities(P);
+                      break;
+
             /* Obsluga polecenia "ekran pomocy o funkcjach programu" */
             case 'h': cKey = 'H';
             case 'H': wndHelp();
@@ -394,8 +492,78 @@ int cmdPathfinder(TProject *P) {
     if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK)
         return CMD_CANCEL;
 
+    // W opcji 2. wezel koncowy okreslany jest przed obliczeniami,
+    // aby eksploracja grafu mogla zakonczyc sie z chwila jego zwiedzenia
+    int stopId = -1;
+    if (option == 2)
+        if (dlgNodeId("\nPodaj wezel koncowy", 0, n -1, stopId) != DLG_OK)
+            return CMD_CANCEL;
+
+    // W opcji 3. zasieg okreslany jest przed obliczeniami, aby eksploracja
+    // grafu mogla zakonczyc sie z chwila jego przekroczenia
+    int range = 0;
+    if (option == 3)
+        if (dlgNumber("\nPodaj zasieg (dystans od wezla zrodlowego)", 0, 2147483646, range) != DLG_OK)
+            return CMD_CANCEL;
+
+    // Sprawdzenie czy wyniki sa juz w pamieci podrecznej drzew (wowczas
+    // eksploracja grafu jest zbedna)
+    bool cached = (option != 3) && isCached(P->trees, startId);
+
+    // Tablica Id wezlow w zasiegu (opcja 3.)
+    int *Ids = (option == 3) ? new int[n] : NULL;
+    int count = 0;
+
     // Eksploracja grafu w poszukiwaniu najkrotszych sciezek
-    exploreGraph(P->journal, P->graph, startId);
+    // (z pomiarem czasu obliczen)
+    // - w opcji 1. rownolegle (o ile graf jest duzy i przydzielono watki)
+    // - w opcji 2. w trybie wybranym w projekcie
+    // - w opcji 3. tylko do wyczerpania wezlow w zasiegu
+    auto tStart = chrono::steady_clock::now();
+    if (option == 2)
+         findPath(P, startId, stopId);
+    else if (option == 3)
+         count = findRange(P, startId, range, Ids);
+    else findAllPaths(P, startId);
+    auto tStop = chrono::steady_clock::now();
+
+    if (option == 3)
+    {
+        // Nalozenie ograniczenia ilosci drukowanych linii
+        int m = (count > MAX_LINES) ? MAX_LINES : count;
+
+        // Obrobka wynikow, tj. dla kazdego wezla w zasiegu (w kolejnosci
+        // niemalejacych dystansow) wygenerowanie wiersza do wydruku wynikow
+        string **S = new string*[m];
+        for (int i = 0; i < m; i++)
+        {
+            TEntry item = entry(P->journal, Ids[i]);
+            S[i] = new string[3];
+            S[i][0] = to_string(item.Id);                // kol. "do wezla"
+            S[i][1] = to_string(item.distance);          // kol. "dystans"
+            if (item.prevId == -1)
+                 S[i][2] = "-";
+            else S[i][2] = to_string(item.prevId);       // kol. "przez wezel"
+        }
+        // Wydrukowanie listy najkrotszych drog do wezlow w zasiegu, ...
+        wndPaths(startId, S, m);
+        // ... z ewentualnym uzupelnieniem komunikatu o ilosci wierszy
+        if (count > m)
+            cout << " z " << count << " (wydruk ograniczony)";
+        cout << "\nW zasiegu " << range << " od wezla " << startId;
+        cout << " jest " << count << " z " << n << " wezlow";
+        cout << "\n\n";
+
+        // Skasowanie tablicy napisow i tablicy Id wezlow
+        for (int i = 0; i < m; i++) {
+            delete[] S[i];
+            S[i] = NULL;
+        }
+        delete[] S;
+        S = NULL;
+        delete[] Ids;
+        Ids = NULL;
+    }
 
     if (option == 1)
     {
@@ -407,16 +575,16 @@ int cmdPathfinder(TProject *P) {
         // ... dla kazdego wezla, ...
         for (int i = 0; i < m; i++)
         {
-            TEntry *item = entry(P->journal, i);
+            TEntry item = entry(P->journal, i);
             // ... wygenerowanie wiersza do wydruku wynikow
             S[i] = new string[3];
-            S[i][0] = to_string(item->Id);               // kol. "do wezla"
-            if (item->distance == 2147483647)
+            S[i][0] = to_string(item.Id);                // kol. "do wezla"
+            if (item.distance == 2147483647)
                  S[i][1] = "-";
-            else S[i][1] = to_string(item->distance);    // kol. "dystans"
-            if (item->prevId == -1)
+            else S[i][1] = to_string(item.distance);     // kol. "dystans"
+            if (item.prevId == -1)
                  S[i][2] = "-";
-            else S[i][2] = to_string(item->prevId);      // kol. "przez wezel"
+            else S[i][2] = to_string(item.prevId);       // kol. "przez wezel"
         }
         // Wydrukowanie listy najkrotszych drog, ...
         wndPaths(startId, S, m);
@@ -434,12 +602,8 @@ int cmdPathfinder(TProject *P) {
         S = NULL;
     }
 
-    int stopId;
     if (option == 2)
     {
-        if (dlgNodeId("\nPodaj wezel koncowy", 0, n -1, stopId) != DLG_OK)
-            return CMD_CANCEL;
-
         // Zebranie sekwencji wezlow po najkrotszej sciezce
         int *Ids = new int[n];
         int c = shortestPath(P->journal, stopId, Ids);
@@ -468,8 +632,1036 @@ int cmdPathfinder(TProject *P) {
              cout << "-";
         else cout << d;
         cout << "\n\n";
+
+        // Skasowanie tablicy sekwencji wezlow
+        delete[] Ids;
+    }
+
+    // Wydruk statystyki obliczen
+    if (cached)
+        cout << "Wyniki odczytano z pamieci podrecznej drzew najkrotszych sciezek\n";
+    cout << "Operacje porzadkowania kolejki priorytetowej: ";
+    cout << P->journal->sifts;
+    cout << "\nIlosc zwiedzonych wezlow: ";
+    cout << P->journal->settled;
+    cout << "\nCzas obliczen [us]: ";
+    cout << chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+    cout << "\n\n";
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+#undef MAX_LINES
+
+
+
+
+int cmdQueueSetup(TProject *P) {
+    // Wydrukowanie dostepnych rodzajow kolejki priorytetowej, ...
+    mnuOptionsQueue(P->journal->queue);
+    // ... oraz dialog, w celu wyboru jednego z nich
+    int option = dlgOptions(7);
+    if (option == DLG_CANCEL)
+        return CMD_OK;
+
+    // Kolejka kubelkowa Diala ma tyle kubelkow, ile wynosi najwieksza waga
+    // krawedzi + 1, wiec nie jest dostepna dla grafow o duzych wagach
+    if (option -1 == qkBuckets && P->graph->profile[gpMaxWeight] > DIAL_MAX_WEIGHT) {
+        msgNoBuckets(P->graph->profile[gpMaxWeight], DIAL_MAX_WEIGHT);
+        return CMD_CANCEL;
+    }
+
+    // Zapisanie w dzienniku obliczen wybranego rodzaju kolejki
+    // (obowiazuje od nastepnych obliczen)
+    P->journal->queue = option -1;
+    cout << "\nZmieniono rodzaj kolejki priorytetowej.\n\n";
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+
+
+int cmdModeSetup(TProject *P) {
+    // Wydrukowanie dostepnych trybow wyszukiwania najkrotszej sciezki, ...
+    mnuOptionsMode(P->mode);
+    // ... oraz dialog, w celu wyboru jednego z nich
+    int option = dlgOptions(5);
+    if (option == DLG_CANCEL)
+        return CMD_OK;
+
+    // Zapisanie w projekcie wybranego trybu
+    // (obowiazuje od nastepnych obliczen)
+    P->mode = option -1;
+    cout << "\nZmieniono tryb wyszukiwania najkrotszej sciezki.\n\n";
+
+    // Obliczenia wstepne wybranego trybu (o ile sa potrzebne i wczytano
+    // juz dane) z wydrukiem raportu
+    if (prepareEngine(P))
+        switch (P->mode) {
+            case pmLandmarks : msgLandmarks(P->landmarks->count, P->landmarks->time, P->landmarks->memory);
+                               break;
+            case pmHierarchy : msgHierarchy(P->hierarchy->shortcuts, P->hierarchy->time);
+                               break;
+            case pmArcFlags  : msgArcFlags(P->arcFlags->cells, P->arcFlags->boundary,
+                                           P->arcFlags->time, P->arcFlags->memory);
+                               break;
+        }
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+
+
+#define MAX_LINES  1000
+
+
+int cmdBatchQueries(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie informacji o pliku zapytan
+    msgBatchInfo();
+
+    // Interakcja: wczytanie nazwy pliku zapytan ...
+    string name = dlgFilename();
+
+    // ... i proba jego otwarcia ...
+    ifstream fsInput(name.c_str());
+    if (! fsInput.is_open()) {
+        // ... i ewentualne zakonczenie, gdy sie nie powiodla
+        msgFileNotFound();
+        return CMD_CANCEL;
+    }
+
+    // Uzupelnienie (w razie potrzeby) obliczen wstepnych, aby nie obciazaly
+    // pomiaru czasu zapytan
+    prepareEngine(P);
+
+    // Wyniki zapytan (do wydruku) ...
+    string **S = new string*[MAX_LINES];
+    int m = 0;
+    // ... i statystyka obliczen
+    int queries = 0;
+    int rejected = 0;
+    INT64 settled = 0;
+    INT64 sifts = 0;
+    INT64 time = 0;     // [ns]
+
+    int startId, stopId;
+    // Dla kazdej pary wezlow z pliku zapytan, ...
+    while (fsInput >> startId >> stopId) {
+        // ... (z pominieciem par spoza zakresu Id wezlow) ...
+        if (startId < 0 || startId >= n || stopId < 0 || stopId >= n) {
+            rejected++;
+            continue;
+        }
+        // ... wyznaczenie dystansu (z etykiet wezlow albo silnikiem
+        // obliczeniowym w trybie wybranym w projekcie, z pomiarem czasu) ...
+        auto tStart = chrono::steady_clock::now();
+        INT64 d = findDistance(P, startId, stopId);
+        auto tStop = chrono::steady_clock::now();
+        time += chrono::duration_cast<chrono::nanoseconds>(tStop - tStart).count();
+        // ... z uaktualnieniem statystyki ...
+        queries++;
+        settled += P->journal->settled;
+        sifts += P->journal->sifts;
+        // ... i wygenerowaniem wiersza do wydruku wynikow
+        if (m < MAX_LINES) {
+            S[m] = new string[3];
+            S[m][0] = to_string(startId);                // kol. "z wezla"
+            S[m][1] = to_string(stopId);                 // kol. "do wezla"
+            if (d == 2147483647)
+                 S[m][2] = "-";
+            else S[m][2] = to_string(d);                  // kol. "dystans"
+            m++;
+        }
+    }
+    fsInput.close();
+
+    // Wydrukowanie tablicy wynikow, ...
+    wndQueries(S, m);
+    // ... z ewentualnym uzupelnieniem komunikatu o ilosci wierszy
+    if (queries > m)
+        cout << " z " << queries << " (wydruk ograniczony)";
+    cout << "\n\n";
+
+    // Skasowanie tablicy napisow
+    for (int i = 0; i < m; i++) {
+        delete[] S[i];
+        S[i] = NULL;
+    }
+    delete[] S;
+    S = NULL;
+
+    // Wydruk statystyki obliczen
+    cout << "Ilosc zapytan: " << queries;
+    if (rejected > 0)
+        cout << " (pominieto bledne: " << rejected << ")";
+    if (P->labels != NULL)
+        cout << "\nDystanse odczytano z etykiet wezlow (wyrocznia dystansow)";
+    else if (queries > 0) {
+        cout << "\nSrednia ilosc operacji porzadkowania kolejki priorytetowej: ";
+        cout << (double)sifts / queries;
+        cout << "\nSrednia ilosc zwiedzonych wezlow: ";
+        cout << (double)settled / queries;
+    }
+    if (queries > 0) {
+        cout << "\nSredni czas obliczen [us]: ";
+        cout << (double)time / queries / 1000;
+    }
+    cout << "\nCzas obliczen [us]: " << time / 1000;
+    cout << "\n\n";
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+#undef MAX_LINES
+
+
+
+
+int cmdOracle(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie dostepnych opcji wyroczni dystansow, ...
+    mnuOptionsOracle();
+    // ... oraz dialog, w celu wyboru jednej z opcji
+    int option = dlgOptions(4);
+    if (option == DLG_CANCEL)
+        return CMD_OK;
+
+    // Opcje 2. i 3. wymagaja etykiet wezlow
+    if ((option == 2 || option == 3) && P->labels == NULL) {
+        msgNoHubLabels();
+        return CMD_CANCEL;
+    }
+
+    switch (option) {
+        case 1 : {
+            // Zbudowanie etykiet wezlow i wydruk ich statystyki
+            if (! buildLabels(P)) {
+                cout << "\nEtykiety wezlow tego grafu nie mieszcza sie w pamieci.\n\n";
+                return CMD_CANCEL;
+            }
+            THubLabels *L = P->labels;
+            msgHubLabels(L->entries, n, L->maxLabel, L->memory, L->time);
+            break;
+        }
+        case 2 : {
+            int startId, stopId;
+            if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK)
+                return CMD_CANCEL;
+            if (dlgNodeId("\nPodaj wezel koncowy", 0, n -1, stopId) != DLG_OK)
+                return CMD_CANCEL;
+
+            // Odczyt dystansu z etykiet (z pomiarem czasu obliczen)
+            auto tStart = chrono::steady_clock::now();
+            INT64 d = hubDistance(P->labels, startId, stopId);
+            auto tStop = chrono::steady_clock::now();
+
+            // Wydruk dystansu dzielacego wezel koncowy od zrodlowego ...
+            cout << "\nDystans dzielacy wezel ";
+            cout << startId << " od ";
+            cout << stopId << " wynosi lacznie: ";
+            if (d == 2147483647)
+                 cout << "-";
+            else cout << d;
+            // ... i czasu obliczen
+            cout << "\nCzas obliczen [ns]: ";
+            cout << chrono::duration_cast<chrono::nanoseconds>(tStop - tStart).count();
+            cout << "\n\n";
+            break;
+        }
+        case 3 : {
+            // Zapis etykiet w pliku o podanej nazwie
+            string name = dlgFilename();
+            if (saveHubLabels(P->labels, name))
+                 cout << "\nZapisano etykiety wezlow w pliku " << name << "\n\n";
+            else cout << "\nNie udalo sie zapisac etykiet wezlow w pliku " << name << "\n\n";
+            break;
+        }
+        case 4 : {
+            // Odczyt etykiet z pliku o podanej nazwie (etykiety musza
+            // pasowac do grafu) i wydruk ich statystyki
+            string name = dlgFilename();
+            if (! loadLabels(P, name)) {
+                cout << "\nPlik " << name << " nie zawiera etykiet wezlow tego grafu.\n\n";
+                return CMD_CANCEL;
+            }
+            THubLabels *L = P->labels;
+            msgHubLabels(L->entries, n, L->maxLabel, L->memory, L->time);
+            break;
+        }
+    }
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+
+
+int cmdParallel(TProject *P) {
+    // Wydrukowanie dostepnych opcji obliczen rownoleglych, ...
+    mnuOptionsParallel(P->threads, hardwareThreads());
+    // ... oraz dialog, w celu wyboru jednej z opcji
+    int option = dlgOptions(2);
+    if (option == DLG_CANCEL)
+        return CMD_OK;
+
+    if (option == 1) {
+        // Zapisanie w projekcie podanej ilosci watkow
+        // (obowiazuje od nastepnych obliczen)
+        int threads;
+        if (dlgNumber("\nPodaj ilosc watkow (0 - wszystkie watki sprzetowe)", 0, 256, threads) != DLG_OK)
+            return CMD_CANCEL;
+        P->threads = threads;
+        cout << "\nZmieniono ilosc watkow obliczen rownoleglych.\n\n";
+        return CMD_OK;
+    }
+
+    // Test skalowania wymaga wczytanego grafu
+    if (P->blank) {
+        msgEmptyProject();
+        return CMD_CANCEL;
+    }
+    const int n = P->graph->order;
+
+    int startId;
+    if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK)
+        return CMD_CANCEL;
+
+    // Pomiar czasu obliczen silnika sekwencyjnego (wyniki w dzienniku
+    // projektu sa wzorcem do sprawdzenia zgodnosci wynikow rownoleglych)
+    auto tStart = chrono::steady_clock::now();
+    exploreGraph(P->journal, P->graph, startId);
+    auto tStop = chrono::steady_clock::now();
+    // (dziennik zawiera teraz pelne drzewo najkrotszych sciezek)
+    P->source = startId;
+    INT64 tSeq = chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+
+    // Ilosci watkow do pomiaru: kolejne potegi dwojki, az do ilosci watkow
+    // sprzetowych (wlacznie)
+    int hardware = hardwareThreads();
+    int m = 1;
+    for (int t = 1; t < hardware; t *= 2)
+        m++;
+
+    // Dziennik obliczen rownoleglych ...
+    TJournal *J = initJournal(n);
+    // ... i tablica wierszy wyniku (pierwszy wiersz - silnik sekwencyjny)
+    string **S = new string*[m +1];
+    S[0] = new string[4];
+    S[0][0] = "sekw.";
+    S[0][1] = to_string(tSeq);
+    S[0][2] = "1.00";
+    S[0][3] = "wzorzec";
+    for (int i = 1, t = 1; i <= m; i++, t = (2 * t < hardware) ? 2 * t : hardware) {
+        // Pomiar czasu obliczen algorytmu delta-stepping ...
+        tStart = chrono::steady_clock::now();
+        exploreParallel(J, P->graph, startId, t, 0);
+        tStop = chrono::steady_clock::now();
+        INT64 tPar = chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+        // ... i sprawdzenie zgodnosci wszystkich wpisow z wzorcem
+        bool same = true;
+        for (int v = 0; v < n; v++) {
+            TEntry a = entry(J, v);
+            TEntry b = entry(P->journal, v);
+            if (a.distance != b.distance || a.prevId != b.prevId || a.visited != b.visited)
+                same = false;
+        }
+        // Wygenerowanie wiersza do wydruku wynikow
+        char speedup[16];
+        snprintf(speedup, sizeof(speedup), "%.2f", (tPar > 0) ? (double)tSeq / tPar : 0.0);
+        S[i] = new string[4];
+        S[i][0] = to_string(t);
+        S[i][1] = to_string(tPar);
+        S[i][2] = speedup;
+        S[i][3] = same ? "TAK" : "NIE";
+    }
+
+    // Wydrukowanie szerokosci kubelka i tablicy pomiarow
+    cout << "\nSzerokosc kubelka (delta): " << chooseDelta(P->graph) << "\n";
+    wndScaling(S, m +1);
+
+    // Skasowanie tablicy napisow i dziennika obliczen rownoleglych
+    for (int i = 0; i <= m; i++)
+        delete[] S[i];
+    delete[] S;
+    killJournal(J);
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+#define MAX_COLUMNS  20
+
+
+INT64 _matrixCell(TProject *P, char kind, int i, int j) {
+    // Odczyt komorki wybranej macierzy (odleglosci w krawedziach, dystansow
+    // algorytmu Floyda-Warshalla albo tablicy dystansow), z brakiem drogi
+    // oznaczonym jak w dzienniku obliczen
+    switch (kind) {
+        case 'h' : return (hopCount(P->hops, i, j) != HOPS_NONE) ? hopCount(P->hops, i, j) : 2147483647;
+        case 'd' : return matrixDistance(P->distances, i, j);
+        default  : return tableDistance(P->table, i, j);
+    }
+}
+
+
+void _printMatrix(string title, TProject *P, char kind) {
+    const int n = P->graph->order;
+
+    // Obrobka danych, tj. wygenerowanie naglowka (Id wezlow koncowych)
+    // i wierszy macierzy (z Id wezla zrodlowego) ...
+    string **S = new string*[n +1];
+    for (int i = 0; i <= n; i++) {
+        S[i] = new string[n +1];
+        for (int j = 1; j <= n; j++) {
+            INT64 d = (i > 0) ? _matrixCell(P, kind, i -1, j -1) : j -1;
+            if (d == 2147483647)
+                 S[i][j] = "-";
+            else S[i][j] = to_string(d);
+        }
+        S[i][0] = to_string(i -1);
+    }
+    // ... i wydrukowanie macierzy
+    wndMatrix(title, S, n, n);
+    cout << "\n";
+
+    // Skasowanie tablicy napisow
+    for (int i = 0; i <= n; i++)
+        delete[] S[i];
+    delete[] S;
+}
+
+
+int _readIds(istream &is, int n, int* &Ids) {
+    // Wczytanie linii z Id wezlow (z pominieciem Id spoza zakresu)
+    // do nowej tablicy i zwrocenie ich ilosci
+    string line;
+    getline(is, line);
+    istringstream ss(line);
+    int count = 0;
+    Ids = new int[line.size() / 2 +1];
+    int Id;
+    while (ss >> Id)
+        if (Id >= 0 && Id < n)
+            Ids[count++] = Id;
+    return count;
+}
+
+
+int _manyToMany(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie informacji o pliku zbiorow wezlow
+    msgManyInfo();
+
+    // Interakcja: wczytanie nazwy pliku ...
+    string name = dlgFilename();
+    // ... i proba jego otwarcia ...
+    ifstream fsInput(name.c_str());
+    if (! fsInput.is_open()) {
+        // ... i ewentualne zakonczenie, gdy sie nie powiodla
+        msgFileNotFound();
+        return CMD_CANCEL;
+    }
+
+    // Wczytanie zbiorow wezlow zrodlowych i docelowych
+    int *sourceIds, *targetIds;
+    int rows = _readIds(fsInput, n, sourceIds);
+    int cols = _readIds(fsInput, n, targetIds);
+    fsInput.close();
+
+    // Wyznaczenie tablicy dystansow ...
+    TManyTable *M = findDistances(P, rows, sourceIds, cols, targetIds);
+    delete[] sourceIds;
+    delete[] targetIds;
+    if (M == NULL) {
+        cout << "\nPlik " << name << " nie zawiera zbiorow wezlow tego grafu.\n\n";
+        return CMD_CANCEL;
+    }
+
+    // ... i wydruk tablicy (tylko dla malych zbiorow)
+    if (rows <= MAX_COLUMNS && cols <= MAX_COLUMNS) {
+        string **S = new string*[rows +1];
+        for (int i = 0; i <= rows; i++) {
+            S[i] = new string[cols +1];
+            S[i][0] = (i > 0) ? to_string(M->sourceIds[i -1]) : "";
+            for (int j = 1; j <= cols; j++) {
+                INT64 d = (i > 0) ? manyDistance(M, i -1, j -1) : M->targetIds[j -1];
+                if (d == 2147483647)
+                     S[i][j] = "-";
+                else S[i][j] = to_string(d);
+            }
+        }
+        wndMatrix("Tablica dystansow pomiedzy zbiorami wezlow", S, rows, cols);
+        for (int i = 0; i <= rows; i++)
+            delete[] S[i];
+        delete[] S;
+    }
+    else cout << "\nWydruk tablicy ograniczono do zbiorow o " << MAX_COLUMNS << " wezlach.\n";
+    // Wydruk statystyki obliczen ...
+    msgManyTable(M->buckets, M->settled, M->rows + ((M->buckets > 0) ? M->cols : 0), M->time);
+
+    // ... i ewentualny zapis tablicy w pliku o podanej nazwie
+    if (dlgSaveTable() == DLG_OK) {
+        name = dlgFilename();
+        if (saveManyTable(M, name))
+             cout << "\nZapisano tablice w pliku " << name << "\n\n";
+        else cout << "\nNie udalo sie zapisac tablicy w pliku " << name << "\n\n";
+    }
+
+    // Skasowanie tablicy dystansow
+    killManyTable(M);
+    return CMD_OK;
+}
+
+
+int cmdAllPairs(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie dostepnych opcji obliczen dla wszystkich par wezlow, ...
+    mnuOptionsAllPairs();
+    // ... oraz dialog, w celu wyboru jednej z opcji
+    int option = dlgOptions(8);
+    if (option == DLG_CANCEL)
+        return CMD_OK;
+
+    // Opcje 4. i 7. wymagaja macierzy dystansow, opcja 6. - macierzy
+    // odleglosci, a opcja 5. - ktorejkolwiek z macierzy
+    if (((option == 4 || option == 7) && P->distances == NULL)
+     || (option == 6 && P->hops == NULL)
+     || (option == 5 && P->distances == NULL && P->hops == NULL && P->table == NULL)) {
+        msgNoMatrix();
+        return CMD_CANCEL;
+    }
+
+    // Opcja 8. prowadzi wlasny dialog
+    if (option == 8)
+        return _manyToMany(P);
+
+    switch (option) {
+        case 1 : {
+            // Wyznaczenie macierzy odleglosci w krawedziach ...
+            buildHops(P);
+            THopMatrix *H = P->hops;
+            // ... i wydruk jej statystyki (srednia po parach z droga)
+            INT64 sum = 0;
+            for (INT64 i = 0; i < (INT64)n * n; i++)
+                if (H->hops[i] != HOPS_NONE)
+                    sum += H->hops[i];
+            INT64 pairs = (INT64)n * n - H->unreachable - n;
+            msgHopMatrix(H->diameter, (pairs > 0) ? (double)sum / pairs : 0,
+                         H->unreachable, H->memory, H->time);
+            break;
+        }
+        case 2 : {
+            // Wyznaczenie macierzy dystansow i nastepnikow ...
+            if (! buildDistances(P)) {
+                cout << "\nDystanse w tym grafie nie mieszcza sie w macierzy dystansow.\n\n";
+                return CMD_CANCEL;
+            }
+            // ... i wydruk ich statystyki
+            TDistMatrix *M = P->distances;
+            msgDistMatrix(M->diameter, M->memory, M->time);
+            break;
+        }
+        case 3 : {
+            // Wybor pliku, w ktorym zostanie odwzorowana tablica (albo
+            // tablica w pamieci operacyjnej) ...
+            string name = "";
+            if (dlgMapFile() == DLG_OK)
+                name = dlgFilename();
+            // ... wyznaczenie dystansow od wszystkich wezlow zrodlowych ...
+            if (! buildTable(P, name)) {
+                cout << "\nNie udalo sie utworzyc tablicy dystansow w pliku " << name << "\n\n";
+                return CMD_CANCEL;
+            }
+            // ... i wydruk statystyki obliczen
+            TDistTable *T = P->table;
+            msgDistTable(T->settled, T->memory, T->time);
+            if (T->mapped)
+                cout << "Tablica dystansow zapisywana jest w pliku " << name << "\n\n";
+            break;
+        }
+        case 4 : {
+            int startId, stopId;
+            if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK)
+                return CMD_CANCEL;
+            if (dlgNodeId("\nPodaj wezel koncowy", 0, n -1, stopId) != DLG_OK)
+                return CMD_CANCEL;
+
+            // Zebranie sekwencji wezlow po najkrotszej sciezce
+            int *Ids = new int[n];
+            int c = matrixPath(P->distances, startId, stopId, Ids);
+
+            cout << "\nNajkrotsza sciezka z wezla ";
+            cout << startId << " do ";
+            cout << stopId << " to:  ";
+            // Wydruk sekwencji wezlow po najkrotszej sciezce, ...
+            if (c == 1 && Ids[0] == stopId) {
+                cout << "-";
+            }
+            else
+                for (int i = 0; i < c; i++) {
+                    // ... Id wezla
+                    cout << Ids[i];
+                    // (wstawienie separatora)
+                    cout << ((i < c -1) ? "-" : "");
+                }
+            cout << "\n";
+            // Wydruk dystansu dzielacego wezel koncowy od zrodlowego
+            cout << "Dystans dzielacy wezel ";
+            cout << startId << " od ";
+            cout << stopId << " wynosi lacznie: ";
+            INT64 d = matrixDistance(P->distances, startId, stopId);
+            if (d == 2147483647)
+                 cout << "-";
+            else cout << d;
+            cout << "\n\n";
+
+            // Skasowanie tablicy sekwencji wezlow
+            delete[] Ids;
+            break;
+        }
+        case 5 : {
+            // Wydruk macierzy tylko dla malych grafow (ograniczenie
+            // ilosci kolumn)
+            if (n > MAX_COLUMNS) {
+                cout << "\nWydruk macierzy ograniczono do grafow o " << MAX_COLUMNS << " wezlach.";
+                cout << "\nMacierze mozna zapisac w pliku na dysku.\n\n";
+                return CMD_CANCEL;
+            }
+            // Wydruk wyznaczonych macierzy
+            if (P->hops != NULL)
+                _printMatrix("Macierz odleglosci (w krawedziach) pomiedzy wezlami", P, 'h');
+            if (P->distances != NULL)
+                _printMatrix("Macierz dystansow pomiedzy wezlami", P, 'd');
+            if (P->table != NULL)
+                _printMatrix("Tablica dystansow od wszystkich wezlow zrodlowych", P, 't');
+            break;
+        }
+        case 6 :
+        case 7 : {
+            // Zapis macierzy w pliku o podanej nazwie
+            string name = dlgFilename();
+            bool saved = (option == 6) ? saveHopMatrix(P->hops, name)
+                                       : saveDistMatrix(P->distances, name);
+            if (saved)
+                 cout << "\nZapisano macierz w pliku " << name << "\n\n";
+            else cout << "\nNie udalo sie zapisac macierzy w pliku " << name << "\n\n";
+            break;
+        }
+    }
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+#undef MAX_COLUMNS
+
+
+
+
+int cmdWeightUpdates(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie informacji o pliku zmian wag krawedzi
+    msgUpdateInfo();
+
+    // Interakcja: wczytanie nazwy pliku zmian ...
+    string name = dlgFilename();
+
+    // ... i proba jego otwarcia ...
+    ifstream fsInput(name.c_str());
+    if (! fsInput.is_open()) {
+        // ... i ewentualne zakonczenie, gdy sie nie powiodla
+        msgFileNotFound();
+        return CMD_CANCEL;
+    }
+
+    // Tablica zmian wag (powiekszana w miare potrzeby)
+    int capacity = 64;
+    TWeightUpdate *U = new TWeightUpdate[capacity];
+    int count = 0;
+    int rejected = 0;
+
+    int startId, stopId, weight;
+    // Dla kazdej trojki liczb z pliku zmian, ...
+    while (fsInput >> startId >> stopId >> weight) {
+        // ... (z pominieciem zmian spoza zakresu Id wezlow, petli i wag
+        // ujemnych) ...
+        if (startId < 0 || startId >= n || stopId < 0 || stopId >= n
+                        || startId == stopId || weight < 0) {
+            rejected++;
+            continue;
+        }
+        // ... z ewentualnym powiekszeniem tablicy ...
+        if (count == capacity) {
+            TWeightUpdate *larger = new TWeightUpdate[2 * capacity];
+            for (int i = 0; i < count; i++)
+                larger[i] = U[i];
+            delete[] U;
+            U = larger;
+            capacity *= 2;
+        }
+        // ... dopisanie zmiany do tablicy
+        U[count].startId = startId;
+        U[count].stopId = stopId;
+        U[count].weight = weight;
+        count++;
+    }
+    fsInput.close();
+
+    // Wprowadzenie zmian do grafu, z przyrostowa naprawa drzewa najkrotszych
+    // sciezek w dzienniku (o ile je zawiera), z pomiarem czasu obliczen
+    bool repair = (P->source >= 0);
+    auto tStart = chrono::steady_clock::now();
+    int affected = updateWeights(P, count, U);
+    auto tStop = chrono::steady_clock::now();
+    INT64 time = chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+
+    // Skasowanie tablicy zmian
+    delete[] U;
+    U = NULL;
+
+    // Sprawdzenie naprawionego drzewa: pelna eksploracja grafu po zmianach
+    // (w pomocniczym dzienniku, z ta sama kolejka priorytetowa) i porownanie
+    // wszystkich wpisow z dziennikiem naprawionym przyrostowo
+    INT64 tFull = 0;
+    bool same = true;
+    if (repair) {
+        TJournal *J = initJournal(n);
+        J->queue = P->journal->queue;
+        tStart = chrono::steady_clock::now();
+        exploreGraph(J, P->graph, P->source);
+        tStop = chrono::steady_clock::now();
+        tFull = chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+        for (int v = 0; v < n; v++) {
+            TEntry a = entry(J, v);
+            TEntry b = entry(P->journal, v);
+            if (a.distance != b.distance || a.prevId != b.prevId || a.visited != b.visited)
+                same = false;
+        }
+        killJournal(J);
+    }
+
+    // Wydruk statystyki obliczen
+    msgWeightUpdates(count, rejected, repair ? affected : -1,
+                     repair ? P->journal->settled : 0, time,
+                     tFull, same ? "TAK" : "NIE");
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+
+
+int cmdDetour(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie informacji o pliku scenariusza zmian grafu
+    msgOverlayInfo();
+
+    // Interakcja: wczytanie nazwy pliku scenariusza ...
+    string name = dlgFilename();
+
+    // ... i proba jego otwarcia ...
+    ifstream fsInput(name.c_str());
+    if (! fsInput.is_open()) {
+        // ... i ewentualne zakonczenie, gdy sie nie powiodla
+        msgFileNotFound();
+        return CMD_CANCEL;
+    }
+
+    // Nakladka zmian grafu ...
+    TOverlay *O = initOverlay(P->graph);
+    int changes = 0;
+    int rejected = 0;
+    // ... wypelniana zmianami z pliku scenariusza (z pominieciem zmian
+    // blednych, tj. spoza zakresu Id wezlow lub krawedzi nieistniejacych)
+    string tag;
+    while (fsInput >> tag) {
+        int startId = -1, stopId = -1, weight = 0;
+        bool ok = false;
+        if (tag == "n" && fsInput >> startId)
+            ok = blockNode(O, startId);
+        else if (tag == "e" && fsInput >> startId >> stopId)
+            ok = blockEdge(O, P->graph, startId, stopId);
+        else if (tag == "w" && fsInput >> startId >> stopId >> weight)
+            ok = (weight > 0) && reweightEdge(O, P->graph, startId, stopId, weight);
+        if (ok)
+             changes++;
+        else rejected++;
+        // (przerwanie odczytu, gdy linia jest nieczytelna)
+        if (fsInput.fail())
+            break;
+    }
+    fsInput.close();
+
+    cout << "\nIlosc zmian w scenariuszu: " << changes;
+    if (rejected > 0)
+        cout << " (pominieto bledne: " << rejected << ")";
+    cout << "\n";
+
+    int startId, stopId;
+    if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK
+     || dlgNodeId("\nPodaj wezel koncowy", 0, n -1, stopId) != DLG_OK) {
+        killOverlay(O);
+        return CMD_CANCEL;
+    }
+
+    // Dystans w grafie bez zmian (do porownania) ...
+    findPath(P, startId, stopId);
+    INT64 d0 = getDistance(P->journal, stopId);
+    // ... i wyszukanie objazdu w trybie wybranym w projekcie (z pomiarem
+    // czasu obliczen)
+    auto tStart = chrono::steady_clock::now();
+    findDetour(P, O, startId, stopId);
+    auto tStop = chrono::steady_clock::now();
+    INT64 d = getDistance(P->journal, stopId);
+
+    // Wydruk sekwencji wezlow po najkrotszej sciezce objazdu ...
+    cout << "\nObjazd z wezla " << startId << " do " << stopId << " to:  ";
+    if (d == 2147483647)
+        cout << "-";
+    else {
+        int *Ids = new int[n];
+        int c = shortestPath(P->journal, stopId, Ids);
+        for (int i = 0; i < c; i++)
+            cout << Ids[i] << ((i < c -1) ? "-" : "");
+        delete[] Ids;
+    }
+    // ... i jego dystansu, wraz z dystansem w grafie bez zmian
+    cout << "\nDystans objazdu: ";
+    if (d == 2147483647)
+         cout << "-";
+    else cout << d;
+    cout << "\nDystans w grafie bez zmian: ";
+    if (d0 == 2147483647)
+         cout << "-";
+    else cout << d0;
+    cout << "\n\n";
+
+    // Wydruk statystyki obliczen
+    cout << "Operacje porzadkowania kolejki priorytetowej: ";
+    cout << P->journal->sifts;
+    cout << "\nIlosc zwiedzonych wezlow: ";
+    cout << P->journal->settled;
+    cout << "\nCzas obliczen [us]: ";
+    cout << chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+    cout << "\n\n";
+
+    // Skasowanie nakladki zmian grafu
+    killOverlay(O);
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+
+
+#define MAX_PATHS  100
+
+
+int cmdAlternatives(TProject *P) {
+    const int n = P->graph->order;
+
+    int startId, stopId, k;
+    if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK)
+        return CMD_CANCEL;
+    if (dlgNodeId("\nPodaj wezel koncowy", 0, n -1, stopId) != DLG_OK)
+        return CMD_CANCEL;
+    if (dlgNumber("\nPodaj ilosc sciezek", 1, MAX_PATHS, k) != DLG_OK)
+        return CMD_CANCEL;
+
+    // Wyznaczenie sciezek alternatywnych
+    TPathSet *S = findAlternatives(P, startId, stopId, k);
+
+    // Wydruk sciezek (od najkrotszej) wraz z ich dystansami
+    if (S->count == 0)
+        cout << "\nWezel " << stopId << " jest nieosiagalny z wezla " << startId << "\n";
+    else
+        cout << "\nNajkrotsze sciezki proste z wezla " << startId << " do " << stopId << ":\n";
+    for (int p = 0; p < S->count; p++) {
+        cout << "\n" << p +1 << ". (dystans " << S->costs[p] << ")  ";
+        int *Ids = pathNodes(S, p);
+        for (int i = 0; i < pathLength(S, p); i++)
+            cout << Ids[i] << ((i < pathLength(S, p) -1) ? "-" : "");
+    }
+    if (S->count > 0 && S->count < k)
+        cout << "\n\nWiecej sciezek prostych brak";
+    cout << "\n";
+
+    // Wydruk statystyki obliczen i skasowanie zbioru sciezek
+    msgPathSet(S->searches, S->reused, S->settled, S->time);
+    killPathSet(S);
+
+    // Zwrocenie kodu zakonczenia polecenia
+    return CMD_OK;
+}
+
+
+#undef MAX_PATHS
+
+
+
+
+#define MAX_LINES  1000
+
+
+int cmdFacilities(TProject *P) {
+    const int n = P->graph->order;
+
+    // Wydrukowanie informacji o pliku wezlow obiektow uslugowych
+    msgFacilityInfo();
+
+    // Interakcja: wczytanie nazwy pliku ...
+    string name = dlgFilename();
+
+    // ... i proba jego otwarcia ...
+    ifstream fsInput(name.c_str());
+    if (! fsInput.is_open()) {
+        // ... i ewentualne zakonczenie, gdy sie nie powiodla
+        msgFileNotFound();
+        return CMD_CANCEL;
+    }
+
+    // Tablica Id wezlow obiektow, wypelniana Id z pliku (z pominieciem Id
+    // spoza zakresu i powtorzen)
+    int *sites = new int[n];
+    bool *listed = new bool[n];
+    for (int v = 0; v < n; v++)
+        listed[v] = false;
+    int count = 0;
+    int rejected = 0;
+    int Id;
+    while (fsInput >> Id) {
+        if (Id < 0 || Id >= n || listed[Id]) {
+            rejected++;
+            continue;
+        }
+        listed[Id] = true;
+        sites[count++] = Id;
+    }
+    fsInput.close();
+    delete[] listed;
+
+    cout << "\nIlosc obiektow w pliku: " << count;
+    if (rejected > 0)
+        cout << " (pominieto bledne: " << rejected << ")";
+    cout << "\n";
+    if (count == 0) {
+        delete[] sites;
+        return CMD_CANCEL;
+    }
+
+    // Wydrukowanie dostepnych opcji, ...
+    mnuOptionsFacilities(count);
+    // ... oraz dialog, w celu wyboru jednej z opcji
+    int option = dlgOptions(2);
+    if (option == DLG_CANCEL) {
+        delete[] sites;
+        return CMD_OK;
+    }
+
+    if (option == 1) {
+        int startId, k;
+        if (dlgNodeId("\nPodaj wezel zrodlowy", 0, n -1, startId) != DLG_OK
+         || dlgNumber("\nPodaj ilosc obiektow", 1, count, k) != DLG_OK) {
+            delete[] sites;
+            return CMD_CANCEL;
+        }
+
+        // Wyznaczenie k najblizszych obiektow (z pomiarem czasu obliczen)
+        int *Ids = new int[k];
+        auto tStart = chrono::steady_clock::now();
+        int found = findNearest(P, startId, count, sites, k, Ids);
+        auto tStop = chrono::steady_clock::now();
+
+        // Wydruk obiektow (od najblizszego) wraz z ich dystansami
+        if (found == 0)
+            cout << "\nZaden obiekt nie jest osiagalny z wezla " << startId << "\n";
+        else
+            cout << "\nNajblizsze obiekty wezla " << startId << ":\n";
+        for (int i = 0; i < found; i++)
+            cout << "\n" << i +1 << ". wezel " << Ids[i] << " (dystans " << getDistance(P->journal, Ids[i]) << ")";
+        if (found > 0 && found < k)
+            cout << "\n\nPozostale obiekty sa nieosiagalne";
+        cout << "\n\n";
+        delete[] Ids;
+
+        // Wydruk statystyki obliczen
+        cout << "Operacje porzadkowania kolejki priorytetowej: ";
+        cout << P->journal->sifts;
+        cout << "\nIlosc zwiedzonych wezlow: ";
+        cout << P->journal->settled;
+        cout << "\nCzas obliczen [us]: ";
+        cout << chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+        cout << "\n\n";
+    }
+
+    if (option == 2) {
+        // Przydzial wezlow do najblizszych obiektow (z pomiarem czasu obliczen)
+        int *owner = new int[n];
+        auto tStart = chrono::steady_clock::now();
+        int reached = findVoronoi(P, count, sites, owner);
+        auto tStop = chrono::steady_clock::now();
+
+        // Zestawienie obszarow obiektow, tj. ilosci przydzielonych wezlow
+        // i dystansu najdalszego z nich
+        int *sizes = new int[count];
+        INT64 *radius = new INT64[count];
+        for (int s = 0; s < count; s++) {
+            sizes[s] = 0;
+            radius[s] = 0;
+        }
+        for (int v = 0; v < n; v++)
+            if (owner[v] >= 0) {
+                sizes[owner[v]]++;
+                if (entryDistance(P->journal, v) > radius[owner[v]])
+                    radius[owner[v]] = entryDistance(P->journal, v);
+            }
+
+        // Wydruk obszarow obiektow (z ograniczeniem ilosci drukowanych linii)
+        int m = (count > MAX_LINES) ? MAX_LINES : count;
+        cout << "\nObszary obiektow (wezly najblizsze obiektowi):\n";
+        for (int s = 0; s < m; s++) {
+            cout << "\nobiekt " << sites[s] << ":  wezlow " << sizes[s];
+            cout << ", najdalszy dystans " << radius[s];
+        }
+        if (count > m)
+            cout << "\n(wydruk ograniczony do " << MAX_LINES << " obiektow)";
+        cout << "\n\nWezly przydzielone do obiektow: " << reached << " z " << n;
+        cout << "\n\n";
+        delete[] sizes;
+        delete[] radius;
+        delete[] owner;
+
+        // Wydruk statystyki obliczen
+        cout << "Ilosc zwiedzonych wezlow: ";
+        cout << P->journal->settled;
+        cout << "\nCzas obliczen [us]: ";
+        cout << chrono::duration_cast<chrono::microseconds>(tStop - tStart).count();
+        cout << "\n\n";
     }
 
+    // Skasowanie tablicy Id wezlow obiektow
+    delete[] sites;
+
     // Zwrocenie kodu zakonczenia polecenia
     return CMD_OK;
 }
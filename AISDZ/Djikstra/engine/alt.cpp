@@ -0,0 +1,333 @@
+/* ----------------------------------------------------------------------------
+
+  TLandmarks - punkty orientacyjne metody ALT (A*, Landmarks, Triangle
+  inequality)
+
+  UWAGI:
+  - obliczenia wstepne (po zbudowaniu modelu grafu) wybieraja k wezlow na
+    punkty orientacyjne i zapamietuja dystanse od kazdego z nich do wszystkich
+    wezlow grafu oraz (w grafie skierowanym) od wszystkich wezlow do niego;
+  - punkty orientacyjne wybierane sa metoda "najdalszego punktu" (ang.
+    farthest-first): kolejnym punktem zostaje wezel najbardziej oddalony od
+    punktow juz wybranych (wezly nieosiagalne traktowane sa jako najdalsze,
+    dzieki czemu punkty trafiaja takze do innych skladowych grafu), a pierwszym
+    - wezel najbardziej oddalony od wezla 0;
+  - wybor punktow jest z natury sekwencyjny (kazdy kolejny zalezy od dystansow
+    od poprzednich), a wektory dystansow "w przod" sa jego produktem ubocznym;
+    wektory dystansow "wstecz" wyznaczane sa juz rownolegle - kazdy punkt
+    orientacyjny to osobne zadanie, a kazdy watek ma wlasny dziennik obliczen;
+  - z nierownosci trojkata wynika dolne ograniczenie dystansu dzielacego
+    dowolny wezel v od wezla koncowego t (potencjal wezla):
+      d(v,t) >= d(L,t) - d(L,v)   oraz   d(v,t) >= d(v,L) - d(t,L),
+    a potencjal to najwieksze z tych ograniczen po wszystkich punktach L;
+  - wyszukiwanie najkrotszej sciezki to algorytm A*, tj. algorytm Dijkstry
+    z kluczem kolejki rownym dystansowi od wezla startowego powiekszonemu
+    o potencjal wezla; potencjal jest spojny (nie zawyza wag krawedzi), wiec
+    klucze zdejmowane z kolejki nie maleja, a wezel koncowy jest gotowy
+    z chwila jego zwiedzenia;
+  - wezly, z ktorych na podstawie punktow orientacyjnych nie da sie dotrzec
+    do wezla koncowego, nie trafiaja do kolejki priorytetowej;
+  - potencjal wyliczany jest jednokrotnie, przy odkryciu wezla;
+  - z nakladka zmian grafu, ktora jedynie zamyka krawedzie, blokuje wezly
+    lub podwyzsza wagi, potencjaly nadal nie zawyzaja dystansow (dystanse
+    moga tylko wzrosnac), a gdy nakladka obniza wagi - sciezke wyszukuje
+    algorytm Dijkstry;
+  - zredukowane wagi krawedzi moga przekraczac najwieksza wage krawedzi
+    w grafie, dlatego zamiast kolejki kubelkowej Diala uzywany jest kopiec
+    pozycyjny (wymagajacy jedynie niemalejacych kluczy).
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include "common.h"
+#include "alt.h"
+#include "parallel.h"
+
+using namespace std::chrono;
+
+
+#define INF  2147483647
+
+
+/*
+  Struktura kontekstu zadan rownoleglych obliczen wektorow dystansow wstecz
+  G         - graf
+  L         - zbior punktow orientacyjnych (wektory wynikowe)
+  journals  - dzienniki obliczen przydzielone poszczegolnym watkom
+*/
+struct TLandmarksTask {
+    TGraph *G;
+    TLandmarks *L;
+    TJournal **journals;
+};
+
+
+void _backTask(void *context, int index, int worker) {
+    TLandmarksTask *T = (TLandmarksTask *)context;
+    TJournal *J = T->journals[worker];
+
+    // Eksploracja grafu wstecz od punktu orientacyjnego o podanym numerze ...
+    exploreReverse(J, T->G, T->L->Ids[index]);
+    // ... i przepisanie dystansow z dziennika obliczen do wektora
+    for (int i = 0; i < J->length; i++)
+        T->L->back[index][i] = entryDistance(J, i);
+}
+
+
+TLandmarks* initLandmarks(TGraph *G, int count, int threads) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen wstepnych
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+    // Ilosc punktow orientacyjnych nie moze przekraczac ilosci wezlow
+    if (count > n)
+        count = n;
+
+    // Alokacja nowego zbioru punktow orientacyjnych, ...
+    TLandmarks *L = new TLandmarks;
+    L->count = 0;
+    L->length = n;
+    // ... tablicy Id punktow i tablicy wektorow dystansow w przod
+    L->Ids = new int[count];
+    L->forth = new INT64*[count];
+
+    // Zainicjowanie dziennika obliczen z kolejka dopasowana do wag krawedzi
+    TJournal *J = initJournal(n);
+    J->queue = chooseQueue(G);
+
+// *** Wybor punktow orientacyjnych metoda "najdalszego punktu" ***
+
+    // Dystanse wezlow od najblizszego wybranego punktu orientacyjnego
+    // (poczatkowo - od wezla 0)
+    INT64 *nearest = new INT64[n];
+    exploreGraph(J, G, 0);
+    for (int i = 0; i < n; i++)
+        nearest[i] = entryDistance(J, i);
+
+    while (L->count < count) {
+        // Wybor wezla najbardziej oddalonego od wybranych punktow, ...
+        int Id = 0;
+        for (int i = 1; i < n; i++)
+            if (nearest[i] > nearest[Id])
+                Id = i;
+        // ... (o ile nie jest on juz punktem orientacyjnym) ...
+        if (L->count > 0 && nearest[Id] == 0)
+            break;
+        // ... eksploracja grafu od niego ...
+        exploreGraph(J, G, Id);
+        // ... i zapamietanie go wraz z wektorem dystansow w przod ...
+        L->Ids[L->count] = Id;
+        L->forth[L->count] = new INT64[n];
+        for (int i = 0; i < n; i++) {
+            L->forth[L->count][i] = entryDistance(J, i);
+            // ... z uaktualnieniem dystansow od najblizszego punktu
+            if (nearest[i] > entryDistance(J, i) || L->count == 0)
+                nearest[i] = entryDistance(J, i);
+        }
+        L->count++;
+    }
+    delete[] nearest;
+    killJournal(J);
+
+// *** Rownolegle wyznaczenie wektorow dystansow wstecz ***
+
+    if (G->profile[gpDirected] > 0) {
+        // Alokacja tablicy wektorow dystansow wstecz, ...
+        L->back = new INT64*[L->count];
+        for (int l = 0; l < L->count; l++)
+            L->back[l] = new INT64[n];
+
+        // ... dziennikow obliczen dla kazdego z watkow ...
+        int t = workerCount(threads, L->count);
+        TJournal **journals = new TJournal*[t];
+        for (int w = 0; w < t; w++) {
+            journals[w] = initJournal(n);
+            journals[w]->queue = chooseQueue(G);
+        }
+        // ... i uruchomienie obliczen (po jednym zadaniu na punkt orientacyjny)
+        TLandmarksTask T = { G, L, journals };
+        runParallel(L->count, t, _backTask, &T);
+
+        // Skasowanie dziennikow obliczen watkow
+        for (int w = 0; w < t; w++)
+            killJournal(journals[w]);
+        delete[] journals;
+    }
+    else
+        // W grafie nieskierowanym dystanse wstecz sa rowne dystansom w przod
+        L->back = L->forth;
+
+    // Zapamietanie statystyki obliczen wstepnych
+    L->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+    L->memory = (INT64)L->count * n * sizeof(INT64) * ((L->back != L->forth) ? 2 : 1)
+              + (INT64)L->count * (sizeof(int) + 2 * sizeof(INT64 *));
+
+    // Zwrocenie wskaznika na zainicjowany zbior punktow orientacyjnych
+    return L;
+}
+
+
+void killLandmarks(TLandmarks* &L) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (L == NULL)
+        return;
+
+    // Skasowanie wektorow dystansow wstecz (o ile nie sa tozsame z wektorami
+    // dystansow w przod), ...
+    if (L->back != L->forth) {
+        for (int l = 0; l < L->count; l++)
+            delete[] L->back[l];
+        delete[] L->back;
+    }
+    // ... wektorow dystansow w przod ...
+    for (int l = 0; l < L->count; l++)
+        delete[] L->forth[l];
+    delete[] L->forth;
+    // ... i tablicy Id punktow orientacyjnych
+    delete[] L->Ids;
+
+    // Skasowanie zbioru i zwrocenie przez parametr wyzerowanego wskaznika
+    delete L;
+    L = NULL;
+}
+
+
+INT64 _potential(TLandmarks *L, int Id, int stopId) {
+    INT64 h = 0;
+    // Dla kazdego punktu orientacyjnego ...
+    for (int l = 0; l < L->count; l++) {
+        // ... ograniczenie z dystansow w przod: d(v,t) >= d(L,t) - d(L,v)
+        // (gdy L osiaga v, ale nie osiaga t, to z v nie da sie dotrzec do t) ...
+        INT64 a = L->forth[l][stopId];
+        INT64 b = L->forth[l][Id];
+        if (b != INF) {
+            if (a == INF)
+                return INF;
+            if (a - b > h)
+                h = a - b;
+        }
+        // ... i z dystansow wstecz: d(v,t) >= d(v,L) - d(t,L)
+        // (gdy t osiaga L, ale v nie osiaga L, to z v nie da sie dotrzec do t)
+        a = L->back[l][Id];
+        b = L->back[l][stopId];
+        if (b != INF) {
+            if (a == INF)
+                return INF;
+            if (a - b > h)
+                h = a - b;
+        }
+    }
+    // Zwrocenie najwiekszego z ograniczen (INF - wezel koncowy nieosiagalny)
+    return h;
+}
+
+
+template <typename TQueue>
+void _exploreLandmarks(TJournal *J, TGraph *G, TLandmarks *L, int startId, int stopId) {
+    // Alias na wielkosc dziennika
+    const int &n = J->length;
+
+// *** Umieszczenie wpisu startowego w kolejce priorytetowej ***
+
+    // Ustawienie wartosci poczatkowych we wszystkich wpisach ...
+    clearJournal(J);
+    // ... i wyzerowanie dystansu we wpisie zwiazanym w wezlem startowym
+    setDistance(J, startId, 0);
+
+    // Potencjaly wezlow (wyliczane przy ich odkryciu)
+    INT64 *h = new INT64[n];
+    h[startId] = _potential(L, startId, stopId);
+
+    // Przydzial kolejki wybranego rodzaju ...
+    TQueue *Q;
+    journalQueue(J, Q, maxArcWeight(J->overlay, G));
+    // ... i wprowadzenie do niej wpisu startowego (o ile wezel koncowy
+    // jest w ogole osiagalny)
+    if (h[startId] != INF)
+        enqueue(Q, startId, h[startId]);
+
+// *** Analiza grafu ukierunkowana na wezel koncowy ***
+
+    J->settled = 0;
+    // Tak dlugo jak w kolejce czekaja niegotowe wpisy, ...
+    while (queueSize(Q) > 0) {
+        // ... zdjecie z czola kolejki wpisu o najmniejszym kluczu, ...
+        int currId = dequeue(Q);
+        setVisited(J, currId, true);
+        J->settled++;
+        // ... (zwiedzenie wezla koncowego konczy obliczenia) ...
+        if (currId == stopId)
+            break;
+        // ... i dla kazdego wezla sasiadujacego z nim ...
+        for (int i = 0; i < nodeDegree(G, currId); i++) {
+            int nextId = nodeNeighbour(G, currId, i)->Id;
+            if (isVisited(J, nextId))
+                continue;
+            // ... wyliczenie potencjalu wezla, gdy dopiero go odkryto ...
+            if (entryDistance(J, nextId) == INF)
+                h[nextId] = _potential(L, nextId, stopId);
+            // ... (z pominieciem wezlow, z ktorych nie da sie dotrzec
+            // do wezla koncowego) ...
+            if (h[nextId] == INF)
+                continue;
+            // ... i gdy droga krotsza -- ZAPIS, z kluczem kolejki
+            // powiekszonym o potencjal wezla (z pominieciem krawedzi
+            // zamknietych w nakladce zmian grafu)
+            int w = arcWeight(J->overlay, G, currId, nextId);
+            if (w == 0)
+                continue;
+            INT64 d = entryDistance(J, currId) + w;
+            if (entryDistance(J, nextId) > d) {
+                setDistance(J, nextId, d);
+                setPrev(J, nextId, currId);
+                requeue(Q, nextId, d + h[nextId]);
+            }
+        }
+    }
+
+    // Zapamietanie statystyki obliczen ...
+    J->sifts = queueSifts(Q);
+    // ... oproznienie kolejki priorytetowej i skasowanie potencjalow
+    clearQueue(Q);
+    delete[] h;
+}
+
+
+void exploreLandmarks(TJournal *J, TGraph *G, TLandmarks *L, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL)
+        return;
+
+    // Bez punktow orientacyjnych (lub wezla koncowego) albo z nakladka
+    // zmian grafu obnizajaca wagi (potencjaly przestaja ograniczac dystanse
+    // od dolu) - algorytm Dijkstry
+    if (L == NULL || L->count == 0 || stopId < 0
+                  || (J->overlay != NULL && J->overlay->lowered)) {
+        exploreGraph(J, G, startId, stopId);
+        return;
+    }
+
+    // Uruchomienie silnika obliczeniowego A* z kolejka priorytetowa rodzaju
+    // wybranego w dzienniku obliczen (kolejke kubelkowa zastepuje kopiec
+    // pozycyjny)
+    switch (J->queue) {
+        case qkQuadHeap    : _exploreLandmarks<TQuadHeap>(J, G, L, startId, stopId);
+                             break;
+        case qkPairingHeap : _exploreLandmarks<TPairingHeap>(J, G, L, startId, stopId);
+                             break;
+        case qkBuckets     :
+        case qkRadix       : _exploreLandmarks<TRadixHeap>(J, G, L, startId, stopId);
+                             break;
+        default            : _exploreLandmarks<TIndexHeap>(J, G, L, startId, stopId);
+    }
+}
+
+
+#undef INF
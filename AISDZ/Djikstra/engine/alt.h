@@ -0,0 +1,40 @@
+#ifndef AC_ENGINE_ALT_H
+#define AC_ENGINE_ALT_H
+
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+
+
+/*
+  Struktura definiujaca zbior punktow orientacyjnych (ang. landmarks) metody
+  ALT (A*, Landmarks, Triangle inequality)
+  count     - ilosc punktow orientacyjnych
+  length    - ilosc wezlow grafu (dlugosc wektorow dystansow)
+  Ids       - count-elementowa tablica Id wezlow wybranych na punkty orientacyjne
+  forth     - count-wierszowa tablica wektorow dystansow od punktow
+              orientacyjnych do wszystkich wezlow grafu
+  back      - count-wierszowa tablica wektorow dystansow od wszystkich wezlow
+              grafu do punktow orientacyjnych (w grafie nieskierowanym jest
+              tozsama z tablica forth)
+  time      - statystyka: czas obliczen wstepnych [us]
+  memory    - statystyka: pamiec zajmowana przez wektory dystansow [B]
+*/
+struct TLandmarks {
+    int count;
+    int length;
+    int *Ids;
+    INT64 **forth;
+    INT64 **back;
+    INT64 time;
+    INT64 memory;
+};
+
+
+TLandmarks* initLandmarks(TGraph *G, int count, int threads);
+void killLandmarks(TLandmarks* &L);
+
+void exploreLandmarks(TJournal *J, TGraph *G, TLandmarks *L, int startId, int stopId);
+
+
+#endif // AC_ENGINE_ALT_H
@@ -0,0 +1,377 @@
+/* ----------------------------------------------------------------------------
+
+  Przeszukiwanie wszerz (BFS) grafow niewazonych z optymalizacja kierunku
+
+  UWAGI:
+  - w grafie niewazonym (wszystkie krawedzie maja wage 1) dystans wezla to
+    numer poziomu przeszukiwania wszerz, na ktorym wezel odkryto, wiec
+    kolejka priorytetowa jest zbedna;
+  - zbiory wezlow odwiedzonych, biezacego poziomu (frontu) i nastepnego
+    poziomu to mapy bitowe (po bicie na wezel w slowach 64-bitowych);
+  - kolejny poziom wyznaczany jest "z gory" (top-down: od wezlow frontu po
+    ich krawedziach wychodzacych) albo "z dolu" (bottom-up: kazdy
+    nieodwiedzony wezel szuka we froncie ktoregokolwiek poprzednika, po
+    odwroconej liscie sasiedztwa, i konczy szukanie z chwila znalezienia);
+    przejscie "z dolu" oplaca sie, gdy front jest duzy - kierunek wybierany
+    jest wg heurystyki S.Beamera (ilosc krawedzi frontu wobec ilosci krawedzi
+    wezlow nieodwiedzonych, a przy powrocie - wielkosc frontu wobec n);
+  - front przegladany jest rosnaco wg Id, a listy sasiedztwa sa uporzadkowane
+    rosnaco, wiec wezlem poprzedzajacym zostaje zawsze poprzednik z poprzedniego
+    poziomu o najmniejszym Id - tak samo jak w silniku z kolejka priorytetowa;
+  - wyniki zapisywane sa w dzienniku obliczen DSP (dystans, wezel
+    poprzedzajacy, status zwiedzenia), a przy podanym wezle koncowym
+    przeszukiwanie konczy sie wraz z poziomem, na ktorym go odkryto;
+  - odleglosci (w krawedziach, bez wzgledu na wagi) pomiedzy wszystkimi
+    parami wezlow wyznacza wielozrodlowe przeszukiwanie wszerz: kazdy wezel
+    ma maske bitowa zrodel, ktore do niego dotarly (HOP_WORDS slow, tj. 256
+    zrodel naraz), a jeden przebieg po liscie sasiedztwa przesuwa fronty
+    wszystkich zrodel o poziom (suma bitowa masek frontu poprzednikow);
+  - kolejne grupy zrodel przetwarzane sa rownolegle (kazdy watek ma wlasne
+    maski), a wynik to zwarta macierz odleglosci 16-bitowych.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <fstream>
+#include "common.h"
+#include "bfs.h"
+#include "parallel.h"
+
+using namespace std::chrono;
+
+
+#define ALPHA      14
+#define BETA       24
+#define HOP_WORDS  4
+#define HOP_BATCH  (64 * HOP_WORDS)
+
+
+/*
+  Struktura kontekstu zadan rownoleglych wielozrodlowego przeszukiwania
+  wszerz (jedno zadanie - grupa HOP_BATCH zrodel)
+  G         - graf
+  H         - macierz odleglosci (wynik)
+  seen      - maski zrodel, ktore dotarly do wezlow (n*HOP_WORDS slow na watek)
+  front     - maski zrodel, ktorych front zawiera wezel
+  next      - maski zrodel nastepnego poziomu
+*/
+struct THopTask {
+    TGraph *G;
+    THopMatrix *H;
+    UINT64 **seen;
+    UINT64 **front;
+    UINT64 **next;
+};
+
+
+inline bool _testBit(UINT64 *map, int Id) {
+    return (map[Id >> 6] >> (Id & 63)) & 1;
+}
+
+inline void _setBit(UINT64 *map, int Id) {
+    map[Id >> 6] |= (UINT64)1 << (Id & 63);
+}
+
+inline int _lowBit(UINT64 word) {
+    // Zwrocenie numeru najmlodszego ustawionego bitu niepustego slowa
+#if defined(__GNUC__)
+    return __builtin_ctzll(word);
+#else
+    int i = 0;
+    while (! ((word >> i) & 1))
+        i++;
+    return i;
+#endif
+}
+
+
+void exploreBFS(TJournal *J, TGraph *G, int startId, int stopId, bool backward) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL)
+        return;
+
+    // Aliasy na rzad grafu i ilosc slow map bitowych
+    const int &n = G->order;
+    const int words = (n + 63) / 64;
+
+    // Listy sasiedztwa przejscia "z gory" (w kierunku przeszukiwania)
+    // i "z dolu" (pod prad kierunku przeszukiwania)
+    int **down = backward ? G->revList : G->adjList;
+    int **up = backward ? G->adjList : G->revList;
+
+    // Alokacja map bitowych (wezly odwiedzone, front, nastepny poziom)
+    UINT64 *visited = new UINT64[words];
+    UINT64 *front = new UINT64[words];
+    UINT64 *next = new UINT64[words];
+    for (int w = 0; w < words; w++)
+        visited[w] = front[w] = 0;
+
+    // Ustawienie wartosci poczatkowych we wszystkich wpisach dziennika ...
+    clearJournal(J);
+    // ... i umieszczenie wezla startowego we froncie
+    setDistance(J, startId, 0);
+    setVisited(J, startId, true);
+    _setBit(visited, startId);
+    _setBit(front, startId);
+
+    // Statystyka frontu (ilosc wezlow i ich krawedzi) oraz ilosc krawedzi
+    // wezlow nieodwiedzonych - do wyboru kierunku przejscia
+    INT64 mu = 0;
+    for (int v = 0; v < n; v++)
+        mu += backward ? nodeInDegree(G, v) : nodeDegree(G, v);
+    int nf = 1;
+    INT64 mf = backward ? nodeInDegree(G, startId) : nodeDegree(G, startId);
+    mu -= mf;
+    bool bottomUp = false;
+
+    int level = 0;
+    J->settled = 1;
+    // Tak dlugo jak front nie jest pusty (i nie odkryto wezla koncowego), ...
+    while (nf > 0 && ! (stopId >= 0 && _testBit(visited, stopId))) {
+        // ... wybor kierunku przejscia, ...
+        if (! bottomUp && mf > mu / ALPHA)
+            bottomUp = true;
+        else if (bottomUp && nf < n / BETA)
+            bottomUp = false;
+
+        // ... i wyznaczenie nastepnego poziomu
+        level++;
+        for (int w = 0; w < words; w++)
+            next[w] = 0;
+        nf = 0;
+        mf = 0;
+        if (! bottomUp) {
+            // Przejscie "z gory": dla kazdego wezla frontu (rosnaco wg Id) ...
+            for (int w = 0; w < words; w++)
+                for (UINT64 bits = front[w]; bits != 0; bits &= bits -1) {
+                    int currId = 64 * w + _lowBit(bits);
+                    int degree = backward ? nodeInDegree(G, currId) : nodeDegree(G, currId);
+                    // ... odkrycie nieodwiedzonych wezlow sasiednich
+                    for (int i = 0; i < degree; i++) {
+                        int nextId = down[currId][i];
+                        if (_testBit(visited, nextId))
+                            continue;
+                        _setBit(visited, nextId);
+                        _setBit(next, nextId);
+                        setDistance(J, nextId, level);
+                        setPrev(J, nextId, currId);
+                        setVisited(J, nextId, true);
+                        nf++;
+                        mf += backward ? nodeInDegree(G, nextId) : nodeDegree(G, nextId);
+                    }
+                }
+        }
+        else {
+            // Przejscie "z dolu": dla kazdego nieodwiedzonego wezla ...
+            for (int w = 0; w < words; w++) {
+                UINT64 bits = ~visited[w];
+                if (w == words -1 && (n & 63) != 0)
+                    bits &= ((UINT64)1 << (n & 63)) -1;
+                for (; bits != 0; bits &= bits -1) {
+                    int currId = 64 * w + _lowBit(bits);
+                    int degree = backward ? nodeDegree(G, currId) : nodeInDegree(G, currId);
+                    // ... wyszukanie pierwszego (o najmniejszym Id) poprzednika
+                    // we froncie
+                    for (int i = 0; i < degree; i++) {
+                        int prevId = up[currId][i];
+                        if (! _testBit(front, prevId))
+                            continue;
+                        _setBit(next, currId);
+                        setDistance(J, currId, level);
+                        setPrev(J, currId, prevId);
+                        setVisited(J, currId, true);
+                        nf++;
+                        mf += backward ? nodeInDegree(G, currId) : nodeDegree(G, currId);
+                        break;
+                    }
+                }
+            }
+            // Dolaczenie nastepnego poziomu do wezlow odwiedzonych
+            for (int w = 0; w < words; w++)
+                visited[w] |= next[w];
+        }
+
+        // Nastepny poziom staje sie frontem
+        UINT64 *X = front;
+        front = next;
+        next = X;
+        mu -= mf;
+        J->settled += nf;
+    }
+
+    // Zapamietanie statystyki obliczen (ilosc poziomow przeszukiwania)
+    J->sifts = level;
+
+    // Skasowanie map bitowych
+    delete[] visited;
+    delete[] front;
+    delete[] next;
+}
+
+
+void _hopTask(void *context, int index, int worker) {
+    THopTask *T = (THopTask *)context;
+    // Aliasy na rzad grafu i macierz wynikowa
+    const int &n = T->G->order;
+    unsigned short *hops = T->H->hops;
+
+    // Maski robocze watku
+    UINT64 *seen = T->seen[worker];
+    UINT64 *front = T->front[worker];
+    UINT64 *next = T->next[worker];
+    for (int i = 0; i < n * HOP_WORDS; i++)
+        seen[i] = front[i] = 0;
+
+    // Grupa zrodel zadania (bit b maski - zrodlo base + b)
+    int base = index * HOP_BATCH;
+    int count = (n - base < HOP_BATCH) ? n - base : HOP_BATCH;
+    for (int b = 0; b < count; b++) {
+        int Id = base + b;
+        seen[Id * HOP_WORDS + b / 64] |= (UINT64)1 << (b % 64);
+        front[Id * HOP_WORDS + b / 64] |= (UINT64)1 << (b % 64);
+        hops[(INT64)Id * n + Id] = 0;
+    }
+
+    // Przesuwanie frontow wszystkich zrodel grupy o kolejne poziomy, ...
+    for (int level = 1; ; level++) {
+        for (int i = 0; i < n * HOP_WORDS; i++)
+            next[i] = 0;
+        // ... tj. przejscie po liscie sasiedztwa z przeniesieniem masek
+        // frontu do wezlow sasiednich ...
+        for (int u = 0; u < n; u++) {
+            UINT64 *f = front + u * HOP_WORDS;
+            UINT64 any = 0;
+            for (int k = 0; k < HOP_WORDS; k++)
+                any |= f[k];
+            if (any == 0)
+                continue;
+            for (int i = 0; i < nodeDegree(T->G, u); i++) {
+                UINT64 *x = next + T->G->adjList[u][i] * HOP_WORDS;
+                for (int k = 0; k < HOP_WORDS; k++)
+                    x[k] |= f[k];
+            }
+        }
+        // ... z pozostawieniem tylko zrodel, ktore dotarly do wezla po raz
+        // pierwszy (i zapisem odleglosci w macierzy)
+        bool active = false;
+        for (int v = 0; v < n; v++)
+            for (int k = 0; k < HOP_WORDS; k++) {
+                UINT64 bits = next[v * HOP_WORDS + k] & ~seen[v * HOP_WORDS + k];
+                next[v * HOP_WORDS + k] = bits;
+                seen[v * HOP_WORDS + k] |= bits;
+                active = active || (bits != 0);
+                for (; bits != 0; bits &= bits -1)
+                    hops[(INT64)(base + 64 * k + _lowBit(bits)) * n + v] = level;
+            }
+        // Zakonczenie, gdy zaden front sie nie przesunal
+        if (! active)
+            break;
+        UINT64 *X = front;
+        front = next;
+        next = X;
+    }
+}
+
+
+THopMatrix* initHopMatrix(TGraph *G, int threads) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL || G->order == 0)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowej macierzy odleglosci (z wypelnieniem brakiem drogi)
+    THopMatrix *H = new THopMatrix;
+    H->length = n;
+    H->hops = new unsigned short[(INT64)n * n];
+    for (INT64 i = 0; i < (INT64)n * n; i++)
+        H->hops[i] = HOPS_NONE;
+
+    // Maski robocze dla kazdego z watkow ...
+    int batches = (n + HOP_BATCH -1) / HOP_BATCH;
+    int t = workerCount(threads, batches);
+    THopTask T = { G, H, new UINT64*[t], new UINT64*[t], new UINT64*[t] };
+    for (int w = 0; w < t; w++) {
+        T.seen[w] = new UINT64[n * HOP_WORDS];
+        T.front[w] = new UINT64[n * HOP_WORDS];
+        T.next[w] = new UINT64[n * HOP_WORDS];
+    }
+    // ... i uruchomienie obliczen (po jednym zadaniu na grupe zrodel)
+    runParallel(batches, t, _hopTask, &T);
+    for (int w = 0; w < t; w++) {
+        delete[] T.seen[w];
+        delete[] T.front[w];
+        delete[] T.next[w];
+    }
+    delete[] T.seen;
+    delete[] T.front;
+    delete[] T.next;
+
+    // Zapamietanie statystyki obliczen (srednica, pary bez drogi, czas
+    // obliczen i pamiec macierzy)
+    H->diameter = 0;
+    H->unreachable = 0;
+    for (INT64 i = 0; i < (INT64)n * n; i++)
+        if (H->hops[i] == HOPS_NONE)
+            H->unreachable++;
+        else if (H->hops[i] > H->diameter)
+            H->diameter = H->hops[i];
+    H->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+    H->memory = (INT64)n * n * sizeof(unsigned short);
+
+    // Zwrocenie wskaznika na wyznaczona macierz odleglosci
+    return H;
+}
+
+
+void killHopMatrix(THopMatrix* &H) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return;
+
+    // Skasowanie macierzy odleglosci i zwrocenie przez parametr
+    // wyzerowanego wskaznika
+    delete[] H->hops;
+    delete H;
+    H = NULL;
+}
+
+
+bool saveHopMatrix(THopMatrix *H, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return false;
+
+    // Otwarcie pliku do zapisu (binarnie, by zachowac konce linii jak
+    // w danych zrodlowych)
+    ofstream fs(filename.c_str(), ios::out | ios::binary);
+    if (! fs.is_open())
+        return false;
+
+    // Zapis macierzy w postaci tekstowej, jak dane zrodlowe grafu (wiersze
+    // wezlow zrodlowych, wartosci rozdzielone tabulacja; "-" - brak drogi)
+    for (int i = 0; i < H->length; i++) {
+        for (int j = 0; j < H->length; j++) {
+            int h = hopCount(H, i, j);
+            if (j > 0)
+                fs << "\t";
+            if (h == HOPS_NONE)
+                 fs << "-";
+            else fs << h;
+        }
+        fs << "\r\n";
+    }
+    return fs.good();
+}
+
+
+#undef ALPHA
+#undef BETA
+#undef HOP_WORDS
+#undef HOP_BATCH
@@ -0,0 +1,49 @@
+#ifndef AC_ENGINE_BFS_H
+#define AC_ENGINE_BFS_H
+
+#include <string>
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+
+using namespace std;
+
+
+#define HOPS_NONE  65535
+
+
+/*
+  Struktura definiujaca macierz odleglosci mierzonych iloscia krawedzi (hops)
+  pomiedzy wszystkimi parami wezlow
+  length      - ilosc wezlow grafu
+  hops        - (n*n)-elementowa tablica odleglosci (wierszami - od kolejnych
+                wezlow zrodlowych), HOPS_NONE - brak drogi
+  diameter    - statystyka: srednica grafu (najwieksza skonczona odleglosc)
+  unreachable - statystyka: ilosc par wezlow bez drogi
+  time        - statystyka: czas obliczen [us]
+  memory      - statystyka: pamiec zajmowana przez macierz [B]
+*/
+struct THopMatrix {
+    int length;
+    unsigned short *hops;
+    int diameter;
+    INT64 unreachable;
+    INT64 time;
+    INT64 memory;
+};
+
+
+inline int hopCount(THopMatrix *H, int startId, int stopId) {
+    // Zwrocenie odleglosci (w krawedziach) od wezla startowego do koncowego
+    return H->hops[(INT64)startId * H->length + stopId];
+}
+
+
+void exploreBFS(TJournal *J, TGraph *G, int startId, int stopId, bool backward);
+
+THopMatrix* initHopMatrix(TGraph *G, int threads);
+void killHopMatrix(THopMatrix* &H);
+bool saveHopMatrix(THopMatrix *H, string filename);
+
+
+#endif // AC_ENGINE_BFS_H
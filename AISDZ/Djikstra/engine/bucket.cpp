@@ -0,0 +1,310 @@
+/* ----------------------------------------------------------------------------
+
+  Kolejki monotoniczne o kluczach calkowitych
+
+  UWAGI:
+  - kolejki przechowuja identyfikatory (Id) elementow z zakresu od 0 do n-1
+    wraz z ich kluczami - nieujemnymi liczbami calkowitymi;
+  - kolejki sa monotoniczne, tzn. zaklada sie, ze klucz wprowadzanego (lub
+    zmniejszanego) elementu nie jest mniejszy niz klucz elementu ostatnio
+    zdjetego z kolejki - taka wlasnosc ma kolejka w algorytmie Dijkstry
+    przy nieujemnych wagach krawedzi;
+  - elementy w kubelkach tworza listy dwukierunkowe, dzieki czemu zarowno
+    wprowadzenie, jak i zmniejszenie klucza elementu odbywa sie w czasie
+    stalym;
+  - kolejka kubelkowa (Diala) ma tyle kubelkow, ile wynosi najwieksza waga
+    krawedzi + 1, uzywanych cyklicznie - wszystkie klucze w kolejce mieszcza
+    sie w przedziale [cursor, cursor + maxWeight], wiec w kazdym kubelku sa
+    elementy o tym samym kluczu; kolejka nadaje sie do grafow o niewielkich
+    wagach krawedzi;
+  - kopiec pozycyjny (ang. radix heap) ma 65 kubelkow, a element o kluczu k
+    trafia do kubelka o numerze rownym ilosci bitow znaczacych liczby
+    (k xor last), gdzie last to klucz ostatnio zdjetego elementu; koszt
+    zdjecia elementu wynosi O(log C), niezaleznie od wag krawedzi;
+  - liczniki operacji porzadkowania zliczaja przeniesienia elementow pomiedzy
+    kubelkami oraz przejscia przez puste kubelki;
+  - dowiazania elementu ustawiane sa przy jego wpieciu do kubelka, a wypiecie
+    przywraca jego oznaczenie "poza kolejka" (i pusty kubelek) - kolejka
+    oprozniona zdejmowaniem elementow nadaje sie wiec do ponownego uzycia bez
+    przegladu tablic; kolejke niepusta oproznia sie funkcja bucketClear
+    (radixClear), w czasie proporcjonalnym do ilosci kubelkow i elementow
+    pozostawionych w kolejce.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include "common.h"
+#include "bucket.h"
+
+
+#define RADIX_BUCKETS  65
+
+
+//--- Funkcje pomocnicze list dwukierunkowych w kubelkach
+
+void _bucketInsert(int heads[], int next[], int prev[], int where[], int b, int Id) {
+    // Wpiecie elementu na poczatek listy w kubelku b ...
+    next[Id] = heads[b];
+    prev[Id] = -1;
+    if (heads[b] != -1)
+        prev[heads[b]] = Id;
+    heads[b] = Id;
+    // ... i zapamietanie numeru kubelka elementu
+    where[Id] = b;
+}
+
+void _bucketRemove(int heads[], int next[], int prev[], int where[], int Id) {
+    int b = where[Id];
+    // Wypiecie elementu z listy w jego kubelku, ...
+    if (prev[Id] != -1)
+        next[prev[Id]] = next[Id];
+    else heads[b] = next[Id];
+    if (next[Id] != -1)
+        prev[next[Id]] = prev[Id];
+    // ... i oznaczenie go jako "poza kolejka"
+    where[Id] = -1;
+}
+
+void _bucketClear(int heads[], int next[], int where[], int count) {
+    // Oznaczenie elementow pozostawionych w kubelkach jako "poza kolejka" ...
+    for (int b = 0; b < count; b++) {
+        for (int Id = heads[b]; Id != -1; Id = next[Id])
+            where[Id] = -1;
+        // ... i oproznienie kubelkow
+        heads[b] = -1;
+    }
+}
+
+int* _initLinks(int n, int value) {
+    // Alokacja tablicy dowiazan i wypelnienie jej podana wartoscia
+    int *A = new int[n];
+    for (int i = 0; i < n; i++)
+        A[i] = value;
+    return A;
+}
+
+//---
+
+
+TBucketQueue* initBucketQueue(int n, int maxWeight) {
+
+// Zaklada sie, ze najwieksza waga krawedzi nie przekracza DIAL_MAX_WEIGHT
+// (przy wiekszych wagach silniki uzywaja w miejsce kolejki kubelkowej kopca
+// pozycyjnego, a polecenie wyboru kolejki jej nie udostepnia).
+
+    // Alokacja nowej kolejki, ...
+    TBucketQueue *B = new TBucketQueue;
+    // ... z ustaleniem ilosci kubelkow ...
+    B->count = (maxWeight > 0) ? maxWeight + 1 : 1;
+    // ... i wyzerowaniem licznikow
+    B->size = 0;
+    B->cursor = 0;
+    B->sifts = 0;
+
+    // Alokacja kubelkow (wszystkie puste) ...
+    B->heads = _initLinks(B->count, -1);
+    // ... oraz tablic dowiazan (wszystkie elementy "poza kolejka")
+    // i kluczy elementow
+    B->next = new int[n];
+    B->prev = new int[n];
+    B->where = _initLinks(n, -1);
+    B->keys = new INT64[n];
+
+    // Zwrocenie wskaznika na zainicjowana kolejke
+    return B;
+}
+
+
+void killBucketQueue(TBucketQueue* &B) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (B == NULL)
+        return;
+
+    // Skasowanie tablic kolejki, ...
+    delete[] B->heads;
+    delete[] B->next;
+    delete[] B->prev;
+    delete[] B->where;
+    delete[] B->keys;
+
+    // ... a nastepnie kolejki i zwrocenie przez parametr wyzerowanego wskaznika
+    delete B;
+    B = NULL;
+}
+
+
+void bucketClear(TBucketQueue *B) {
+    // Oproznienie kubelkow (o ile w kolejce pozostaly elementy) ...
+    if (B->size > 0)
+        _bucketClear(B->heads, B->next, B->where, B->count);
+    // ... i wyzerowanie licznikow
+    B->size = 0;
+    B->cursor = 0;
+    B->sifts = 0;
+}
+
+
+void bucketPush(TBucketQueue *B, int Id, INT64 key) {
+    // Zapis klucza elementu ...
+    B->keys[Id] = key;
+    // ... i wpiecie go do kubelka wyznaczonego przez klucz
+    _bucketInsert(B->heads, B->next, B->prev, B->where, int(key % B->count), Id);
+    B->size++;
+}
+
+
+int bucketPop(TBucketQueue *B) {
+    // Zakonczenie, gdy kolejka jest pusta
+    if (B->size == 0)
+        return -1;
+
+    // Przejscie do najblizszego niepustego kubelka ...
+    while (B->heads[B->cursor % B->count] == -1) {
+        B->cursor++;
+        B->sifts++;
+    }
+    // ... i wypiecie z niego pierwszego elementu
+    int Id = B->heads[B->cursor % B->count];
+    _bucketRemove(B->heads, B->next, B->prev, B->where, Id);
+    B->size--;
+
+    // Zwrocenie Id elementu o najmniejszym kluczu
+    return Id;
+}
+
+
+void decreaseKey(TBucketQueue *B, int Id, INT64 key) {
+    // Zakonczenie, gdy elementu nie ma w kolejce lub klucz nie maleje
+    if (! bucketContains(B, Id) || key >= B->keys[Id])
+        return;
+
+    // Przeniesienie elementu do kubelka wyznaczonego przez nowy klucz
+    _bucketRemove(B->heads, B->next, B->prev, B->where, Id);
+    B->keys[Id] = key;
+    _bucketInsert(B->heads, B->next, B->prev, B->where, int(key % B->count), Id);
+    B->sifts++;
+}
+
+
+TRadixHeap* initRadixHeap(int n) {
+    // Alokacja nowego kopca, ...
+    TRadixHeap *R = new TRadixHeap;
+    // ... z wyzerowaniem licznikow
+    R->size = 0;
+    R->last = 0;
+    R->sifts = 0;
+
+    // Alokacja kubelkow (wszystkie puste) ...
+    R->heads = _initLinks(RADIX_BUCKETS, -1);
+    // ... oraz tablic dowiazan (wszystkie elementy "poza kopcem")
+    // i kluczy elementow
+    R->next = new int[n];
+    R->prev = new int[n];
+    R->where = _initLinks(n, -1);
+    R->keys = new INT64[n];
+
+    // Zwrocenie wskaznika na zainicjowany kopiec
+    return R;
+}
+
+
+void killRadixHeap(TRadixHeap* &R) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (R == NULL)
+        return;
+
+    // Skasowanie tablic kopca, ...
+    delete[] R->heads;
+    delete[] R->next;
+    delete[] R->prev;
+    delete[] R->where;
+    delete[] R->keys;
+
+    // ... a nastepnie kopca i zwrocenie przez parametr wyzerowanego wskaznika
+    delete R;
+    R = NULL;
+}
+
+
+void radixClear(TRadixHeap *R) {
+    // Oproznienie kubelkow (o ile w kopcu pozostaly elementy) ...
+    if (R->size > 0)
+        _bucketClear(R->heads, R->next, R->where, RADIX_BUCKETS);
+    // ... i wyzerowanie licznikow
+    R->size = 0;
+    R->last = 0;
+    R->sifts = 0;
+}
+
+
+int _radixBucket(TRadixHeap *R, INT64 key) {
+    // Numer kubelka to ilosc bitow znaczacych liczby (key xor last),
+    // tj. pozycja najstarszego bitu, na ktorym klucz rozni sie od ostatnio
+    // zdjetego (0 - gdy klucze sa rowne)
+    unsigned long long x = (unsigned long long)(key ^ R->last);
+    return (x == 0) ? 0 : 64 - __builtin_clzll(x);
+}
+
+
+void radixPush(TRadixHeap *R, int Id, INT64 key) {
+    // Zapis klucza elementu ...
+    R->keys[Id] = key;
+    // ... i wpiecie go do kubelka wyznaczonego przez klucz
+    _bucketInsert(R->heads, R->next, R->prev, R->where, _radixBucket(R, key), Id);
+    R->size++;
+}
+
+
+int radixPop(TRadixHeap *R) {
+    // Zakonczenie, gdy kopiec jest pusty
+    if (R->size == 0)
+        return -1;
+
+    // Gdy kubelek zerowy jest pusty, ...
+    if (R->heads[0] == -1) {
+        // ... odszukanie pierwszego niepustego kubelka, ...
+        int b = 1;
+        while (R->heads[b] == -1)
+            b++;
+        // ... ustalenie najmniejszego klucza w tym kubelku ...
+        INT64 m = R->keys[R->heads[b]];
+        for (int Id = R->heads[b]; Id != -1; Id = R->next[Id])
+            if (R->keys[Id] < m)
+                m = R->keys[Id];
+        // ... i przyjecie go za klucz ostatnio zdjety, a nastepnie
+        // rozdzielenie elementow tego kubelka do kubelkow nizszych
+        R->last = m;
+        int Id = R->heads[b];
+        R->heads[b] = -1;
+        while (Id != -1) {
+            int nextId = R->next[Id];
+            _bucketInsert(R->heads, R->next, R->prev, R->where, _radixBucket(R, R->keys[Id]), Id);
+            R->sifts++;
+            Id = nextId;
+        }
+    }
+    // Wypiecie pierwszego elementu z kubelka zerowego
+    int Id = R->heads[0];
+    _bucketRemove(R->heads, R->next, R->prev, R->where, Id);
+    R->size--;
+
+    // Zwrocenie Id elementu o najmniejszym kluczu
+    return Id;
+}
+
+
+void decreaseKey(TRadixHeap *R, int Id, INT64 key) {
+    // Zakonczenie, gdy elementu nie ma w kopcu lub klucz nie maleje
+    if (! radixContains(R, Id) || key >= R->keys[Id])
+        return;
+
+    // Przeniesienie elementu do kubelka wyznaczonego przez nowy klucz
+    _bucketRemove(R->heads, R->next, R->prev, R->where, Id);
+    R->keys[Id] = key;
+    _bucketInsert(R->heads, R->next, R->prev, R->where, _radixBucket(R, key), Id);
+    R->sifts++;
+}
+
+
+#undef RADIX_BUCKETS
@@ -0,0 +1,94 @@
+#ifndef AC_ENGINE_BUCKET_H
+#define AC_ENGINE_BUCKET_H
+
+#include "common.h"
+
+
+/*
+  Struktura definiujaca kolejke kubelkowa (Diala)
+  size      - ilosc elementow w kolejce
+  count     - ilosc kubelkow (najwieksza waga krawedzi + 1)
+  cursor    - klucz ostatnio zdjetego elementu, tj. kubelka od ktorego zaczyna
+              sie przeszukiwanie kolejki
+  heads     - tablica poczatkow list elementow w kubelkach (-1 - kubelek pusty)
+  next      - n-elementowa tablica nastepnikow elementow na listach kubelkow
+  prev      - n-elementowa tablica poprzednikow elementow na listach kubelkow
+  where     - n-elementowa tablica okreslajaca kubelek elementu (-1 - poza kolejka)
+  keys      - n-elementowa tablica kluczy (priorytetow) elementow
+  sifts     - licznik operacji porzadkowania (przeniesien elementow
+              i przejsc przez puste kubelki)
+*/
+struct TBucketQueue {
+    int size;
+    int count;
+    INT64 cursor;
+    int *heads;
+    int *next;
+    int *prev;
+    int *where;
+    INT64 *keys;
+    INT64 sifts;
+};
+
+
+/*
+  Struktura definiujaca kopiec pozycyjny (ang. radix heap)
+  size      - ilosc elementow w kopcu
+  last      - klucz ostatnio zdjetego elementu
+  heads     - tablica poczatkow list elementow w kubelkach (-1 - kubelek pusty)
+  next, prev, where, keys, sifts
+            - jak w kolejce kubelkowej
+*/
+struct TRadixHeap {
+    int size;
+    INT64 last;
+    int *heads;
+    int *next;
+    int *prev;
+    int *where;
+    INT64 *keys;
+    INT64 sifts;
+};
+
+
+inline int bucketSize(TBucketQueue *B) {
+    // Zwrocenie ilosci elementow w kolejce
+    return B->size;
+}
+
+inline bool bucketContains(TBucketQueue *B, int Id) {
+    // Zwrocenie wartosci logicznej czy element o podanym Id jest w kolejce
+    return (B->where[Id] >= 0);
+}
+
+inline int radixSize(TRadixHeap *R) {
+    // Zwrocenie ilosci elementow w kopcu
+    return R->size;
+}
+
+inline bool radixContains(TRadixHeap *R, int Id) {
+    // Zwrocenie wartosci logicznej czy element o podanym Id jest w kopcu
+    return (R->where[Id] >= 0);
+}
+
+
+TBucketQueue* initBucketQueue(int n, int maxWeight);
+void killBucketQueue(TBucketQueue* &B);
+
+void bucketClear(TBucketQueue *B);
+
+void bucketPush(TBucketQueue *B, int Id, INT64 key);
+int bucketPop(TBucketQueue *B);
+void decreaseKey(TBucketQueue *B, int Id, INT64 key);
+
+TRadixHeap* initRadixHeap(int n);
+void killRadixHeap(TRadixHeap* &R);
+
+void radixClear(TRadixHeap *R);
+
+void radixPush(TRadixHeap *R, int Id, INT64 key);
+int radixPop(TRadixHeap *R);
+void decreaseKey(TRadixHeap *R, int Id, INT64 key);
+
+
+#endif // AC_ENGINE_BUCKET_H
@@ -0,0 +1,206 @@
+/* ----------------------------------------------------------------------------
+
+  TTreeCache - pamiec podreczna drzew najkrotszych sciezek
+
+  UWAGI:
+  - drzewo to kopia dystansow i poprzednikow z dziennika obliczen po pelnej
+    eksploracji grafu z danego wezla zrodlowego;
+  - ilosc drzew ograniczona jest budzetem pamieci, a po jego wyczerpaniu
+    drzewo uzyte najdawniej (LRU) ustepuje miejsca nowemu - jego tablice
+    sa uzywane ponownie, bez przydzielania pamieci;
+  - odtworzenie pojedynczej sciezki do dziennika wymaga jedynie przejscia
+    po jej wezlach (pozostale wpisy dziennika sa wowczas wyczyszczone);
+  - pamiec podreczna nie wie o zmianach grafu - zmieniajacy graf musi ja
+    wyczyscic.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include "common.h"
+#include "cache.h"
+
+
+void _unlinkTree(TTreeCache *C, TTree *T) {
+    // Wylaczenie drzewa z listy LRU
+    if (T->newer != NULL)
+         T->newer->older = T->older;
+    else C->newest = T->older;
+    if (T->older != NULL)
+         T->older->newer = T->newer;
+    else C->oldest = T->newer;
+    T->newer = T->older = NULL;
+}
+
+
+void _linkTree(TTreeCache *C, TTree *T) {
+    // Wlaczenie drzewa na poczatek listy LRU (jako uzytego ostatnio)
+    T->newer = NULL;
+    T->older = C->newest;
+    if (C->newest != NULL)
+         C->newest->newer = T;
+    else C->oldest = T;
+    C->newest = T;
+}
+
+
+TTreeCache* initTreeCache(int length, INT64 budget) {
+    // Alokacja pamieci podrecznej ...
+    TTreeCache *C = new TTreeCache;
+    C->length = length;
+    // ... z wyznaczeniem ilosci drzew miesczacych sie w budzecie pamieci
+    // (zawsze co najmniej jedno drzewo)
+    INT64 size = (INT64)length * (sizeof(INT64) + sizeof(int)) + sizeof(TTree);
+    INT64 capacity = budget / size;
+    C->capacity = (capacity < 1) ? 1 : (capacity > length) ? length : (int)capacity;
+    C->count = 0;
+    // Alokacja (pustej) tablicy wskaznikow drzew wg wezlow zrodlowych
+    C->trees = new TTree*[length];
+    for (int i = 0; i < length; i++)
+        C->trees[i] = NULL;
+    C->newest = C->oldest = NULL;
+    C->hits = C->misses = 0;
+
+    // Zwrocenie wskaznika na zainicjowana pamiec podreczna
+    return C;
+}
+
+
+void killTreeCache(TTreeCache* &C) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (C == NULL)
+        return;
+
+    // Skasowanie wszystkich drzew, ...
+    while (C->newest != NULL) {
+        TTree *T = C->newest;
+        C->newest = T->older;
+        delete[] T->distance;
+        delete[] T->prevId;
+        delete T;
+    }
+    // ... tablicy wskaznikow drzew ...
+    delete[] C->trees;
+    C->trees = NULL;
+
+    // ... i pamieci podrecznej oraz zwrocenie przez parametr wyzerowanego
+    // wskaznika
+    delete C;
+    C = NULL;
+}
+
+
+void clearTreeCache(TTreeCache *C) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (C == NULL)
+        return;
+
+    // Skasowanie wszystkich drzew (np. po zmianie grafu)
+    while (C->newest != NULL) {
+        TTree *T = C->newest;
+        C->newest = T->older;
+        C->trees[T->startId] = NULL;
+        delete[] T->distance;
+        delete[] T->prevId;
+        delete T;
+    }
+    C->oldest = NULL;
+    C->count = 0;
+}
+
+
+TTree* findTree(TTreeCache *C, int startId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (C == NULL)
+        return NULL;
+
+    TTree *T = C->trees[startId];
+    // Zliczenie chybienia, gdy drzewa brak, ...
+    if (T == NULL) {
+        C->misses++;
+        return NULL;
+    }
+    // ... a w przeciwnym razie trafienia i przeniesienie drzewa na poczatek
+    // listy LRU
+    C->hits++;
+    _unlinkTree(C, T);
+    _linkTree(C, T);
+    return T;
+}
+
+
+void storeTree(TTreeCache *C, TJournal *J, int startId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (C == NULL || J == NULL)
+        return;
+
+    // Alias na wielkosc dziennika
+    const int &n = C->length;
+
+    // Wybor drzewa na wyniki: istniejacego dla tego samego wezla zrodlowego,
+    // nowego (o ile miesci sie w budzecie) albo uzytego najdawniej
+    TTree *T = C->trees[startId];
+    if (T != NULL)
+        _unlinkTree(C, T);
+    else if (C->count < C->capacity) {
+        T = new TTree;
+        T->distance = new INT64[n];
+        T->prevId = new int[n];
+        T->newer = T->older = NULL;
+        C->count++;
+    }
+    else {
+        T = C->oldest;
+        _unlinkTree(C, T);
+        C->trees[T->startId] = NULL;
+    }
+
+    // Skopiowanie wynikow z dziennika obliczen ...
+    T->startId = startId;
+    for (int i = 0; i < n; i++) {
+        T->distance[i] = entryDistance(J, i);
+        T->prevId[i] = entryPrev(J, i);
+    }
+    // ... i wlaczenie drzewa na poczatek listy LRU
+    C->trees[startId] = T;
+    _linkTree(C, T);
+}
+
+
+void restoreTree(TJournal *J, TTree *T) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || T == NULL)
+        return;
+
+    // Przepisanie wszystkich wynikow drzewa do dziennika obliczen
+    for (int i = 0; i < J->length; i++) {
+        setDistance(J, i, T->distance[i]);
+        setPrev(J, i, T->prevId[i]);
+        setVisited(J, i, T->distance[i] != 2147483647);
+    }
+    // (odczyt z pamieci podrecznej nie porzadkuje kolejki i nie zwiedza wezlow)
+    J->sifts = 0;
+    J->settled = 0;
+}
+
+
+void restorePath(TJournal *J, TTree *T, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || T == NULL)
+        return;
+
+    // Wyczyszczenie dziennika obliczen (nowa epoka, bez przegladu wpisow) ...
+    clearJournal(J);
+    // ... i przepisanie do niego jedynie wpisow wezlow po najkrotszej
+    // sciezce, od wezla koncowego do startowego
+    int currId = stopId;
+    do {
+        setDistance(J, currId, T->distance[currId]);
+        setPrev(J, currId, T->prevId[currId]);
+        setVisited(J, currId, T->distance[currId] != 2147483647);
+        currId = T->prevId[currId];
+    } while (currId != -1);
+    // (odczyt z pamieci podrecznej nie porzadkuje kolejki i nie zwiedza wezlow)
+    J->sifts = 0;
+    J->settled = 0;
+}
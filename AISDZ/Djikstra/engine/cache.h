@@ -0,0 +1,67 @@
+#ifndef AC_ENGINE_CACHE_H
+#define AC_ENGINE_CACHE_H
+
+#include "common.h"
+#include "dsp.h"
+
+
+/*
+  Struktura definiujaca drzewo najkrotszych sciezek (kopie wynikow pelnej
+  eksploracji grafu z dziennika obliczen DSP)
+  startId   - indeks wezla zrodlowego, z ktorego graf byl eksplorowany
+  distance  - n-elementowa tablica dystansow od wezla zrodlowego
+  prevId    - n-elementowa tablica poprzednikow w najkrotszych sciezkach
+  newer     - drzewo uzyte ostatnio po danym (NULL - brak)
+  older     - drzewo uzyte ostatnio przed danym (NULL - brak)
+*/
+struct TTree {
+    int startId;
+    INT64 *distance;
+    int *prevId;
+    TTree *newer;
+    TTree *older;
+};
+
+
+/*
+  Struktura definiujaca pamiec podreczna drzew najkrotszych sciezek
+  (z usuwaniem drzew najdawniej uzytych - LRU)
+  length    - ilosc wezlow grafu
+  capacity  - najwieksza ilosc drzew miesczacych sie w budzecie pamieci
+  count     - ilosc drzew w pamieci podrecznej
+  trees     - n-elementowa tablica wskaznikow drzew wg wezlow zrodlowych
+              (NULL - brak drzewa)
+  newest    - drzewo uzyte ostatnio (poczatek listy LRU)
+  oldest    - drzewo uzyte najdawniej (koniec listy LRU)
+  hits      - statystyka: ilosc trafien
+  misses    - statystyka: ilosc chybien
+*/
+struct TTreeCache {
+    int length;
+    int capacity;
+    int count;
+    TTree **trees;
+    TTree *newest;
+    TTree *oldest;
+    INT64 hits;
+    INT64 misses;
+};
+
+
+inline bool isCached(TTreeCache *C, int startId) {
+    // Sprawdzenie (bez zmiany kolejnosci LRU) czy drzewo jest w pamieci
+    return (C != NULL && C->trees[startId] != NULL);
+}
+
+
+TTreeCache* initTreeCache(int length, INT64 budget);
+void killTreeCache(TTreeCache* &C);
+void clearTreeCache(TTreeCache *C);
+
+TTree* findTree(TTreeCache *C, int startId);
+void storeTree(TTreeCache *C, TJournal *J, int startId);
+void restoreTree(TJournal *J, TTree *T);
+void restorePath(TJournal *J, TTree *T, int stopId);
+
+
+#endif // AC_ENGINE_CACHE_H
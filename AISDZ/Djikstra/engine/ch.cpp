@@ -0,0 +1,617 @@
+/* ----------------------------------------------------------------------------
+
+  THierarchy - hierarchia skrotow (ang. contraction hierarchies)
+
+  UWAGI:
+  - obliczenia wstepne "kontraktuja" kolejno wszystkie wezly grafu: usuniecie
+    wezla v z grafu roboczego wymaga zachowania dystansow pomiedzy pozostalymi
+    wezlami, dlatego dla kazdej pary lukow u->v i v->x dodawany jest skrot
+    u->x (o wadze rownej sumie wag), o ile przeszukiwanie swiadka (lokalny
+    algorytm Dijkstry od u, z pominieciem v) nie znajdzie drogi nie dluzszej;
+  - przeszukiwanie swiadka jest ograniczone dystansem i iloscia zwiedzonych
+    wezlow - nieodnaleziony swiadek oznacza jedynie zbedny skrot, a nie blad;
+  - kolejnosc kontrakcji wyznacza kopiec priorytetow, gdzie priorytetem wezla
+    jest roznica krawedzi (ilosc skrotow, ktore trzeba by dodac, pomniejszona
+    o ilosc usuwanych lukow) powiekszona o ilosc juz skontraktowanych
+    sasiadow (co rownomiernie rozklada kontrakcje po grafie); priorytety
+    uaktualniane sa leniwie - wezel zdjety z kopca jest oceniany ponownie
+    i wraca do kopca, gdy jego priorytet przestal byc najmniejszy;
+  - luki wezla pozostajace w grafie roboczym w chwili jego kontrakcji prowadza
+    do wezlow wyzszej rangi - luki wychodzace tworza graf "w gore", a luki
+    wchodzace graf "w dol"; oba zapisywane sa w zwartej postaci tablicowej
+    (CSR - ang. compressed sparse row);
+  - zapytanie to dwukierunkowy algorytm Dijkstry, w ktorym oba przeszukiwania
+    przechodza wylacznie do wezlow wyzszej rangi (w przod - po grafie "w gore",
+    wstecz - po grafie "w dol"); kierunek konczy prace, gdy zdjety z kolejki
+    dystans osiagnie dlugosc najkrotszej znanej drogi laczacej;
+  - odnaleziona sciezka jest rozwijana (skroty zastepowane parami lukow przez
+    wezel posredni) i przepisywana do dziennika obliczen, wiec odczytuje sie
+    ja (wraz z dystansem) tak samo jak po eksploracji grafu;
+  - wagi skrotow moga przekraczac najwieksza wage krawedzi w grafie, dlatego
+    zamiast kolejki kubelkowej Diala uzywany jest kopiec pozycyjny.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include "common.h"
+#include "ch.h"
+
+using namespace std::chrono;
+
+
+#define INF             2147483647
+#define WITNESS_LIMIT   500
+
+
+/*
+  Struktura definiujaca liste lukow wezla w grafie roboczym
+  count     - ilosc lukow na liscie
+  size      - pojemnosc tablic listy
+  head      - tablica Id wezlow po drugiej stronie lukow
+  weight    - tablica wag lukow
+  middle    - tablica Id wezlow posrednich (-1 - krawedz oryginalna)
+*/
+struct TArcs {
+    int count;
+    int size;
+    int *head;
+    INT64 *weight;
+    int *middle;
+};
+
+
+/*
+  Struktura definiujaca graf roboczy kontrakcji
+  n         - ilosc wezlow grafu
+  out       - n-elementowa tablica list lukow wychodzacych z wezlow
+  in        - n-elementowa tablica list lukow wchodzacych do wezlow
+  deleted   - n-elementowa tablica ilosci skontraktowanych sasiadow wezlow
+  dist      - n-elementowa tablica dystansow przeszukiwania swiadka
+  touched   - n-elementowa tablica Id wezlow osiagnietych przez ostatnie
+              przeszukiwanie swiadka (do wyczyszczenia dystansow)
+  reached   - ilosc wezlow w tablicy touched
+  W         - kopiec przeszukiwania swiadka
+*/
+struct TContraction {
+    int n;
+    TArcs *out;
+    TArcs *in;
+    int *deleted;
+    INT64 *dist;
+    int *touched;
+    int reached;
+    TIndexHeap *W;
+};
+
+
+// *** Funkcje list lukow grafu roboczego ***
+
+
+void _initArcs(TArcs &A) {
+    A.count = 0;
+    A.size = 0;
+    A.head = NULL;
+    A.weight = NULL;
+    A.middle = NULL;
+}
+
+
+void _killArcs(TArcs &A) {
+    delete[] A.head;
+    delete[] A.weight;
+    delete[] A.middle;
+    _initArcs(A);
+}
+
+
+int _findArc(TArcs &A, int head) {
+    // Wyszukanie na liscie luku prowadzacego do podanego wezla
+    for (int i = 0; i < A.count; i++)
+        if (A.head[i] == head)
+            return i;
+    // Brak takiego luku
+    return -1;
+}
+
+
+void _appendArc(TArcs &A, int head, INT64 weight, int middle) {
+    // Powiekszenie (dwukrotne) tablic listy, gdy sa zapelnione
+    if (A.count == A.size) {
+        int size = (A.size > 0) ? 2 * A.size : 4;
+        int *head = new int[size];
+        INT64 *weight = new INT64[size];
+        int *middle = new int[size];
+        for (int i = 0; i < A.count; i++) {
+            head[i] = A.head[i];
+            weight[i] = A.weight[i];
+            middle[i] = A.middle[i];
+        }
+        delete[] A.head;
+        delete[] A.weight;
+        delete[] A.middle;
+        A.head = head;
+        A.weight = weight;
+        A.middle = middle;
+        A.size = size;
+    }
+    // Dopisanie luku na koncu listy
+    A.head[A.count] = head;
+    A.weight[A.count] = weight;
+    A.middle[A.count] = middle;
+    A.count++;
+}
+
+
+void _removeArc(TArcs &A, int head) {
+    // Usuniecie z listy luku prowadzacego do podanego wezla
+    // (na jego miejsce trafia ostatni luk z listy)
+    int i = _findArc(A, head);
+    if (i == -1)
+        return;
+    A.count--;
+    A.head[i] = A.head[A.count];
+    A.weight[i] = A.weight[A.count];
+    A.middle[i] = A.middle[A.count];
+}
+
+
+// *** Kontrakcja wezlow ***
+
+
+void _witnessSearch(TContraction *C, int sourceId, int skipId, INT64 limit) {
+    // Wyczyszczenie dystansow osiagnietych w poprzednim przeszukiwaniu
+    for (int i = 0; i < C->reached; i++)
+        C->dist[C->touched[i]] = INF;
+    C->reached = 0;
+
+    // Wprowadzenie wezla zrodlowego do kopca
+    C->dist[sourceId] = 0;
+    C->touched[C->reached++] = sourceId;
+    heapPush(C->W, sourceId, 0);
+
+    int settled = 0;
+    // Lokalny algorytm Dijkstry w grafie roboczym, z pominieciem wezla
+    // kontraktowanego, ograniczony dystansem i iloscia zwiedzonych wezlow
+    while (heapSize(C->W) > 0) {
+        int currId = heapPop(C->W);
+        if (C->dist[currId] > limit || ++settled > WITNESS_LIMIT)
+            break;
+        TArcs &A = C->out[currId];
+        for (int i = 0; i < A.count; i++) {
+            int nextId = A.head[i];
+            if (nextId == skipId)
+                continue;
+            INT64 d = C->dist[currId] + A.weight[i];
+            if (C->dist[nextId] > d) {
+                if (C->dist[nextId] == INF)
+                    C->touched[C->reached++] = nextId;
+                C->dist[nextId] = d;
+                if (heapContains(C->W, nextId))
+                    decreaseKey(C->W, nextId, d);
+                else heapPush(C->W, nextId, d);
+            }
+        }
+    }
+    // Oproznienie kopca (do ponownego uzycia)
+    while (heapSize(C->W) > 0)
+        heapPop(C->W);
+}
+
+
+int _contract(TContraction *C, int v, bool simulate) {
+    TArcs &in = C->in[v];
+    TArcs &out = C->out[v];
+
+    // Najwieksza waga luku wychodzacego (ograniczenie przeszukiwan swiadka)
+    INT64 maxOut = 0;
+    for (int j = 0; j < out.count; j++)
+        if (out.weight[j] > maxOut)
+            maxOut = out.weight[j];
+
+    int shortcuts = 0;
+    // Dla kazdego luku wchodzacego u->v ...
+    for (int i = 0; i < in.count; i++) {
+        int u = in.head[i];
+        // ... przeszukiwanie swiadka od u (z pominieciem v) ...
+        _witnessSearch(C, u, v, in.weight[i] + maxOut);
+        // ... i dla kazdego luku wychodzacego v->x ...
+        for (int j = 0; j < out.count; j++) {
+            int x = out.head[j];
+            if (x == u)
+                continue;
+            // ... sprawdzenie, czy droga przez v jest krotsza niz swiadek ...
+            INT64 w = in.weight[i] + out.weight[j];
+            if (C->dist[x] <= w)
+                continue;
+            // ... bo jesli tak, to potrzebny jest skrot u->x
+            shortcuts++;
+            if (simulate)
+                continue;
+            int k = _findArc(C->out[u], x);
+            if (k == -1) {
+                _appendArc(C->out[u], x, w, v);
+                _appendArc(C->in[x], u, w, v);
+            }
+            else {
+                // (istniejacy luk u->x zastepowany jest krotszym skrotem)
+                C->out[u].weight[k] = w;
+                C->out[u].middle[k] = v;
+                k = _findArc(C->in[x], u);
+                C->in[x].weight[k] = w;
+                C->in[x].middle[k] = v;
+            }
+        }
+    }
+    // Zwrocenie ilosci (potrzebnych lub dodanych) skrotow
+    return shortcuts;
+}
+
+
+INT64 _priority(TContraction *C, int v) {
+    // Roznica krawedzi powiekszona o ilosc skontraktowanych sasiadow
+    return _contract(C, v, true) - C->in[v].count - C->out[v].count
+         + C->deleted[v];
+}
+
+
+void _buildCSR(TArcs *A, int n, int* &first, int* &head, INT64* &weight, int* &middle) {
+    // Ustalenie poczatkow krotek wezlow ...
+    first = new int[n +1];
+    first[0] = 0;
+    for (int v = 0; v < n; v++)
+        first[v +1] = first[v] + A[v].count;
+    // ... i przepisanie list lukow do zwartych tablic
+    head = new int[first[n]];
+    weight = new INT64[first[n]];
+    middle = new int[first[n]];
+    for (int v = 0; v < n; v++)
+        for (int i = 0; i < A[v].count; i++) {
+            head[first[v] + i] = A[v].head[i];
+            weight[first[v] + i] = A[v].weight[i];
+            middle[first[v] + i] = A[v].middle[i];
+        }
+}
+
+
+THierarchy* initHierarchy(TGraph *G) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen wstepnych
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowej hierarchii
+    THierarchy *H = new THierarchy;
+    H->length = n;
+    H->rank = new int[n];
+    H->shortcuts = 0;
+
+// *** Zbudowanie grafu roboczego ***
+
+    TContraction *C = new TContraction;
+    C->n = n;
+    C->out = new TArcs[n];
+    C->in = new TArcs[n];
+    C->deleted = new int[n];
+    C->dist = new INT64[n];
+    C->touched = new int[n];
+    C->reached = 0;
+    C->W = initIndexHeap(n);
+    for (int v = 0; v < n; v++) {
+        _initArcs(C->out[v]);
+        _initArcs(C->in[v]);
+        C->deleted[v] = 0;
+        C->dist[v] = INF;
+    }
+    // Przepisanie krawedzi grafu (z pominieciem petli) do list lukow
+    for (int v = 0; v < n; v++)
+        for (int i = 0; i < nodeDegree(G, v); i++) {
+            int x = nodeNeighbour(G, v, i)->Id;
+            if (x == v)
+                continue;
+            _appendArc(C->out[v], x, edgeWeight(G, v, x), -1);
+            _appendArc(C->in[x], v, edgeWeight(G, v, x), -1);
+        }
+
+// *** Kontrakcja wezlow w kolejnosci priorytetow ***
+
+    // Wprowadzenie wszystkich wezlow do kopca priorytetow
+    TIndexHeap *O = initIndexHeap(n);
+    for (int v = 0; v < n; v++)
+        heapPush(O, v, _priority(C, v));
+
+    int order = 0;
+    // Tak dlugo jak w kopcu sa nieskontraktowane wezly, ...
+    while (heapSize(O) > 0) {
+        // ... zdjecie wezla o najmniejszym priorytecie i jego ponowna ocena
+        // (gdy priorytet przestal byc najmniejszy - powrot do kopca) ...
+        int v = heapPop(O);
+        INT64 p = _priority(C, v);
+        if (heapSize(O) > 0 && p > O->keys[heapTop(O)]) {
+            heapPush(O, v, p);
+            continue;
+        }
+        // ... kontrakcja wezla z dodaniem skrotow ...
+        H->shortcuts += _contract(C, v, false);
+        H->rank[v] = order++;
+        // ... i usuniecie go z list lukow sasiadow (wlasne listy wezla
+        // zostaja, bo prowadza wylacznie do wezlow wyzszej rangi)
+        for (int i = 0; i < C->out[v].count; i++) {
+            _removeArc(C->in[C->out[v].head[i]], v);
+            C->deleted[C->out[v].head[i]]++;
+        }
+        for (int i = 0; i < C->in[v].count; i++) {
+            _removeArc(C->out[C->in[v].head[i]], v);
+            C->deleted[C->in[v].head[i]]++;
+        }
+    }
+    killIndexHeap(O);
+
+// *** Zapisanie grafow "w gore" i "w dol" w postaci zwartej ***
+
+    _buildCSR(C->out, n, H->upFirst, H->upHead, H->upWeight, H->upMiddle);
+    _buildCSR(C->in, n, H->downFirst, H->downHead, H->downWeight, H->downMiddle);
+
+    // Skasowanie grafu roboczego
+    for (int v = 0; v < n; v++) {
+        _killArcs(C->out[v]);
+        _killArcs(C->in[v]);
+    }
+    delete[] C->out;
+    delete[] C->in;
+    delete[] C->deleted;
+    delete[] C->dist;
+    delete[] C->touched;
+    killIndexHeap(C->W);
+    delete C;
+
+    // Zapamietanie czasu obliczen wstepnych
+    H->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+
+    // Zwrocenie wskaznika na zainicjowana hierarchie skrotow
+    return H;
+}
+
+
+void killHierarchy(THierarchy* &H) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return;
+
+    // Skasowanie tablic grafu "w gore", ...
+    delete[] H->upFirst;
+    delete[] H->upHead;
+    delete[] H->upWeight;
+    delete[] H->upMiddle;
+    // ... grafu "w dol" ...
+    delete[] H->downFirst;
+    delete[] H->downHead;
+    delete[] H->downWeight;
+    delete[] H->downMiddle;
+    // ... i rang wezlow
+    delete[] H->rank;
+
+    // Skasowanie hierarchii i zwrocenie przez parametr wyzerowanego wskaznika
+    delete H;
+    H = NULL;
+}
+
+
+void hierarchyOrder(THierarchy *H, int order[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return;
+
+    // Zapisanie w tablicy wynikowej Id wezlow od najwyzszej rangi
+    // (skontraktowanych najpozniej, czyli najwazniejszych) do najnizszej
+    for (int v = 0; v < H->length; v++)
+        order[H->length -1 - H->rank[v]] = v;
+}
+
+
+// *** Zapytanie o najkrotsza sciezke ***
+
+
+int _middle(THierarchy *H, int a, int b) {
+    // Wyszukanie luku a->b (w krotce wezla nizszej rangi) i zwrocenie
+    // jego wezla posredniego
+    if (H->rank[a] < H->rank[b]) {
+        for (int i = H->upFirst[a]; i < H->upFirst[a +1]; i++)
+            if (H->upHead[i] == b)
+                return H->upMiddle[i];
+    }
+    else {
+        for (int i = H->downFirst[b]; i < H->downFirst[b +1]; i++)
+            if (H->downHead[i] == a)
+                return H->downMiddle[i];
+    }
+    return -1;
+}
+
+
+int _unpackPath(THierarchy *H, int hops[], int h, int Ids[]) {
+    // Stos par wezlow (lukow) oczekujacych na rozwiniecie
+    int *stack = new int[2 * H->length];
+
+    int c = 0;
+    Ids[c++] = hops[0];
+    // Dla kazdego luku sciezki w hierarchii ...
+    for (int k = 1; k < h; k++) {
+        int top = 0;
+        stack[top++] = hops[k -1];
+        stack[top++] = hops[k];
+        // ... rozwijanie skrotow, az do krawedzi oryginalnych
+        while (top > 0) {
+            int b = stack[--top];
+            int a = stack[--top];
+            int m = _middle(H, a, b);
+            if (m == -1)
+                Ids[c++] = b;
+            else {
+                // (najpierw rozwijany jest odcinek a->m, potem m->b)
+                stack[top++] = m;
+                stack[top++] = b;
+                stack[top++] = a;
+                stack[top++] = m;
+            }
+        }
+    }
+    delete[] stack;
+
+    // Zwrocenie ilosci wezlow rozwinietej sciezki
+    return c;
+}
+
+
+template <typename TQueue>
+void _exploreHierarchy(TJournal *J, TGraph *G, THierarchy *H, int startId, int stopId) {
+    // Alias na wielkosc dziennika
+    const int &n = J->length;
+    // Alias na dziennik przeszukiwania wstecz
+    TJournal *R = J->reverse;
+
+// *** Umieszczenie wpisow startowych w kolejkach priorytetowych ***
+
+    clearJournal(J);
+    clearJournal(R);
+    setDistance(J, startId, 0);
+    setDistance(R, stopId, 0);
+
+    TQueue *QF, *QR;
+    journalQueue(J, QF, G->profile[gpMaxWeight]);
+    journalQueue(R, QR, G->profile[gpMaxWeight]);
+    enqueue(QF, startId, 0);
+    enqueue(QR, stopId, 0);
+
+// *** Naprzemienna analiza grafu "w gore" i "w dol" ***
+
+    INT64 mu = (startId == stopId) ? 0 : INF;
+    int meetId = (startId == stopId) ? startId : -1;
+    bool doneF = false;
+    bool doneR = false;
+    bool forward = false;
+
+    J->settled = 0;
+    // Tak dlugo jak ktorys z kierunkow nie zakonczyl pracy, ...
+    while (! doneF || ! doneR) {
+        // ... wybor kierunku (naprzemiennie, o ile drugi nie zakonczyl pracy), ...
+        forward = doneR || (! doneF && ! forward);
+        TJournal *X = forward ? J : R;
+        TJournal *Y = forward ? R : J;
+        TQueue *Q = forward ? QF : QR;
+        bool &done = forward ? doneF : doneR;
+        if (queueSize(Q) == 0) {
+            done = true;
+            continue;
+        }
+        // ... zdjecie z czola kolejki wpisu o najmniejszym dystansie
+        // (gdy nie jest krotszy niz najkrotsza znana droga - koniec kierunku) ...
+        int currId = dequeue(Q);
+        if (entryDistance(X, currId) >= mu) {
+            done = true;
+            continue;
+        }
+        setVisited(X, currId, true);
+        J->settled++;
+        // ... i dla kazdego luku do wezla wyzszej rangi ...
+        int first = forward ? H->upFirst[currId] : H->downFirst[currId];
+        int last = forward ? H->upFirst[currId +1] : H->downFirst[currId +1];
+        for (int i = first; i < last; i++) {
+            int nextId = forward ? H->upHead[i] : H->downHead[i];
+            if (isVisited(X, nextId))
+                continue;
+            INT64 dist = entryDistance(X, currId)
+                       + (forward ? H->upWeight[i] : H->downWeight[i]);
+            // ... gdy droga krotsza -- ZAPIS ...
+            if (entryDistance(X, nextId) > dist) {
+                setDistance(X, nextId, dist);
+                setPrev(X, nextId, currId);
+                requeue(Q, nextId, dist);
+                // ... ze sprawdzeniem drogi laczacej oba przeszukiwania
+                INT64 total = dist + entryDistance(Y, nextId);
+                if (total < mu) {
+                    mu = total;
+                    meetId = nextId;
+                }
+            }
+        }
+    }
+
+// *** Rozwiniecie i zapisanie najkrotszej sciezki w dzienniku obliczen ***
+
+    if (meetId != -1) {
+        // Zebranie sekwencji wezlow sciezki w hierarchii: od startowego
+        // do wezla spotkania (wstecz po dzienniku w przod) ...
+        int *hops = new int[n];
+        int h = 0;
+        for (int currId = meetId; currId != -1; currId = entryPrev(J, currId))
+            hops[h++] = currId;
+        for (int i = 0; i < h / 2; i++) {
+            int x = hops[i];
+                    hops[i] = hops[h -1 -i];
+                              hops[h -1 -i] = x;
+        }
+        // ... i dalej do koncowego (po dzienniku wstecz)
+        for (int currId = entryPrev(R, meetId); currId != -1; currId = entryPrev(R, currId))
+            hops[h++] = currId;
+
+        // Rozwiniecie skrotow do sekwencji wezlow grafu ...
+        int *Ids = new int[n];
+        int c = _unpackPath(H, hops, h, Ids);
+        // ... i przepisanie jej do dziennika obliczen
+        for (int i = 1; i < c; i++) {
+            setDistance(J, Ids[i], entryDistance(J, Ids[i -1])
+                                 + edgeWeight(G, Ids[i -1], Ids[i]));
+            setPrev(J, Ids[i], Ids[i -1]);
+        }
+        delete[] Ids;
+        delete[] hops;
+    }
+
+    // Zapamietanie statystyki obliczen ...
+    J->sifts = queueSifts(QF) + queueSifts(QR);
+    // ... i oproznienie kolejek priorytetowych
+    clearQueue(QF);
+    clearQueue(QR);
+}
+
+
+void exploreHierarchy(TJournal *J, TGraph *G, THierarchy *H, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL)
+        return;
+
+    // Bez hierarchii skrotow (lub wezla koncowego) - algorytm Dijkstry
+    if (H == NULL || stopId < 0) {
+        exploreGraph(J, G, startId, stopId);
+        return;
+    }
+
+    // Zainicjowanie (przy pierwszym uzyciu) dziennika przeszukiwania wstecz
+    if (J->reverse == NULL)
+        J->reverse = initJournal(J->length);
+
+    // Uruchomienie silnika obliczeniowego z kolejkami priorytetowymi rodzaju
+    // wybranego w dzienniku obliczen (kolejke kubelkowa zastepuje kopiec
+    // pozycyjny)
+    switch (J->queue) {
+        case qkQuadHeap    : _exploreHierarchy<TQuadHeap>(J, G, H, startId, stopId);
+                             break;
+        case qkPairingHeap : _exploreHierarchy<TPairingHeap>(J, G, H, startId, stopId);
+                             break;
+        case qkBuckets     :
+        case qkRadix       : _exploreHierarchy<TRadixHeap>(J, G, H, startId, stopId);
+                             break;
+        default            : _exploreHierarchy<TIndexHeap>(J, G, H, startId, stopId);
+    }
+}
+
+
+#undef WITNESS_LIMIT
+#undef INF
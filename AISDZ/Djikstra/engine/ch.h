@@ -0,0 +1,50 @@
+#ifndef AC_ENGINE_CH_H
+#define AC_ENGINE_CH_H
+
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+
+
+/*
+  Struktura definiujaca hierarchie skrotow (ang. contraction hierarchies)
+  length    - ilosc wezlow grafu
+  rank      - n-elementowa tablica pozycji wezlow w porzadku kontrakcji
+  upFirst   - (n+1)-elementowa tablica poczatkow krotek grafu "w gore"
+              (krotka wezla v zajmuje pozycje od upFirst[v] do upFirst[v+1]-1)
+  upHead    - tablica Id wezlow koncowych lukow v->x "w gore" (rank x > rank v)
+  upWeight  - tablica wag lukow "w gore"
+  upMiddle  - tablica Id wezlow posrednich lukow "w gore" (-1 - krawedz
+              oryginalna, w przeciwnym razie skrot przez podany wezel)
+  downFirst - (n+1)-elementowa tablica poczatkow krotek grafu "w dol"
+  downHead  - tablica Id wezlow poczatkowych lukow u->v "w dol", zapisanych
+              w krotce wezla v (rank u > rank v)
+  downWeight - tablica wag lukow "w dol"
+  downMiddle - tablica Id wezlow posrednich lukow "w dol"
+  shortcuts - statystyka: ilosc utworzonych skrotow
+  time      - statystyka: czas obliczen wstepnych [us]
+*/
+struct THierarchy {
+    int length;
+    int *rank;
+    int *upFirst;
+    int *upHead;
+    INT64 *upWeight;
+    int *upMiddle;
+    int *downFirst;
+    int *downHead;
+    INT64 *downWeight;
+    int *downMiddle;
+    int shortcuts;
+    INT64 time;
+};
+
+
+THierarchy* initHierarchy(TGraph *G);
+void killHierarchy(THierarchy* &H);
+void hierarchyOrder(THierarchy *H, int order[]);
+
+void exploreHierarchy(TJournal *J, TGraph *G, THierarchy *H, int startId, int stopId);
+
+
+#endif // AC_ENGINE_CH_H
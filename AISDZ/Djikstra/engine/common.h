@@ -7,6 +7,8 @@ using namespace std;
 
 
 typedef long long int INT64;
+typedef unsigned long long int UINT64;
+typedef unsigned int UINT32;
 
 
 #endif // AC_ENGINE_COMMON_H
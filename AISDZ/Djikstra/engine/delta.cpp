@@ -0,0 +1,445 @@
+/* ----------------------------------------------------------------------------
+
+  Rownolegly algorytm delta-stepping (wyznaczanie najkrotszych sciezek)
+
+  UWAGI:
+  - wezly grupowane sa w kubelkach o szerokosci delta wg dystansu od wezla
+    startowego (kubelek i obejmuje dystanse od i*delta do (i+1)*delta -1),
+    a kubelki przetwarzane sa kolejno, od najblizszego;
+  - krawedzie dziela sie na lekkie (waga nie wieksza niz delta) i ciezkie;
+    wezly kubelka przetwarzane sa fazami - w kazdej fazie relaksowane sa
+    krawedzie lekkie wezlow kubelka (co moze dopisac do niego kolejne wezly),
+    az kubelek pozostanie pusty; dopiero wtedy dystanse jego wezlow sa
+    ostateczne, wiec krawedzie ciezkie relaksowane sa jednokrotnie;
+  - kazdy wezel ma watek-wlasciciela (Id wezla modulo ilosc watkow), ktory
+    jako jedyny zapisuje jego dystans i trzyma go we wlasnych kubelkach;
+    relaksacja krawedzi do cudzego wezla to zadanie przekazywane
+    wlascicielowi przez skrzynke nadawczo-odbiorcza, odczytywana po barierze -
+    watki nie potrzebuja wiec blokad ani operacji atomowych na dystansach;
+  - kubelki sa cykliczne: wszystkie nieostateczne dystanse mieszcza sie
+    w przedziale (najwieksza waga krawedzi + 2 * delta), wiec wystarcza
+    maxWeight / delta + 2 kubelkow; nieaktualne wpisy kubelkow (wezlow,
+    ktorych dystans pozniej skrocono) sa pomijane przy przetwarzaniu;
+  - ilosc kubelkow kazdego watku nie przekracza rzedu grafu + 2 - gdy
+    najwieksza waga krawedzi jest nieproporcjonalnie duza wzgledem delta
+    (np. po zmianach wag albo w nakladce zmian grafu), szerokosc kubelka
+    jest zwiekszana (poprawnosc algorytmu nie zalezy od delta);
+  - szerokosc delta dobierana jest domyslnie ze sredniej wagi krawedzi
+    i sredniego stopnia wezla (delta ~ 2 * srednia waga / sredni stopien,
+    tj. najwieksza waga / stopien dla wag o rozkladzie jednostajnym);
+  - wezly poprzedzajace ustalane sa po wyznaczeniu dystansow, wg tej samej
+    reguly co w silniku sekwencyjnym (najmniejszy dystans, a przy remisie
+    najmniejsze Id), wiec dziennik obliczen jest identyczny z wynikiem
+    exploreGraph; statystyka obliczen to ilosc wpisow do kubelkow i ilosc
+    zwiedzonych wezlow;
+  - nakladka zmian grafu wskazana w dzienniku obliczen jest uwzgledniana
+    przy relaksacji krawedzi i przy ustalaniu wezlow poprzedzajacych (watki
+    jedynie ja odczytuja);
+  - obliczenia moga startowac z wielu wezlow zrodlowych naraz (wszystkie
+    w kubelku zerowym) - dystanse i las najkrotszych sciezek sa wowczas
+    identyczne z wynikiem exploreSources, a wiec i przydzial wezlow do
+    najblizszych wezlow zrodlowych.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include "common.h"
+#include "delta.h"
+#include "parallel.h"
+
+
+/*
+  Struktura definiujaca liste wezlow (kubelek lub zadania relaksacji)
+  count     - ilosc pozycji na liscie
+  size      - pojemnosc tablic listy
+  Ids       - tablica Id wezlow
+  dists     - tablica dystansow (tylko zadania relaksacji, inaczej NULL)
+*/
+struct TNodeList {
+    int count;
+    int size;
+    int *Ids;
+    INT64 *dists;
+};
+
+
+/*
+  Struktura kontekstu zespolu watkow algorytmu delta-stepping
+  G         - graf
+  J         - dziennik obliczen (wyniki)
+  sources   - ilosc wezlow startowych
+  startIds  - tablica Id wezlow startowych
+  threads   - ilosc watkow zespolu
+  delta     - szerokosc kubelka
+  slots     - ilosc kubelkow cyklicznych kazdego watku
+  dist      - n-elementowa tablica dystansow wezlow
+  done      - n-elementowa tablica dystansow, z ktorymi wezly ostatnio
+              przetworzono (-1 - nieprzetworzone)
+  settled   - n-elementowa tablica znacznikow wezlow zwiedzonych
+  buckets   - tablice kubelkow cyklicznych poszczegolnych watkow
+  frontier  - listy robocze wezlow biezacego kubelka poszczegolnych watkow
+  removed   - listy wezlow zwiedzonych w biezacym kubelku (poszczegolnych
+              watkow)
+  outbox    - (t*t)-elementowa tablica skrzynek zadan relaksacji, gdzie
+              skrzynka [src * t + dst] zawiera zadania od watku src dla dst
+  next      - najblizsze niepuste kubelki poszczegolnych watkow (-1 - brak)
+  active    - znaczniki niepustego biezacego kubelka poszczegolnych watkow
+  sifts     - statystyka: ilosc wpisow do kubelkow poszczegolnych watkow
+  count     - statystyka: ilosc zwiedzonych wezlow poszczegolnych watkow
+  barrier   - bariera synchronizacji faz
+*/
+struct TDeltaTask {
+    TGraph *G;
+    TJournal *J;
+    int sources;
+    const int *startIds;
+    int threads;
+    int delta;
+    int slots;
+    INT64 *dist;
+    INT64 *done;
+    bool *settled;
+    TNodeList **buckets;
+    TNodeList *frontier;
+    TNodeList *removed;
+    TNodeList *outbox;
+    INT64 *next;
+    bool *active;
+    INT64 *sifts;
+    int *count;
+    TBarrier barrier;
+};
+
+
+// *** Funkcje list wezlow ***
+
+
+void _initList(TNodeList &L, bool dists) {
+    L.count = 0;
+    L.size = 4;
+    L.Ids = new int[L.size];
+    L.dists = dists ? new INT64[L.size] : NULL;
+}
+
+
+void _killList(TNodeList &L) {
+    delete[] L.Ids;
+    delete[] L.dists;
+    L.Ids = NULL;
+    L.dists = NULL;
+    L.count = L.size = 0;
+}
+
+
+void _append(TNodeList &L, int Id, INT64 dist) {
+    // Powiekszenie (dwukrotne) tablic listy, gdy sa zapelnione
+    if (L.count == L.size) {
+        int size = 2 * L.size;
+        int *Ids = new int[size];
+        INT64 *dists = (L.dists != NULL) ? new INT64[size] : NULL;
+        for (int i = 0; i < L.count; i++) {
+            Ids[i] = L.Ids[i];
+            if (dists != NULL)
+                dists[i] = L.dists[i];
+        }
+        delete[] L.Ids;
+        delete[] L.dists;
+        L.Ids = Ids;
+        L.dists = dists;
+        L.size = size;
+    }
+    // Dopisanie pozycji na koncu listy
+    L.Ids[L.count] = Id;
+    if (L.dists != NULL)
+        L.dists[L.count] = dist;
+    L.count++;
+}
+
+
+void _swap(TNodeList &A, TNodeList &B) {
+    // Zamiana zawartosci list (bez kopiowania tablic)
+    TNodeList X = A;
+    A = B;
+    B = X;
+}
+
+
+// *** Algorytm delta-stepping ***
+
+
+int chooseDelta(TGraph *G) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub graf nie ma modelu)
+    if (G == NULL || G->profile == NULL || G->order == 0)
+        return 1;
+
+    // Ilosc krawedzi (w obu kierunkach przejscia) i sredni stopien wezla
+    INT64 arcs = 0;
+    for (int v = 0; v < G->order; v++)
+        arcs += nodeDegree(G, v);
+    INT64 degree = arcs / G->order;
+    if (degree < 1)
+        degree = 1;
+
+    // Szerokosc kubelka ze sredniej wagi krawedzi i sredniego stopnia
+    // (co najmniej 1)
+    INT64 delta = 2 * (INT64)G->profile[gpMeanWeight] / degree;
+    return (delta > 1) ? (int)delta : 1;
+}
+
+
+void _relaxEdges(TDeltaTask *T, int worker, int Id, bool light) {
+    // Alias na ilosc watkow zespolu
+    const int &t = T->threads;
+
+    // Dla kazdej krawedzi lekkiej (albo ciezkiej) wychodzacej z wezla
+    // (z pominieciem krawedzi zamknietych w nakladce zmian grafu) ...
+    for (int i = 0; i < nodeDegree(T->G, Id); i++) {
+        int nextId = T->G->adjList[Id][i];
+        int w = arcWeight(T->J->overlay, T->G, Id, nextId);
+        if (w == 0 || (w <= T->delta) != light)
+            continue;
+        // ... wyslanie zadania relaksacji do wlasciciela wezla nastepnego
+        _append(T->outbox[worker * t + nextId % t], nextId, T->dist[Id] + w);
+    }
+}
+
+
+void _receive(TDeltaTask *T, int worker) {
+    // Alias na ilosc watkow zespolu
+    const int &t = T->threads;
+
+    // Dla kazdego zadania relaksacji od kazdego z watkow ...
+    for (int src = 0; src < t; src++) {
+        TNodeList &box = T->outbox[src * t + worker];
+        for (int i = 0; i < box.count; i++) {
+            int Id = box.Ids[i];
+            INT64 d = box.dists[i];
+            // ... gdy droga krotsza -- ZAPIS i wpis do kubelka
+            if (d < T->dist[Id]) {
+                T->dist[Id] = d;
+                _append(T->buckets[worker][(d / T->delta) % T->slots], Id, 0);
+                T->sifts[worker]++;
+            }
+        }
+        // (oproznienie skrzynki po odczytaniu)
+        box.count = 0;
+    }
+}
+
+
+INT64 _nextBucket(TDeltaTask *T, int worker, INT64 curr) {
+    // Wyszukanie najblizszego niepustego kubelka watku (poczawszy od biezacego)
+    for (int k = 0; k < T->slots; k++)
+        if (T->buckets[worker][(curr + k) % T->slots].count > 0)
+            return curr + k;
+    // Brak niepustych kubelkow
+    return -1;
+}
+
+
+void _deltaWorker(void *context, int index, int worker) {
+    TDeltaTask *T = (TDeltaTask *)context;
+    // Aliasy na rzad grafu i ilosc watkow zespolu
+    const int &n = T->G->order;
+    const int &t = T->threads;
+
+    TNodeList &F = T->frontier[worker];
+    TNodeList &R = T->removed[worker];
+
+    // Ustawienie wartosci poczatkowych dla wezlow watku ...
+    for (int v = worker; v < n; v += t) {
+        T->dist[v] = 2147483647;
+        T->done[v] = -1;
+        T->settled[v] = false;
+    }
+    // ... i wpis wezlow startowych do kubelka zerowego ich wlasciciela
+    // (z pominieciem Id spoza zakresu i powtorzen)
+    for (int s = 0; s < T->sources; s++) {
+        int startId = T->startIds[s];
+        if (startId < 0 || startId >= n || startId % t != worker || T->dist[startId] == 0)
+            continue;
+        T->dist[startId] = 0;
+        _append(T->buckets[worker][0], startId, 0);
+        T->sifts[worker]++;
+    }
+    waitBarrier(&T->barrier);
+
+    INT64 curr = 0;
+    while (true) {
+        // Wybor najblizszego niepustego kubelka (wspolnie wszystkich watkow)
+        T->next[worker] = _nextBucket(T, worker, curr);
+        waitBarrier(&T->barrier);
+        curr = -1;
+        for (int w = 0; w < t; w++)
+            if (T->next[w] >= 0 && (curr < 0 || T->next[w] < curr))
+                curr = T->next[w];
+        // Zakonczenie obliczen, gdy wszystkie kubelki sa puste
+        if (curr < 0)
+            break;
+
+        // Fazy relaksacji krawedzi lekkich, az kubelek pozostanie pusty
+        R.count = 0;
+        TNodeList &B = T->buckets[worker][curr % T->slots];
+        while (true) {
+            // Przejecie zawartosci kubelka jako listy roboczej ...
+            _swap(F, B);
+            B.count = 0;
+            for (int i = 0; i < F.count; i++) {
+                int Id = F.Ids[i];
+                // ... z pominieciem wpisow nieaktualnych (dystans skrocono
+                // do innego kubelka) i wezlow juz przetworzonych ...
+                if (T->dist[Id] / T->delta != curr || T->done[Id] == T->dist[Id])
+                    continue;
+                T->done[Id] = T->dist[Id];
+                // ... (zapamietanie wezla jako zwiedzonego w tym kubelku) ...
+                if (! T->settled[Id]) {
+                    T->settled[Id] = true;
+                    _append(R, Id, 0);
+                }
+                // ... i relaksacja jego krawedzi lekkich
+                _relaxEdges(T, worker, Id, true);
+            }
+            waitBarrier(&T->barrier);
+            // Odbior zadan relaksacji od wszystkich watkow
+            _receive(T, worker);
+            T->active[worker] = (B.count > 0);
+            waitBarrier(&T->barrier);
+            bool active = false;
+            for (int w = 0; w < t; w++)
+                active = active || T->active[w];
+            if (! active)
+                break;
+        }
+
+        // Relaksacja krawedzi ciezkich wezlow zwiedzonych w tym kubelku
+        // (ich dystanse sa juz ostateczne)
+        for (int i = 0; i < R.count; i++)
+            _relaxEdges(T, worker, R.Ids[i], false);
+        T->count[worker] += R.count;
+        waitBarrier(&T->barrier);
+        _receive(T, worker);
+    }
+
+// *** Zapis wynikow w dzienniku obliczen (dla wezlow watku) ***
+
+    // (watek zapisuje cale bloki po 64 wezly, aby zadne slowo mapy bitowej
+    // wezlow zwiedzonych nie bylo zapisywane przez kilka watkow)
+    for (int b = 64 * worker; b < n; b += 64 * t)
+        for (int v = b; v < n && v < b + 64; v++) {
+            setDistance(T->J, v, T->dist[v]);
+            setVisited(T->J, v, T->settled[v]);
+            // Wezel poprzedzajacy wg reguly silnika sekwencyjnego, tj. sposrod
+            // poprzednikow na najkrotszych sciezkach - o najmniejszym dystansie,
+            // a przy remisie o najmniejszym Id (wezly startowe, tj. o dystansie
+            // zerowym, nie maja wezla poprzedzajacego)
+            int prevId = -1;
+            if (T->dist[v] != 0 && T->dist[v] != 2147483647)
+                for (int i = 0; i < nodeInDegree(T->G, v); i++) {
+                    int u = T->G->revList[v][i];
+                    int w = arcWeight(T->J->overlay, T->G, u, v);
+                    if (w == 0 || T->dist[u] == 2147483647 || T->dist[u] + w != T->dist[v])
+                        continue;
+                    if (prevId == -1 || T->dist[u] < T->dist[prevId]
+                     || (T->dist[u] == T->dist[prevId] && u < prevId))
+                        prevId = u;
+                }
+            setPrev(T->J, v, prevId);
+        }
+}
+
+
+void exploreParallel(TJournal *J, TGraph *G, int count, int startIds[], int threads, int delta) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL || startIds == NULL)
+        return;
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Ustalenie ilosci watkow (0 - wszystkie watki sprzetowe)
+    // i szerokosci kubelka (0 - dobor automatyczny)
+    int t = workerCount(threads, n);
+    if (delta < 1)
+        delta = chooseDelta(G);
+    // (z ograniczeniem ilosci kubelkow cyklicznych do rzedu grafu + 2, tj.
+    // poszerzeniem kubelka, gdy najwieksza waga krawedzi jest zbyt duza)
+    const int maxWeight = maxArcWeight(J->overlay, G);
+    if (maxWeight / delta > n)
+        delta = (int)(((INT64)maxWeight + n -1) / n);
+
+    // Zainicjowanie kontekstu zespolu watkow ...
+    TDeltaTask *T = new TDeltaTask;
+    T->G = G;
+    T->J = J;
+    T->sources = count;
+    T->startIds = startIds;
+    T->threads = t;
+    T->delta = delta;
+    T->slots = maxWeight / delta + 2;
+    T->dist = new INT64[n];
+    T->done = new INT64[n];
+    T->settled = new bool[n];
+    // ... z kubelkami, listami roboczymi i statystyka kazdego z watkow ...
+    T->buckets = new TNodeList*[t];
+    T->frontier = new TNodeList[t];
+    T->removed = new TNodeList[t];
+    T->next = new INT64[t];
+    T->active = new bool[t];
+    T->sifts = new INT64[t];
+    T->count = new int[t];
+    for (int w = 0; w < t; w++) {
+        T->buckets[w] = new TNodeList[T->slots];
+        for (int k = 0; k < T->slots; k++)
+            _initList(T->buckets[w][k], false);
+        _initList(T->frontier[w], false);
+        _initList(T->removed[w], false);
+        T->sifts[w] = 0;
+        T->count[w] = 0;
+    }
+    // ... oraz skrzynkami zadan relaksacji kazdej pary watkow
+    T->outbox = new TNodeList[t * t];
+    for (int i = 0; i < t * t; i++)
+        _initList(T->outbox[i], true);
+    initBarrier(&T->barrier, t);
+
+    // Uruchomienie obliczen w zespole watkow
+    runTeam(t, _deltaWorker, T);
+
+    // Zapamietanie statystyki obliczen ...
+    J->sifts = 0;
+    J->settled = 0;
+    for (int w = 0; w < t; w++) {
+        J->sifts += T->sifts[w];
+        J->settled += T->count[w];
+    }
+
+    // ... i skasowanie kontekstu zespolu watkow
+    for (int w = 0; w < t; w++) {
+        for (int k = 0; k < T->slots; k++)
+            _killList(T->buckets[w][k]);
+        delete[] T->buckets[w];
+        _killList(T->frontier[w]);
+        _killList(T->removed[w]);
+    }
+    for (int i = 0; i < t * t; i++)
+        _killList(T->outbox[i]);
+    delete[] T->outbox;
+    delete[] T->buckets;
+    delete[] T->frontier;
+    delete[] T->removed;
+    delete[] T->next;
+    delete[] T->active;
+    delete[] T->sifts;
+    delete[] T->count;
+    delete[] T->dist;
+    delete[] T->done;
+    delete[] T->settled;
+    delete T;
+}
+
+
+void exploreParallel(TJournal *J, TGraph *G, int startId, int threads, int delta) {
+    // Obliczenia z jednego wezla startowego
+    exploreParallel(J, G, 1, &startId, threads, delta);
+}
@@ -0,0 +1,15 @@
+#ifndef AC_ENGINE_DELTA_H
+#define AC_ENGINE_DELTA_H
+
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+
+
+int chooseDelta(TGraph *G);
+
+void exploreParallel(TJournal *J, TGraph *G, int count, int startIds[], int threads, int delta);
+void exploreParallel(TJournal *J, TGraph *G, int startId, int threads, int delta);
+
+
+#endif // AC_ENGINE_DELTA_H
@@ -13,14 +13,112 @@
   - wpisy z dziennika obliczen przetwarzane sa w kolejce priorytetowej, ktora
     "promuje" do nastepnego kroku obliczeniowego wpis o najkorzystniejszym
     biezacym wyniku jednostkowym (czyli wpis zwiazany z wezlem zlokalizowanym
-    na najkrotszej sciezce).
+    na najkrotszej sciezce);
+  - kolejka priorytetowa to indeksowany kopiec binarny - skrocenie dystansu
+    we wpisie wymaga jedynie przesiania go w gore kopca, dzieki czemu koszt
+    obliczen wynosi O((n + E) log n);
+  - silnik obliczeniowy jest szablonem parametryzowanym rodzajem kolejki
+    priorytetowej (kopiec binarny, kopiec 4-arny, kopiec parujacy, kolejka
+    kubelkowa Diala, kopiec pozycyjny), a wybor kolejki zapisany jest
+    w dzienniku obliczen i moze byc zmieniany w trakcie pracy programu;
+  - poniewaz wagi krawedzi sa nieujemnymi liczbami calkowitymi, domyslnie
+    wybierana jest kolejka monotoniczna: kolejka kubelkowa Diala (dla
+    niewielkich wag krawedzi) albo kopiec pozycyjny - w zaleznosci od
+    najwiekszej wagi krawedzi w grafie;
+  - w grafach niewazonych (wszystkie krawedzie o wadze 1) eksploracja grafu
+    to przeszukiwanie wszerz (BFS, z optymalizacja kierunku) - niezaleznie
+    od wybranej kolejki, o ile nie wskazano flag krawedzi;
+  - w grafach o co najwyzej 64 wezlach domyslnie wybierana jest maska bitowa:
+    zbiory wezlow osiagnietych i zwiedzonych to pojedyncze slowa 64-bitowe,
+    dystanse i wezly poprzedzajace to tablice o stalej wielkosci na stosie,
+    a wezel o najmniejszym dystansie wybierany jest przegladem bitow maski
+    (bez rozgalezien) - obliczenia nie alokuja wiec zadnej pamieci; wariant
+    eksploracji w przod/wstecz jest ustalany w czasie kompilacji (szablon);
+  - w grafach gestych (ilosc krawedzi rzedu n^2) domyslnie wybierana jest
+    tablica dystansow przegladana liniowo: kazdy krok to wyszukanie minimum
+    w tablicy i relaksacja calego wiersza macierzy sasiedztwa wezla
+    biezacego (polaczona z wyszukaniem minimum), tj. O(n^2) w sumie;
+    relaksacja przetwarza po kilka wezlow naraz, bez rozgalezien, na wektorach
+    liczb 32-bitowych o szerokosci rejestru wektorowego (rozszerzenie
+    kompilatorow GCC/Clang); silnik nie obsluguje eksploracji wstecz, flag
+    krawedzi ani dystansow spoza zakresu liczb 32-bitowych (wtedy uzywany
+    jest kopiec binarny);
+  - wpisy trafiaja do kolejki dopiero z chwila odkrycia drogi do ich wezlow,
+    dzieki czemu w kolejce nigdy nie ma wpisow o nieznanym dystansie;
+  - wpisy dziennika przechowywane sa kolumnami (tablice dystansow, wezlow
+    poprzedzajacych i epok oraz mapa bitowa wezlow zwiedzonych), a Id wezla
+    jest indeksem w tych tablicach - relaksacja krawedzi siega wiec wprost
+    do tablic, bez posrednictwa wskaznikow na wpisy;
+  - wpisy dziennika znakowane sa epoka obliczen: wyczyszczenie dziennika to
+    jedynie rozpoczecie nowej epoki (bez przegladu wpisow), a dane poczatkowe
+    ustawiane sa we wpisie dopiero przy pierwszym siegnieciu do niego
+    w nowej epoce - koszt przygotowania dziennika nie zalezy wiec od rzedu
+    grafu, lecz od ilosci wpisow uzytych w obliczeniach;
+  - z tego samego powodu kolejki priorytetowe naleza do dziennika: kazda
+    tworzona jest raz (przy pierwszych obliczeniach z kolejka danego
+    rodzaju), a po obliczeniach jedynie oprozniana z elementow, ktore w niej
+    pozostaly (zdjecie elementu przywraca jego oznaczenie "poza kolejka") -
+    koszt przygotowania kolejki takze nie zalezy od rzedu grafu;
+  - gdy podano wezel koncowy, obliczenia koncza sie z chwila jego zwiedzenia
+    (tj. gdy jego dystans staje sie ostateczny) - w dzienniku obliczen sa
+    wowczas ostateczne wyniki wszystkich wezlow zwiedzonych, w tym wezla
+    koncowego, a pozostale wpisy moga zawierac wyniki czastkowe;
+  - wyszukiwanie dwukierunkowe prowadzi naprzemiennie przeszukiwanie w przod
+    (od wezla startowego) i wstecz (od wezla koncowego, po odwroconej liscie
+    sasiedztwa), az suma dystansow ostatnio zwiedzonych wezlow w obu
+    kierunkach osiagnie dlugosc najkrotszej znanej drogi laczacej oba
+    przeszukiwania; odnaleziona sciezka jest przepisywana do dziennika
+    obliczen, wiec odczytuje sie ja (wraz z dystansem) tak samo jak po
+    eksploracji grafu;
+  - eksploracja grafu wstecz (po odwroconej liscie sasiedztwa) wyznacza
+    dystanse dzielace wszystkie wezly od podanego wezla koncowego;
+  - zapytanie o zasieg (izochrone) konczy eksploracje grafu z chwila zdjecia
+    z kolejki wpisu o dystansie wiekszym niz podany zasieg - zwiedzone sa
+    wowczas dokladnie wezly w zasiegu, a ich Id zbierane sa w kolejnosci
+    zwiedzania (niemalejacych dystansow), wiec koszt zapytania zalezy od
+    ilosci wezlow w zasiegu, a nie od rzedu grafu; zapytanie obsluguja
+    silniki z kolejka priorytetowa (w miejsce maski bitowej i tablicy
+    przegladanej liniowo - kopiec binarny);
+  - zapytanie o k najblizszych wezlow docelowych (np. obiektow uslugowych)
+    konczy eksploracje grafu z chwila zwiedzenia k-tego wezla ze zbioru
+    docelowego (mapa bitowa, sprawdzana przy zwiedzaniu wezla) - zwiedzone
+    wezly docelowe sa najblizszymi, a ich Id zbierane sa w kolejnosci
+    niemalejacych dystansow;
+  - eksploracja z wielu wezlow zrodlowych naraz (dystanse zerowe wszystkich
+    wezlow zrodlowych w kolejce od startu) wyznacza w jednym przejsciu
+    dystans kazdego wezla od najblizszego wezla zrodlowego, a wezly
+    poprzedzajace tworza las najkrotszych sciezek; przydzial wezlow do
+    najblizszych wezlow zrodlowych (diagram Woronoja grafu) odczytuje sie
+    z tego lasu - kazdy wezel nalezy do wezla zrodlowego u korzenia swojego
+    drzewa, a regula wyboru wezla poprzedzajacego rozstrzyga tez remisy
+    pomiedzy wezlami zrodlowymi; ten sam las (i przydzial) wyznacza
+    rownolegle algorytm delta-stepping;
+  - gdy do wezla prowadzi kilka najkrotszych sciezek, wezlem poprzedzajacym
+    zostaje wezel o najmniejszym dystansie, a sposrod wezlow o rownym
+    dystansie - wezel o najmniejszym Id; drzewo najkrotszych sciezek nie
+    zalezy wiec od rodzaju kolejki priorytetowej (ani od kolejnosci obliczen
+    w silniku rownoleglym);
+  - gdy w dzienniku obliczen wskazano flagi krawedzi, wyszukiwanie sciezki
+    do wezla koncowego pomija krawedzie bez flagi jego komorki (zadna z nich
+    nie lezy na najkrotszej sciezce do wezla koncowego);
+  - gdy w dzienniku obliczen wskazano nakladke zmian grafu ("what-if"),
+    wagi krawedzi odczytywane sa przez nakladke (krawedz zamknieta albo
+    incydentna z wezlem zablokowanym jest pomijana); flagi krawedzi dotycza
+    wowczas innego grafu, wiec sa ignorowane, a przeszukiwanie wszerz
+    i tablice przegladana liniowo zastepuje kopiec binarny (silniki te
+    czytaja graf z pominieciem wag albo calymi wierszami macierzy);
+  - w dzienniku obliczen zapisuje sie statystyke (ilosc operacji porzadkowania
+    kolejki i ilosc zwiedzonych wezlow), pozwalajaca ocenic koszt ostatnich
+    obliczen.
 
   Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
 
 ---------------------------------------------------------------------------- */
 
+#include <cstring>
 #include "common.h"
 #include "dsp.h"
+#include "bfs.h"
 
 
 TJournal* initJournal(int length) {
@@ -32,14 +130,35 @@ TJournal* initJournal(int length) {
     // Alias na wielkosc dziennika
     const int &n = J->length;
 
-    // Alokacja listy wpisow dziennika, tj. ...
-    // ... najpierw tablica wskaznikow na wpisy, ...
-    J->entries = new TEntry*[n];
-    // ... nastepnie alokacja wszystkich wpisow
-    for (int i = 0; i < n; i++) {
-        J->entries[i] = new TEntry;
-        J->entries[i]->Id = i;
-    }
+    // Alokacja kolumn wpisow dziennika, tj. tablic dystansow, wezlow
+    // poprzedzajacych, mapy bitowej wezlow zwiedzonych ...
+    J->distance = new INT64[n];
+    J->prevId = new int[n];
+    J->visited = new UINT64[(n + 63) / 64];
+    for (int w = 0; w < (n + 63) / 64; w++)
+        J->visited[w] = 0;
+    // ... i tablicy epok (wpis z epoki zerowej jest nieaktualny)
+    J->epochs = new unsigned int[n];
+    for (int i = 0; i < n; i++)
+        J->epochs[i] = 0;
+    // Rozpoczecie pierwszej epoki obliczen
+    J->epoch = 1;
+    // Ustawienie domyslnego rodzaju kolejki priorytetowej
+    // i wyzerowanie statystyki obliczen
+    J->queue = qkBinaryHeap;
+    J->sifts = 0;
+    J->settled = 0;
+    // Dziennik pomocniczy pozostaje na razie niezainicjowany,
+    // a flagi krawedzi i nakladka zmian grafu - niewskazane
+    J->reverse = NULL;
+    J->flags = NULL;
+    J->overlay = NULL;
+    // Kolejki priorytetowe tworzone sa przy pierwszym uzyciu
+    J->heap = NULL;
+    J->quad = NULL;
+    J->pairing = NULL;
+    J->buckets = NULL;
+    J->radix = NULL;
 
     // Zwrocenie wskaznika na zainicjowany dziennik obliczen DSP
     return J;
@@ -51,16 +170,24 @@ void killJournal(TJournal* &J) {
     if (J == NULL)
         return;
 
-    // Alias na wielkosc dziennika
-    const int &n = J->length;
+    // Skasowanie dziennika pomocniczego (o ile zostal zainicjowany) ...
+    killJournal(J->reverse);
+    // ... i kolejek priorytetowych (o ile zostaly utworzone)
+    killQueue(J->heap);
+    killQueue(J->quad);
+    killQueue(J->pairing);
+    killQueue(J->buckets);
+    killQueue(J->radix);
 
-    // Skasowanie listy wpisow dziennika, tj. ...
-    for (int i = 0; i < n; i++)
-        // ... najpierw skasowanie wpisow, ...
-        delete J->entries[i];
-    // ... nastepnie skasowanie tablicy wskaznikow na wpisy
-    delete[] J->entries;
-    J->entries = NULL;
+    // Skasowanie kolumn wpisow dziennika
+    delete[] J->distance;
+    delete[] J->prevId;
+    delete[] J->visited;
+    delete[] J->epochs;
+    J->distance = NULL;
+    J->prevId = NULL;
+    J->visited = NULL;
+    J->epochs = NULL;
 
     // Skasowanie dziennika i zwrocenie przez parametr wyzerowanego wskaznika
     delete J;
@@ -68,71 +195,793 @@ void killJournal(TJournal* &J) {
 }
 
 
-TEntry* _clearEntry(TEntry *E) {
-    // Ustawienie danych poczatkowych w podanym wpisie, tj. ...
-    E->distance = 2147483647;  // ... dystans od wezla poczatkowego - nieznany
-    E->prevId = -1;            // ... Id wezla poprzedzajacego - nieznany
-    E->visited = false;        // ... status - nie zwiedzony
+#define DENSE_RATIO      16
+
 
-    // Zwrocenie wskaznika na ten wpis
-    return E;
+int chooseQueue(TGraph *G) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub graf nie ma modelu)
+    if (G == NULL || G->profile == NULL)
+        return qkBinaryHeap;
+
+    // Wybor maski bitowej dla grafow o niewielkiej ilosci wezlow
+    if (G->order <= BITSET_ORDER)
+        return qkBitset;
+
+    // Wybor tablicy przegladanej liniowo dla grafow gestych, tj. gdy
+    // ilosc krawedzi jest nie mniejsza niz n^2 / DENSE_RATIO
+    if (DENSE_RATIO * (INT64)G->profile[gpEdges] >= (INT64)G->order * G->order)
+        return qkArray;
+
+    // Wybor rodzaju kolejki priorytetowej na podstawie najwiekszej wagi
+    // krawedzi: dla niewielkich wag - kolejka kubelkowa Diala (o liczbie
+    // kubelkow rownej najwiekszej wadze + 1), w przeciwnym razie - kopiec
+    // pozycyjny (wagi krawedzi sa nieujemnymi liczbami calkowitymi)
+    if (G->profile[gpMaxWeight] <= DIAL_MAX_WEIGHT)
+        return qkBuckets;
+    else return qkRadix;
 }
 
-void exploreGraph(TJournal *J, TGraph *G, int startId) {
+
+#undef DENSE_RATIO
+
+
+void clearJournal(TJournal *J) {
     // Zakonczenie, gdy podany wskaznik jest pusty
-    if (J == NULL || G == NULL)
+    if (J == NULL)
         return;
 
+    // Rozpoczecie nowej epoki obliczen, tj. uniewaznienie wszystkich wpisow
+    // dziennika (dane poczatkowe, tzn. dystans i Id wezla poprzedzajacego
+    // nieznane, status - nie zwiedzony, ustawia we wpisie jego pierwszy
+    // odczyt w nowej epoce)
+    J->epoch++;
+
+    // Przy przepelnieniu licznika epok - wyzerowanie epok wszystkich wpisow
+    // (co 2^32 wyczyszczen dziennika) i rozpoczecie epoki pierwszej
+    if (J->epoch == 0) {
+        for (int i = 0; i < J->length; i++)
+            J->epochs[i] = 0;
+        J->epoch = 1;
+    }
+}
+
+
+void journalQueue(TJournal *J, TIndexHeap* &Q, int maxWeight) {
+    // Utworzenie kopca binarnego dziennika przy pierwszym uzyciu (kolejka
+    // oprozniana jest po kazdych obliczeniach, wiec nie wymaga przygotowania)
+    // i przekazanie go silnikowi obliczeniowemu
+    if (J->heap == NULL)
+        initQueue(J->heap, J->length, maxWeight);
+    Q = J->heap;
+}
+
+
+void journalQueue(TJournal *J, TQuadHeap* &Q, int maxWeight) {
+    // Utworzenie kopca 4-arnego dziennika przy pierwszym uzyciu
+    // i przekazanie go silnikowi obliczeniowemu
+    if (J->quad == NULL)
+        initQueue(J->quad, J->length, maxWeight);
+    Q = J->quad;
+}
+
+
+void journalQueue(TJournal *J, TPairingHeap* &Q, int maxWeight) {
+    // Utworzenie kopca parujacego dziennika przy pierwszym uzyciu
+    // i przekazanie go silnikowi obliczeniowemu
+    if (J->pairing == NULL)
+        initQueue(J->pairing, J->length, maxWeight);
+    Q = J->pairing;
+}
+
+
+void journalQueue(TJournal *J, TBucketQueue* &Q, int maxWeight) {
+    // Skasowanie kolejki kubelkowej dziennika, gdy ma za malo kubelkow dla
+    // podanej najwiekszej wagi krawedzi (nadmiar kubelkow nie przeszkadza -
+    // klucze w kolejce nadal trafiaja do roznych kubelkow), ...
+    if (J->buckets != NULL && J->buckets->count <= maxWeight)
+        killQueue(J->buckets);
+    // ... utworzenie jej (przy pierwszym uzyciu albo ponownie) ...
+    if (J->buckets == NULL)
+        initQueue(J->buckets, J->length, maxWeight);
+    // ... i przekazanie jej silnikowi obliczeniowemu
+    Q = J->buckets;
+}
+
+
+void journalQueue(TJournal *J, TRadixHeap* &Q, int maxWeight) {
+    // Utworzenie kopca pozycyjnego dziennika przy pierwszym uzyciu
+    // i przekazanie go silnikowi obliczeniowemu
+    if (J->radix == NULL)
+        initQueue(J->radix, J->length, maxWeight);
+    Q = J->radix;
+}
+
+
+template <typename TQueue>
+int _exploreGraph(TJournal *J, TGraph *G, int count, const int startIds[], int stopId,
+                  bool backward, INT64 range = -1, int Ids[] = NULL,
+                  const UINT64 *marks = NULL, int quota = -1) {
     // Alias na wielkosc dziennika
     const int &n = J->length;
 
-// *** Umieszczenie wpisow dziennika w kolejce priorytetowej ***
+// *** Umieszczenie wpisow startowych w kolejce priorytetowej ***
 
-    // Zainicjowanie kolejki ...
-    TEntry **Q = initQueue(n);
-    // ... wprowadzenie do kolejki wskaznikow na wpisy, 
-    // z ustawieniem w nich wartosci poczatkowych
-    for (int i = 0; i < n; i++)
-        enqueue(Q, _clearEntry(entry(J, i)));
+    // Ustawienie wartosci poczatkowych we wszystkich wpisach
+    clearJournal(J);
 
-// *** Analiza grafu z umieszczaniem wynikow w dzienniku obliczen DSP ***
+    // Przydzial kolejki wybranego rodzaju ...
+    TQueue *Q;
+    journalQueue(J, Q, maxArcWeight(J->overlay, G));
+    // ... i wprowadzenie do niej wpisow startowych z wyzerowanym dystansem
+    // (z pominieciem Id spoza zakresu i powtorzen; pozostale wpisy trafiaja
+    // do kolejki dopiero z chwila odkrycia drogi do ich wezlow)
+    for (int s = 0; s < count; s++) {
+        int startId = startIds[s];
+        if (startId < 0 || startId >= n || entryDistance(J, startId) == 0)
+            continue;
+        setDistance(J, startId, 0);
+        enqueue(Q, startId, 0);
+    }
+
+    // Flagi krawedzi (tylko przy wyszukiwaniu w przod do wezla koncowego,
+    // bez nakladki zmian grafu) i nakladka zmian grafu
+    TArcFlags *F = (! backward && stopId >= 0 && J->overlay == NULL) ? J->flags : NULL;
+    TOverlay *O = J->overlay;
 
-    // Wyzerowanie dystansu we wpisie zwiazanym w wezlem startowym
-    entry(J, startId)->distance = 0;
-    // Przesortowanie* kolejki wpisow (*tzn. przywrocenie struktury kopca binarnego)
-    queueSort(Q);
+// *** Analiza grafu z umieszczaniem wynikow w dzienniku obliczen DSP ***
 
+    J->settled = 0;
+    // Ilosc zebranych Id wezlow
+    int found = 0;
     // Tak dlugo jak w kolejce czekaja niegotowe wpisy, ...
     while (queueSize(Q) > 0) {
-        // ... odczyt Id wezla z czola kolejki priorytetowej ...
-        int currId = queueTop(Q)->Id;
-        // ... i dla kazdego wezla sasiadujacego z nim ...
-        for (int i = 0; i < nodeDegree(G, currId); i++) {
+        // ... zdjecie z czola kolejki priorytetowej wpisu o najmniejszym
+        // dystansie (dystans wiekszy niz zasieg, o ile go podano, konczy
+        // obliczenia - pozostale wpisy kolejki sa jeszcze dalsze) ...
+        int currId = dequeue(Q);
+        if (range >= 0 && entryDistance(J, currId) > range)
+            break;
+        // ... i oznaczenie statusu jako "zwiedzony" (z zebraniem Id wezla,
+        // o ile podano tablice wynikowa, a wezel nalezy do zbioru docelowego
+        // albo zbioru nie podano) ...
+        setVisited(J, currId, true);
+        J->settled++;
+        if (Ids != NULL && (marks == NULL || ((marks[currId >> 6] >> (currId & 63)) & 1)))
+            Ids[found++] = currId;
+        // ... (przy czym zwiedzenie wezla koncowego albo zebranie wymaganej
+        // ilosci wezlow konczy obliczenia, bo ich dystanse sa juz
+        // ostateczne) ...
+        if (currId == stopId || found == quota)
+            break;
+        // ... i dla kazdego wezla sasiadujacego z nim (w przod - nastepnikow,
+        // wstecz - poprzednikow) ...
+        int degree = backward ? nodeInDegree(G, currId) : nodeDegree(G, currId);
+        for (int i = 0; i < degree; i++) {
+            // ... (z pominieciem krawedzi bez flagi komorki wezla koncowego) ...
+            if (F != NULL && ! arcFlag(F, currId, i, stopId))
+                continue;
             // ... ustalenie indeksu wezla nastepnego, aby ...
-            int nextId = nodeNeighbour(G, currId, i)->Id;
+            int nextId = backward ? nodePredecessor(G, currId, i)->Id
+                                  : nodeNeighbour(G, currId, i)->Id;
             // ... o ile tamten wezel nie byl juz wczesniej zwiedzony, ...
-            if (! entry(J, nextId)->visited) {
+            if (! isVisited(J, nextId)) {
+                // ... (z pominieciem krawedzi zamknietych w nakladce) ...
+                int w = backward ? arcWeight(O, G, nextId, currId)
+                                 : arcWeight(O, G, currId, nextId);
+                if (w == 0)
+                    continue;
                 // ... ustalic jaki bylby laczny dystans wezla nastepnego
                 // od punktu startu (jako suma dystansu znanego w wezle biezacym
-                // i dlugosci krawedzi do nastepnego) ...
-                INT64 d = entry(J, currId)->distance + edgeWeight(G, currId, nextId);
+                // i dlugosci krawedzi do nastepnego, przechodzonej zgodnie
+                // z jej kierunkiem) ...
+                INT64 d = entryDistance(J, currId) + w;
                 // ... i sprawdzic czy dystans we wpisie zwiazanym z tamtym wezlem
                 // nie jest wiekszy niz ten, ktory wlasnie udalo sie ustalic, ...
-                if (entry(J, nextId)->distance > d) {
+                if (entryDistance(J, nextId) > d) {
                     // ... bo gdy droga krotsza -- ZAPIS ...
-                    entry(J, nextId)->distance = d;
-                    entry(J, nextId)->prevId = currId;
-                    // ... i przesortowanie kolejki wezlow
-                    queueSort(Q);
+                    setDistance(J, nextId, d);
+                    setPrev(J, nextId, currId);
+                    // ... i uaktualnienie pozycji wpisu w kolejce (albo
+                    // wprowadzenie go do kolejki, gdy wezel dopiero odkryto)
+                    requeue(Q, nextId, d);
                 }
+                // ... a gdy droga rowna, wezel biezacy ma rowny dystans
+                // z dotychczasowym wezlem poprzedzajacym i mniejsze Id --
+                // ZAPIS wezla poprzedzajacego (rozstrzygniecie remisu)
+                else if (entryDistance(J, nextId) == d
+                      && entryDistance(J, currId) == entryDistance(J, entryPrev(J, nextId))
+                      && currId < entryPrev(J, nextId))
+                    setPrev(J, nextId, currId);
+            }
+        }
+    }
+
+    // Zapamietanie statystyki obliczen ...
+    J->sifts = queueSifts(Q);
+    // ... i oproznienie kolejki priorytetowej (pozostaje w dzienniku)
+    clearQueue(Q);
+
+    // Zwrocenie ilosci zebranych Id wezlow
+    return found;
+}
+
+
+int _exploreQueue(TJournal *J, TGraph *G, int count, const int startIds[], int stopId,
+                  bool backward, INT64 range, int Ids[], const UINT64 *marks, int quota) {
+    // Rodzaj kolejki wybrany w dzienniku obliczen (kolejke kubelkowa
+    // zastepuje kopiec pozycyjny, gdy wagi krawedzi - z uwzglednieniem
+    // nakladki zmian grafu - sa dla niej zbyt duze)
+    int kind = J->queue;
+    if (kind == qkBuckets && maxArcWeight(J->overlay, G) > DIAL_MAX_WEIGHT)
+        kind = qkRadix;
+
+    // Uruchomienie silnika obliczeniowego z kolejka priorytetowa w/w rodzaju
+    // (w miejsce maski bitowej i tablicy przegladanej liniowo - kopiec
+    // binarny)
+    switch (kind) {
+        case qkQuadHeap    : return _exploreGraph<TQuadHeap>(J, G, count, startIds, stopId,
+                                                   backward, range, Ids, marks, quota);
+        case qkPairingHeap : return _exploreGraph<TPairingHeap>(J, G, count, startIds, stopId,
+                                                   backward, range, Ids, marks, quota);
+        case qkBuckets     : return _exploreGraph<TBucketQueue>(J, G, count, startIds, stopId,
+                                                   backward, range, Ids, marks, quota);
+        case qkRadix       : return _exploreGraph<TRadixHeap>(J, G, count, startIds, stopId,
+                                                   backward, range, Ids, marks, quota);
+        default            : return _exploreGraph<TIndexHeap>(J, G, count, startIds, stopId,
+                                                   backward, range, Ids, marks, quota);
+    }
+}
+
+
+inline int _lowestBit(UINT64 mask) {
+    // Zwrocenie numeru najmlodszego ustawionego bitu niepustej maski
+#if defined(__GNUC__)
+    return __builtin_ctzll(mask);
+#else
+    int i = 0;
+    while (! ((mask >> i) & 1))
+        i++;
+    return i;
+#endif
+}
+
+
+template <bool backward>
+void _exploreBitset(TJournal *J, TGraph *G, int startId, int stopId) {
+    // Alias na wielkosc dziennika
+    const int &n = J->length;
+
+    // Tablice robocze o stalej wielkosci (na stosie), tj. dystanse i Id
+    // wezlow poprzedzajacych, ...
+    INT64 dist[BITSET_ORDER];
+    int prev[BITSET_ORDER];
+    for (int i = 0; i < n; i++) {
+        dist[i] = 2147483647;
+        prev[i] = -1;
+    }
+    // ... oraz maski wezlow osiagnietych (niezwiedzonych) i zwiedzonych
+    UINT64 open = (UINT64)1 << startId;
+    UINT64 closed = 0;
+    dist[startId] = 0;
+
+    // Flagi krawedzi (tylko przy wyszukiwaniu w przod do wezla koncowego,
+    // bez nakladki zmian grafu) i nakladka zmian grafu
+    TArcFlags *F = (! backward && stopId >= 0 && J->overlay == NULL) ? J->flags : NULL;
+    TOverlay *O = J->overlay;
+
+    J->settled = 0;
+    // Tak dlugo jak sa wezly osiagniete, lecz niezwiedzone, ...
+    while (open != 0) {
+        // ... wybor wezla o najmniejszym dystansie (przy remisie - najmniejsze
+        // Id, bo bity przegladane sa rosnaco) ...
+        int currId = _lowestBit(open);
+        for (UINT64 rest = open & (open -1); rest != 0; rest &= rest -1) {
+            int i = _lowestBit(rest);
+            currId = (dist[i] < dist[currId]) ? i : currId;
+        }
+        // ... i oznaczenie go jako zwiedzonego ...
+        open &= ~((UINT64)1 << currId);
+        closed |= (UINT64)1 << currId;
+        J->settled++;
+        // ... (zwiedzenie wezla koncowego konczy obliczenia) ...
+        if (currId == stopId)
+            break;
+        // ... oraz relaksacja krawedzi do wezlow sasiednich (w przod -
+        // nastepnikow, wstecz - poprzednikow), z pominieciem zwiedzonych,
+        // krawedzi bez flagi komorki wezla koncowego i zamknietych w nakladce
+        int degree = backward ? nodeInDegree(G, currId) : nodeDegree(G, currId);
+        for (int i = 0; i < degree; i++) {
+            int nextId = backward ? G->revList[currId][i] : G->adjList[currId][i];
+            if ((closed >> nextId) & 1)
+                continue;
+            if (F != NULL && ! arcFlag(F, currId, i, stopId))
+                continue;
+            int w = backward ? arcWeight(O, G, nextId, currId)
+                             : arcWeight(O, G, currId, nextId);
+            if (w == 0)
+                continue;
+            INT64 d = dist[currId] + w;
+            // (gdy droga krotsza -- ZAPIS i dolaczenie wezla do osiagnietych)
+            if (d < dist[nextId]) {
+                dist[nextId] = d;
+                prev[nextId] = currId;
+                open |= (UINT64)1 << nextId;
+            }
+        }
+    }
+
+    // Przepisanie wynikow do dziennika obliczen
+    for (int i = 0; i < n; i++) {
+        setDistance(J, i, dist[i]);
+        setPrev(J, i, prev[i]);
+        setVisited(J, i, (closed >> i) & 1);
+    }
+    // Zapamietanie statystyki obliczen (ilosc przegladow maski)
+    J->sifts = J->settled;
+}
+
+
+#define UNREACHED  0x7ffffffe
+#define LOCKED     0x7fffffff
+
+// Wektor liczb 32-bitowych o szerokosci rejestru wektorowego platformy
+// docelowej (8 liczb - AVX2, w przeciwnym razie 4 liczby - SSE2, NEON)
+#if defined(__GNUC__)
+#if defined(__AVX2__)
+#define LANES  8
+#else
+#define LANES  4
+#endif
+typedef int TLanes __attribute__((vector_size(LANES * sizeof(int))));
+#endif
+
+
+bool _denseFits(TGraph *G) {
+    // Sprawdzenie czy dystans kazdej sciezki prostej miesci sie w tablicy
+    // roboczej silnika (liczby 32-bitowe, ponizej UNREACHED)
+    return (INT64)G->profile[gpMaxWeight] * (G->order -1) < UNREACHED;
+}
+
+
+void _exploreDense(TJournal *J, TGraph *G, int startId, int stopId) {
+    // Alias na wielkosc dziennika
+    const int &n = J->length;
+
+    // Tablice robocze silnika (ciagle, do obliczen wektorowych):
+    // key  - dystanse wezlow niezwiedzonych (LOCKED - wezel zwiedzony)
+    // lock - 0 dla wezla niezwiedzonego, LOCKED dla zwiedzonego
+    // prev - Id wezlow poprzedzajacych
+    int *key = new int[n];
+    int *lock = new int[n];
+    int *prev = new int[n];
+    for (int i = 0; i < n; i++) {
+        key[i] = UNREACHED;
+        lock[i] = 0;
+        prev[i] = -1;
+    }
+    // Wyzerowanie dystansu wezla startowego
+    key[startId] = 0;
+    int m = 0;
+
+    J->settled = 0;
+    // Tak dlugo jak najmniejszy dystans wsrod wezlow niezwiedzonych jest
+    // znany (pozostale wezly sa nieosiagalne), ...
+    while (m < UNREACHED) {
+        // ... wyszukanie pierwszego wezla o tym dystansie (przy remisie
+        // najmniejsze Id), ...
+        int currId = 0;
+        while (key[currId] != m)
+            currId++;
+
+        // ... zapis jego wpisu w dzienniku obliczen ...
+        setDistance(J, currId, m);
+        setPrev(J, currId, prev[currId]);
+        setVisited(J, currId, true);
+        J->settled++;
+        // ... i wykluczenie go z dalszych obliczen
+        key[currId] = LOCKED;
+        lock[currId] = LOCKED;
+        // (zwiedzenie wezla koncowego konczy obliczenia)
+        if (currId == stopId)
+            break;
+
+        // Relaksacja calego wiersza macierzy sasiedztwa wezla biezacego, tj.
+        // dla kazdego wezla - dystans przez wezel biezacy (LOCKED, gdy brak
+        // krawedzi albo wezel zwiedzony) i ZAPIS, gdy droga krotsza,
+        // polaczona z wyszukaniem najmniejszego dystansu (bez rozgalezien);
+        // waga krawedzi do wezla zwiedzonego jest pomijana jeszcze przed
+        // dodawaniem - droga przez wezel biezacy do wezla niezwiedzonego jest
+        // sciezka prosta, wiec jej dystans miesci sie w zakresie liczb int
+        // (zob. _denseFits), czego nie gwarantuje droga do wezla zwiedzonego
+        const int *row = G->adjMatrix[currId];
+        int d0 = m;
+        m = LOCKED;
+        int i = 0;
+#ifdef LANES
+        // ... po LANES wezlow naraz (obliczenia wektorowe), ...
+        TLanes vm = d0 - (TLanes){};
+        TLanes vId = currId - (TLanes){};
+        TLanes vMin = LOCKED - (TLanes){};
+        for (; i + LANES <= n; i += LANES) {
+            TLanes w, k, l, p;
+            memcpy(&w, row + i, sizeof(w));
+            memcpy(&k, key + i, sizeof(k));
+            memcpy(&l, lock + i, sizeof(l));
+            memcpy(&p, prev + i, sizeof(p));
+            w = (l == 0) ? w : 0;
+            TLanes d = (w != 0) ? vm + w : LOCKED - (TLanes){};
+            TLanes shorter = (d < k);
+            k = shorter ? d : k;
+            p = shorter ? vId : p;
+            vMin = (k < vMin) ? k : vMin;
+            memcpy(key + i, &k, sizeof(k));
+            memcpy(prev + i, &p, sizeof(p));
+        }
+        for (int a = 0; a < LANES; a++)
+            m = (vMin[a] < m) ? vMin[a] : m;
+#endif
+        // ... a dla pozostalych wezlow - pojedynczo
+        for (; i < n; i++) {
+            int w = (lock[i] == 0) ? row[i] : 0;
+            int d = (w != 0) ? d0 + w : LOCKED;
+            if (d < key[i]) {
+                key[i] = d;
+                prev[i] = currId;
             }
+            m = (key[i] < m) ? key[i] : m;
         }
-        // Zdjecie z kolejki biezacego wpisu i oznaczenie statusu jako "zwiedzony"
-        dequeue(Q)->visited = true;
     }
 
-    // Skasowanie kolejki priorytetowej przetworzonych wpisow
-    killQueue(Q);
+    // Zapis wynikow czastkowych wezlow niezwiedzonych w dzienniku obliczen
+    for (int i = 0; i < n; i++)
+        if (lock[i] == 0) {
+            setDistance(J, i, (key[i] == UNREACHED) ? 2147483647 : key[i]);
+            setPrev(J, i, prev[i]);
+            setVisited(J, i, false);
+        }
+
+    // Zapamietanie statystyki obliczen (ilosc przegladow tablicy dystansow)
+    J->sifts = J->settled;
+
+    // Skasowanie tablic roboczych
+    delete[] key;
+    delete[] lock;
+    delete[] prev;
+}
+
+
+#undef UNREACHED
+#undef LOCKED
+#undef LANES
+
+
+void _exploreGraph(TJournal *J, TGraph *G, int startId, int stopId, bool backward) {
+    // Przeszukiwanie wszerz w grafie niewazonym (o ile flagi krawedzi nie
+    // dotycza obliczen i nie wskazano nakladki zmian grafu)
+    if (G->profile[gpWeighted] == 0 && J->overlay == NULL
+                                    && (backward || stopId < 0 || J->flags == NULL)) {
+        exploreBFS(J, G, startId, stopId, backward);
+        return;
+    }
+
+    // Silnik maski bitowej (tylko grafy o niewielkiej ilosci wezlow;
+    // w przeciwnym razie - kopiec binarny)
+    if (J->queue == qkBitset) {
+        if (J->length > BITSET_ORDER)
+            _exploreGraph<TIndexHeap>(J, G, 1, &startId, stopId, backward);
+        else if (backward)
+             _exploreBitset<true>(J, G, startId, stopId);
+        else _exploreBitset<false>(J, G, startId, stopId);
+        return;
+    }
+
+    // Silnik tablicy przegladanej liniowo (tylko eksploracja w przod, bez
+    // flag krawedzi i nakladki zmian grafu; w przeciwnym razie - kopiec
+    // binarny)
+    if (J->queue == qkArray) {
+        if (! backward && (J->flags == NULL || stopId < 0) && J->overlay == NULL && _denseFits(G))
+             _exploreDense(J, G, startId, stopId);
+        else _exploreGraph<TIndexHeap>(J, G, 1, &startId, stopId, backward);
+        return;
+    }
+
+    // Uruchomienie silnika obliczeniowego z kolejka priorytetowa
+    // rodzaju wybranego w dzienniku obliczen
+    _exploreQueue(J, G, 1, &startId, stopId, backward, -1, NULL, NULL, -1);
+}
+
+
+void exploreGraph(TJournal *J, TGraph *G, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL)
+        return;
+
+    // Eksploracja grafu w przod (od wezla startowego)
+    _exploreGraph(J, G, startId, stopId, false);
+}
+
+
+void exploreGraph(TJournal *J, TGraph *G, int startId) {
+    // Eksploracja calego grafu (bez wezla koncowego)
+    exploreGraph(J, G, startId, -1);
+}
+
+
+void exploreReverse(TJournal *J, TGraph *G, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL)
+        return;
+
+    // Eksploracja calego grafu wstecz (od wezla koncowego, po odwroconej
+    // liscie sasiedztwa) - w dzienniku obliczen trafiaja dystanse dzielace
+    // wszystkie wezly od wezla koncowego, a wezly poprzedzajace wskazuja
+    // kolejne wezly na najkrotszych sciezkach do wezla koncowego
+    _exploreGraph(J, G, stopId, -1, true);
+}
+
+
+int exploreRange(TJournal *J, TGraph *G, int startId, INT64 range, int Ids[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL || Ids == NULL)
+        return -1;
+
+// Zaklada sie, ze dla podanej tablicy wynikowej przydzielono pamiec
+// w rozmiarze wystarczajacym do wpisania Id wszystkich wezlow w zasiegu.
+
+    // Przy ujemnym zasiegu zaden wezel (nawet startowy) nie jest w zasiegu
+    if (range < 0) {
+        clearJournal(J);
+        J->sifts = 0;
+        J->settled = 0;
+        return 0;
+    }
+
+    // Eksploracja grafu w przod do wyczerpania wezlow w zasiegu, silnikiem
+    // z kolejka priorytetowa rodzaju wybranego w dzienniku obliczen
+    // (zwrocenie ilosci wezlow w zasiegu, tj. zwiedzonych)
+    return _exploreQueue(J, G, 1, &startId, -1, false, range, Ids, NULL, -1);
+}
+
+
+int exploreNearest(TJournal *J, TGraph *G, int startId, int count, int targets[], int k, int Ids[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL || targets == NULL || Ids == NULL)
+        return -1;
+
+// Zaklada sie, ze dla podanej tablicy wynikowej przydzielono pamiec
+// w rozmiarze wystarczajacym do wpisania Id k wezlow.
+
+    // Alias na wielkosc dziennika
+    const int &n = J->length;
+
+    // Przy k < 1 nie ma czego szukac
+    if (k < 1) {
+        clearJournal(J);
+        J->sifts = 0;
+        J->settled = 0;
+        return 0;
+    }
+
+    // Mapa bitowa zbioru wezlow docelowych (z pominieciem Id spoza zakresu)
+    UINT64 *marks = new UINT64[(n + 63) / 64];
+    for (int w = 0; w < (n + 63) / 64; w++)
+        marks[w] = 0;
+    for (int i = 0; i < count; i++)
+        if (targets[i] >= 0 && targets[i] < n)
+            marks[targets[i] >> 6] |= (UINT64)1 << (targets[i] & 63);
+
+    // Eksploracja grafu w przod az do zwiedzenia k wezlow docelowych (albo
+    // wyczerpania wezlow osiagalnych), silnikiem z kolejka priorytetowa
+    // rodzaju wybranego w dzienniku obliczen
+    int found = _exploreQueue(J, G, 1, &startId, -1, false, -1, Ids, marks, k);
+
+    // Skasowanie mapy bitowej i zwrocenie ilosci odnalezionych wezlow
+    // docelowych (mniej niz k, gdy pozostale sa nieosiagalne)
+    delete[] marks;
+    return found;
+}
+
+
+void exploreSources(TJournal *J, TGraph *G, int count, int startIds[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL || startIds == NULL)
+        return;
+
+    // Eksploracja calego grafu w przod od wszystkich wezlow zrodlowych naraz,
+    // silnikiem z kolejka priorytetowa rodzaju wybranego w dzienniku obliczen
+    // (w dzienniku trafiaja dystanse od najblizszych wezlow zrodlowych i las
+    // najkrotszych sciezek)
+    _exploreQueue(J, G, count, startIds, -1, false, -1, NULL, NULL, -1);
+}
+
+
+int assignSources(TJournal *J, int count, int startIds[], int owner[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || startIds == NULL || owner == NULL)
+        return -1;
+
+// Zaklada sie, ze dziennik obliczen zawiera wyniki eksploracji calego grafu
+// z podanych wezlow zrodlowych, a dla tablicy wynikowej przydzielono pamiec
+// w rozmiarze rzedu grafu.
+
+    // Alias na wielkosc dziennika
+    const int &n = J->length;
+
+    // Wezly zrodlowe naleza do siebie samych (pozycja w tablicy wezlow
+    // zrodlowych; przy powtorzeniach - pierwsza), a przydzial pozostalych
+    // wezlow jest poczatkowo nieznany (-2)
+    for (int v = 0; v < n; v++)
+        owner[v] = -2;
+    for (int s = 0; s < count; s++) {
+        int startId = startIds[s];
+        if (startId >= 0 && startId < n && owner[startId] == -2)
+            owner[startId] = s;
+    }
+
+    // Stos wezlow sciezki do korzenia drzewa
+    int *stack = new int[n];
+    int reached = 0;
+    // Dla kazdego wezla ...
+    for (int v = 0; v < n; v++) {
+        // ... nieosiagalnego - brak przydzialu, ...
+        if (entryDistance(J, v) == 2147483647) {
+            owner[v] = -1;
+            continue;
+        }
+        reached++;
+        // ... a osiagalnego - przejscie po wezlach poprzedzajacych az do
+        // wezla o znanym przydziale (najdalej do korzenia drzewa) ...
+        int top = 0;
+        int u = v;
+        while (u >= 0 && owner[u] == -2) {
+            stack[top++] = u;
+            u = entryPrev(J, u);
+        }
+        // ... i przydzial tego samego wezla zrodlowego wszystkim wezlom
+        // na przebytej sciezce (-1, gdy korzen nie jest wezlem zrodlowym,
+        // tj. dziennik zawiera inne obliczenia)
+        int s = (u >= 0) ? owner[u] : -1;
+        while (top > 0)
+            owner[stack[--top]] = s;
+    }
+    delete[] stack;
+
+    // Zwrocenie ilosci wezlow osiagalnych z wezlow zrodlowych
+    return reached;
+}
+
+
+template <typename TQueue>
+void _exploreBidirectional(TJournal *J, TGraph *G, int startId, int stopId) {
+    // Alias na dziennik przeszukiwania wstecz i nakladke zmian grafu
+    TJournal *R = J->reverse;
+    TOverlay *O = J->overlay;
+
+// *** Umieszczenie wpisow startowych w kolejkach priorytetowych ***
+
+    // Ustawienie wartosci poczatkowych we wpisach obu dziennikow ...
+    clearJournal(J);
+    clearJournal(R);
+    // ... i wyzerowanie dystansow we wpisach wezla startowego i koncowego
+    setDistance(J, startId, 0);
+    setDistance(R, stopId, 0);
+
+    // Przydzial kolejek przeszukiwania w przod i wstecz (z dziennikow
+    // obu przeszukiwan) ...
+    TQueue *QF, *QR;
+    journalQueue(J, QF, maxArcWeight(O, G));
+    journalQueue(R, QR, maxArcWeight(O, G));
+    // ... i wprowadzenie do nich wpisow startowych
+    enqueue(QF, startId, 0);
+    enqueue(QR, stopId, 0);
+
+// *** Naprzemienna analiza grafu w przod i wstecz ***
+
+    // Najkrotsza znana droga laczaca oba przeszukiwania (mu) i wezel, w ktorym
+    // sie spotykaja (przy starcie w wezle koncowym - droga zerowa)
+    INT64 mu = (startId == stopId) ? 0 : 2147483647;
+    int meetId = (startId == stopId) ? startId : -1;
+    // Dystanse ostatnio zwiedzonych wezlow w obu kierunkach
+    INT64 lastF = 0;
+    INT64 lastR = 0;
+
+    J->settled = 0;
+    // Tak dlugo jak w obu kolejkach czekaja niegotowe wpisy
+    // i suma dystansow ostatnio zwiedzonych wezlow nie przekracza mu, ...
+    while (queueSize(QF) > 0 && queueSize(QR) > 0 && lastF + lastR < mu) {
+        // ... wybor kierunku o mniejszym promieniu przeszukiwania, ...
+        bool forward = (lastF <= lastR);
+        TJournal *X = forward ? J : R;
+        TJournal *Y = forward ? R : J;
+        TQueue *Q = forward ? QF : QR;
+        // ... zdjecie z czola kolejki wpisu o najmniejszym dystansie ...
+        int currId = dequeue(Q);
+        setVisited(X, currId, true);
+        J->settled++;
+        if (forward)
+             lastF = entryDistance(X, currId);
+        else lastR = entryDistance(X, currId);
+        // ... i dla kazdego wezla sasiadujacego z nim (w przod - nastepnikow,
+        // wstecz - poprzednikow) ...
+        int d = forward ? nodeDegree(G, currId) : nodeInDegree(G, currId);
+        for (int i = 0; i < d; i++) {
+            int nextId = forward ? G->adjList[currId][i] : G->revList[currId][i];
+            if (isVisited(X, nextId))
+                continue;
+            // ... ustalenie dystansu wezla nastepnego (krawedz przechodzona
+            // jest zgodnie ze swoim kierunkiem, z pominieciem krawedzi
+            // zamknietych w nakladce) ...
+            int w = forward ? arcWeight(O, G, currId, nextId)
+                            : arcWeight(O, G, nextId, currId);
+            if (w == 0)
+                continue;
+            INT64 dist = entryDistance(X, currId) + w;
+            // ... i gdy droga krotsza -- ZAPIS ...
+            if (entryDistance(X, nextId) > dist) {
+                setDistance(X, nextId, dist);
+                setPrev(X, nextId, currId);
+                requeue(Q, nextId, dist);
+                // ... ze sprawdzeniem, czy wezel osiagnelo juz przeszukiwanie
+                // z przeciwnego kierunku (wtedy znaleziono droge laczaca)
+                INT64 total = dist + entryDistance(Y, nextId);
+                if (total < mu) {
+                    mu = total;
+                    meetId = nextId;
+                }
+            }
+        }
+    }
+
+// *** Zlozenie najkrotszej sciezki w dzienniku obliczen ***
+
+    // Przepisanie do dziennika drogi wstecz od wezla spotkania do koncowego
+    // (z przestawieniem kierunku wskazan na wezly poprzedzajace), dzieki czemu
+    // najkrotsza sciezke i dystans mozna odczytac jak po eksploracji grafu
+    if (meetId != -1)
+        for (int currId = meetId; currId != stopId; ) {
+            int nextId = entryPrev(R, currId);
+            setDistance(J, nextId, entryDistance(J, currId) + arcWeight(O, G, currId, nextId));
+            setPrev(J, nextId, currId);
+            currId = nextId;
+        }
+
+    // Zapamietanie statystyki obliczen ...
+    J->sifts = queueSifts(QF) + queueSifts(QR);
+    // ... i oproznienie kolejek priorytetowych
+    clearQueue(QF);
+    clearQueue(QR);
+}
+
+
+void exploreBidirectional(TJournal *J, TGraph *G, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL)
+        return;
+
+    // Zainicjowanie (przy pierwszym uzyciu) dziennika przeszukiwania wstecz
+    if (J->reverse == NULL)
+        J->reverse = initJournal(J->length);
+
+    // Rodzaj kolejek wybrany w dzienniku obliczen (kolejke kubelkowa
+    // zastepuje kopiec pozycyjny, gdy wagi krawedzi - z uwzglednieniem
+    // nakladki zmian grafu - sa dla niej zbyt duze)
+    int kind = J->queue;
+    if (kind == qkBuckets && maxArcWeight(J->overlay, G) > DIAL_MAX_WEIGHT)
+        kind = qkRadix;
+
+    // Uruchomienie dwukierunkowego silnika obliczeniowego z kolejkami
+    // priorytetowymi w/w rodzaju
+    switch (kind) {
+        case qkQuadHeap    : _exploreBidirectional<TQuadHeap>(J, G, startId, stopId);
+                             break;
+        case qkPairingHeap : _exploreBidirectional<TPairingHeap>(J, G, startId, stopId);
+                             break;
+        case qkBuckets     : _exploreBidirectional<TBucketQueue>(J, G, startId, stopId);
+                             break;
+        case qkRadix       : _exploreBidirectional<TRadixHeap>(J, G, startId, stopId);
+                             break;
+        default            : _exploreBidirectional<TIndexHeap>(J, G, startId, stopId);
+    }
 }
 
 
@@ -150,7 +999,7 @@ int shortestPath(TJournal *J, int endId, int Ids[]) {
     int n = 0;
     do {
         Ids[n++] = currId;
-        currId = entry(J, currId)->prevId;
+        currId = entryPrev(J, currId);
     } while (currId != -1);
 
     // Odwrocenie kolejnosci elementow w tablicy wynikowej
@@ -172,5 +1021,5 @@ INT64 getDistance(TJournal *J, int endId) {
 
     // Zwrocenie dystansu dzielacego wezel koncowy o podanym Id
     // od wezla poczatkowego, z ktorego graf byl eksplorowany
-    return entry(J, endId)->distance;
+    return entryDistance(J, endId);
 }
@@ -3,12 +3,14 @@
 
 #include "common.h"
 #include "graph.h"
-#include "heap.h"
+#include "queue.h"
+#include "flags.h"
+#include "overlay.h"
 
 
 /*
-  Struktura definiujaca wpis do dziennika obliczen
-  We wpisie umieszcza sie jednostkowe wyniki obliczen DSP dla wezla
+  Struktura definiujaca wpis do dziennika obliczen (kopia jednostkowych
+  wynikow obliczen DSP dla wezla, odczytywana z dziennika funkcja entry)
   distance  - dystans dzielacy dany wezel od wezla startowego
   Id        - indeks wezla, ktorego dotyczy wpis
   prevId    - indeks wezla, ktory w najkrotszej sciezce poprzedza w/w wezel
@@ -16,7 +18,6 @@
 */
 struct TEntry {
     INT64 distance;
-//---
     int Id;
     int prevId;
     bool visited;
@@ -25,81 +26,143 @@ struct TEntry {
 
 /*
   Struktura definiujaca dziennik obliczen DSP (Dijkstra Shortest Path)
+  Wpisy dziennika przechowywane sa kolumnami (osobna tablica dla kazdego pola
+  wpisu, indeksowana Id wezla), a odczytuje i zapisuje sie je wylacznie
+  funkcjami dostepu
   length    - ilosc wpisow dziennika
-  entries   - lista wpisow, tj. n-elementowa tablica dynamiczna, przechowujaca
-              wskazniki wszystkich wpisow dziennika
+  distance  - n-elementowa tablica dystansow dzielacych wezly od wezla
+              startowego
+  prevId    - n-elementowa tablica indeksow wezlow poprzedzajacych w/w wezly
+              w najkrotszych sciezkach
+  visited   - mapa bitowa wezlow zwiedzonych (po 64 wezly w slowie)
+  epochs    - n-elementowa tablica epok obliczen, w ktorych wpisy byly ostatnio
+              zapisane (wpis z epoki innej niz biezaca epoka dziennika jest
+              nieaktualny, tj. wezel jest nieosiagniety i niezwiedzony)
+  epoch     - biezaca epoka obliczen (wyczyszczenie dziennika rozpoczyna nowa
+              epoke, nie zmieniajac zadnego wpisu)
+  queue     - rodzaj kolejki priorytetowej uzywanej w obliczeniach (EQueueKind)
+  sifts     - statystyka: ilosc operacji porzadkowania kolejki priorytetowej
+              w ostatnich obliczeniach
+  settled   - statystyka: ilosc wezlow zwiedzonych w ostatnich obliczeniach
+  reverse   - pomocniczy dziennik obliczen przeszukiwania grafu wstecz (od wezla
+              koncowego), tworzony przy pierwszym wyszukiwaniu dwukierunkowym
+  flags     - flagi krawedzi, wg ktorych wyszukiwanie sciezki do wezla
+              koncowego pomija krawedzie (NULL - bez flag; dziennik nie jest
+              ich wlascicielem)
+  overlay   - nakladka zmian grafu ("what-if") uwzgledniana przy relaksacji
+              krawedzi (NULL - bez nakladki; dziennik nie jest jej
+              wlascicielem)
+  heap, quad, pairing, buckets, radix
+            - kolejki priorytetowe dziennika (po jednej kazdego rodzaju),
+              tworzone przy pierwszych obliczeniach z kolejka danego rodzaju
+              i uzywane ponownie w kolejnych obliczeniach (NULL - jeszcze
+              nieutworzona)
 */
 struct TJournal {
     int length;
-    TEntry **entries;
+    INT64 *distance;
+    int *prevId;
+    UINT64 *visited;
+    unsigned int *epochs;
+    unsigned int epoch;
+    int queue;
+    INT64 sifts;
+    int settled;
+    TJournal *reverse;
+    TArcFlags *flags;
+    TOverlay *overlay;
+    TIndexHeap *heap;
+    TQuadHeap *quad;
+    TPairingHeap *pairing;
+    TBucketQueue *buckets;
+    TRadixHeap *radix;
 };
 
 
-// *** Otoczki typowych funkcji kopca binarnego
-//   - implementacja priorytetowej kolejki wpisow dziennika ***
+// *** Funkcje dziennika obliczen DSP (Dijkstra Shortest Path) ***
 
 
-inline TEntry** initQueue(int n) {
-    // Zainicjowanie kolejki priorytetowej
-    return (TEntry**)initHeap(n);
+inline void touchEntry(TJournal *J, int Id) {
+    // Ustawienie danych poczatkowych we wpisie o podanym Id, gdy wpis jest
+    // nieaktualny (z poprzedniej epoki obliczen), tj. dystans i Id wezla
+    // poprzedzajacego - nieznane, status - nie zwiedzony
+    if (J->epochs[Id] != J->epoch) {
+        J->distance[Id] = 2147483647;
+        J->prevId[Id] = -1;
+        J->visited[Id >> 6] &= ~((UINT64)1 << (Id & 63));
+        J->epochs[Id] = J->epoch;
+    }
 }
 
-inline void killQueue(TEntry* Q[]) {
-    // Skasowanie kolejki priorytetowej
-    killHeap((INT64**)Q);
+inline INT64 entryDistance(TJournal *J, int Id) {
+    // Zwrocenie dystansu zapisanego we wpisie o podanym Id
+    // (2147483647 - dystans nieznany)
+    return (J->epochs[Id] == J->epoch) ? J->distance[Id] : 2147483647;
 }
 
-inline int queueSize(TEntry* Q[]) {
-    // Zwrocenie ilosci elementow w kolejce priorytetowej
-    return heapSize((INT64**)Q);
+inline int entryPrev(TJournal *J, int Id) {
+    // Zwrocenie Id wezla poprzedzajacego zapisanego we wpisie o podanym Id
+    // (-1 - brak)
+    return (J->epochs[Id] == J->epoch) ? J->prevId[Id] : -1;
 }
 
-inline void queueSize(TEntry* Q[], int n) {
-    // Ustawienie ilosci elementow w kolejce priorytetowej
-    heapSize((INT64**)Q, n);
+inline bool isVisited(TJournal *J, int Id) {
+    // Zwrocenie wartosci logicznej czy wezel o podanym Id zostal zwiedzony
+    return (J->epochs[Id] == J->epoch) && ((J->visited[Id >> 6] >> (Id & 63)) & 1);
 }
 
-inline TEntry* queueTop(TEntry* Q[]) {
-    // O ile kolejka jest niepusta, ...
-    if (queueSize(Q) > 0)
-        // ... zwrocenie znajdujacego sie na czele kolejki wskaznika na wpis
-        return Q[1];
-    // ... w przeciwnym razie zwrocenie adresu pustego
-    else return NULL;
+inline void setDistance(TJournal *J, int Id, INT64 distance) {
+    // Zapis dystansu we wpisie o podanym Id
+    touchEntry(J, Id);
+    J->distance[Id] = distance;
 }
 
-inline void queueSort(TEntry* Q[]) {
-    // Przesortowanie kolejki priorytetowej
-    // (na czele kolejki wpis z minimalna wartoscia pola INT64*)
-    buildHeap((INT64**)Q);
+inline void setPrev(TJournal *J, int Id, int prevId) {
+    // Zapis Id wezla poprzedzajacego we wpisie o podanym Id
+    touchEntry(J, Id);
+    J->prevId[Id] = prevId;
 }
 
-inline void enqueue(TEntry* Q[], TEntry *item) {
-    // Wprowadzenie do kolejki priorytetowej wskaznika na wpis
-    heapPush((INT64**)Q, (INT64*)item);
+inline void setVisited(TJournal *J, int Id, bool visited) {
+    // Zapis statusu wezla o podanym Id (zwiedzony albo nie)
+    touchEntry(J, Id);
+    if (visited)
+         J->visited[Id >> 6] |= (UINT64)1 << (Id & 63);
+    else J->visited[Id >> 6] &= ~((UINT64)1 << (Id & 63));
 }
 
-inline TEntry* dequeue(TEntry* Q[]) {
-    // Zdjecie znajdujacego sie na czele kolejki wskaznika na wpis
-    // i zwrocenie tego wskaznika
-    return (TEntry*)heapPop((INT64**)Q);
-}
-
-
-// *** Funkcje dziennika obliczen DSP (Dijkstra Shortest Path) ***
-
-
-inline TEntry* entry(TJournal *J, int Id) {
-    // Wybor z listy wpisow wskaznika na wpis o podanym Id
-    // i zwrocenie tego wskaznika
-    return J->entries[Id];
+inline TEntry entry(TJournal *J, int Id) {
+    // Zlozenie kopii wpisu o podanym Id z pol przechowywanych w dzienniku
+    // i zwrocenie tej kopii
+    TEntry E;
+    E.distance = entryDistance(J, Id);
+    E.Id = Id;
+    E.prevId = entryPrev(J, Id);
+    E.visited = isVisited(J, Id);
+    return E;
 }
 
 
 TJournal* initJournal(int length);
 void killJournal(TJournal* &J);
 
+int chooseQueue(TGraph *G);
+void clearJournal(TJournal *J);
+
+void journalQueue(TJournal *J, TIndexHeap* &Q, int maxWeight);
+void journalQueue(TJournal *J, TQuadHeap* &Q, int maxWeight);
+void journalQueue(TJournal *J, TPairingHeap* &Q, int maxWeight);
+void journalQueue(TJournal *J, TBucketQueue* &Q, int maxWeight);
+void journalQueue(TJournal *J, TRadixHeap* &Q, int maxWeight);
+
 void exploreGraph(TJournal *J, TGraph *G, int startId);
+void exploreGraph(TJournal *J, TGraph *G, int startId, int stopId);
+void exploreReverse(TJournal *J, TGraph *G, int stopId);
+void exploreBidirectional(TJournal *J, TGraph *G, int startId, int stopId);
+int exploreRange(TJournal *J, TGraph *G, int startId, INT64 range, int Ids[]);
+int exploreNearest(TJournal *J, TGraph *G, int startId, int count, int targets[], int k, int Ids[]);
+void exploreSources(TJournal *J, TGraph *G, int count, int startIds[]);
+int assignSources(TJournal *J, int count, int startIds[], int owner[]);
 int shortestPath(TJournal *J, int endId, int Ids[]);
 INT64 getDistance(TJournal *J, int endId);
 
@@ -0,0 +1,416 @@
+/* ----------------------------------------------------------------------------
+
+  TWeightUpdate - zmiany wag krawedzi i naprawa dziennika obliczen DSP
+  (dynamiczne najkrotsze sciezki, w stylu algorytmu Ramalingama-Repsa)
+
+  UWAGI:
+  - zmiany wag wprowadzane sa do grafu pakietami; w grafie nieskierowanym
+    zmiana dotyczy krawedzi w obu kierunkach przejscia (graf pozostaje
+    nieskierowany); zmiany bledne (Id spoza zakresu, petle, wagi ujemne)
+    sa pomijane;
+  - zmiana wagi istniejacej krawedzi uaktualnia model grafu bez jego
+    przebudowy, natomiast dodanie lub usuniecie krawedzi - przebudowuje model
+    (raz dla calego pakietu zmian); srednia waga krawedzi (od ktorej zalezy
+    szerokosc kubelka algorytmu delta-stepping) uaktualniana jest przyrostowo
+    przy kazdej zmianie wagi, a najwieksza waga krawedzi (od ktorej zalezy
+    m.in. wybor kolejki priorytetowej) - jest ograniczeniem gornym, az do
+    przebudowy modelu;
+  - naprawiany dziennik obliczen musi zawierac wyniki pelnej eksploracji
+    grafu (bez wezla koncowego) z podanego wezla startowego, sprzed zmian;
+  - naprawa przebiega w trzech etapach:
+    1) krawedzie drzewa najkrotszych sciezek, ktorych waga wzrosla (lub
+       ktore usunieto), uniewazniaja poddrzewa swoich wezlow koncowych -
+       wezly tych poddrzew otrzymuja dystanse wyznaczone z sasiadow spoza
+       poddrzew (lub nieznane), a pozostale dystanse nie zmieniaja sie;
+    2) krawedzie, ktorych waga zmalala (lub ktore dodano), skracaja dystanse
+       swoich wezlow koncowych;
+    3) wezly o zmienionych dystansach przetwarzane sa algorytmem Dijkstry,
+       a propagacja zatrzymuje sie na wezlach, ktorych dystans sie nie
+       zmienia;
+    na koniec wezly poprzedzajace (wg reguly silnika sekwencyjnego: najmniejszy
+    dystans, a przy remisie najmniejsze Id) wyznacza sie ponownie jedynie dla
+    wezlow o zmienionych dystansach, ich nastepnikow i wezlow koncowych
+    zmienionych krawedzi - dziennik jest wiec identyczny z wynikami ponownej
+    eksploracji grafu, a koszt naprawy zalezy od wielkosci obszaru objetego
+    zmianami, nie od rzedu grafu;
+  - w dzienniku obliczen zapisuje sie statystyke naprawy (ilosc operacji
+    porzadkowania kolejki i ilosc zwiedzonych wezlow).
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+#include "dynamic.h"
+
+
+#define INF  2147483647
+
+
+/*
+  Struktura pomocnicza - lista Id wezlow (tablica powiekszana w miare
+  potrzeb)
+  count     - ilosc Id na liscie
+  size      - pojemnosc tablicy
+  Ids       - tablica Id wezlow
+*/
+struct TIdList {
+    int count;
+    int size;
+    int *Ids;
+};
+
+
+/*
+  Struktura pomocnicza - kopiec binarny par (dystans, Id wezla) bez mapy
+  pozycji, tj. z leniwym usuwaniem: skrocenie dystansu wprowadza do kopca
+  nowa pare, a para o dystansie wiekszym niz w dzienniku jest nieaktualna
+  size      - ilosc par w kopcu
+  capacity  - pojemnosc tablic kopca
+  keys      - tablica dystansow (kluczy)
+  Ids       - tablica Id wezlow
+  sifts     - licznik operacji przesiewania
+*/
+struct TRepairHeap {
+    int size;
+    int capacity;
+    INT64 *keys;
+    int *Ids;
+    INT64 sifts;
+};
+
+
+void _initIds(TIdList &L) {
+    // Zainicjowanie pustej listy (bez przydzialu pamieci)
+    L.count = 0;
+    L.size = 0;
+    L.Ids = NULL;
+}
+
+
+void _killIds(TIdList &L) {
+    // Skasowanie tablicy listy
+    delete[] L.Ids;
+    _initIds(L);
+}
+
+
+void _appendId(TIdList &L, int Id) {
+    // Powiekszenie (dwukrotne) tablicy listy, gdy jest zapelniona
+    if (L.count == L.size) {
+        int size = (L.size > 0) ? 2 * L.size : 16;
+        int *Ids = new int[size];
+        for (int i = 0; i < L.count; i++)
+            Ids[i] = L.Ids[i];
+        delete[] L.Ids;
+        L.Ids = Ids;
+        L.size = size;
+    }
+    // Dopisanie Id na koncu listy
+    L.Ids[L.count++] = Id;
+}
+
+
+void _repairPush(TRepairHeap &Q, int Id, INT64 key) {
+    // Powiekszenie (dwukrotne) tablic kopca, gdy sa zapelnione
+    if (Q.size == Q.capacity) {
+        int capacity = (Q.capacity > 0) ? 2 * Q.capacity : 16;
+        INT64 *keys = new INT64[capacity];
+        int *Ids = new int[capacity];
+        for (int i = 0; i < Q.size; i++) {
+            keys[i] = Q.keys[i];
+            Ids[i] = Q.Ids[i];
+        }
+        delete[] Q.keys;
+        delete[] Q.Ids;
+        Q.keys = keys;
+        Q.Ids = Ids;
+        Q.capacity = capacity;
+    }
+    // Przesianie nowej pary w gore kopca (od konca tablicy)
+    int i = Q.size++;
+    while (i > 0 && Q.keys[(i -1) / 2] > key) {
+        Q.keys[i] = Q.keys[(i -1) / 2];
+        Q.Ids[i] = Q.Ids[(i -1) / 2];
+        i = (i -1) / 2;
+        Q.sifts++;
+    }
+    Q.keys[i] = key;
+    Q.Ids[i] = Id;
+}
+
+
+int _repairPop(TRepairHeap &Q, INT64 &key) {
+    // Zdjecie pary ze szczytu kopca ...
+    int Id = Q.Ids[0];
+    key = Q.keys[0];
+    // ... i przesianie ostatniej pary w dol kopca (od szczytu)
+    Q.size--;
+    INT64 k = Q.keys[Q.size];
+    int x = Q.Ids[Q.size];
+    int i = 0;
+    while (2 * i +1 < Q.size) {
+        int c = 2 * i +1;
+        if (c +1 < Q.size && Q.keys[c +1] < Q.keys[c])
+            c++;
+        if (Q.keys[c] >= k)
+            break;
+        Q.keys[i] = Q.keys[c];
+        Q.Ids[i] = Q.Ids[c];
+        i = c;
+        Q.sifts++;
+    }
+    Q.keys[i] = k;
+    Q.Ids[i] = x;
+    return Id;
+}
+
+
+int _applyUpdates(TGraph *G, int count, TWeightUpdate updates[], TWeightUpdate* &arcs, int* &olds) {
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // W grafie nieskierowanym zmiana dotyczy obu kierunkow przejscia
+    bool mirror = (G->profile[gpDirected] == 0);
+
+    // Alokacja listy zmienionych lukow (krawedzi w kierunku przejscia) i ich
+    // wag sprzed zmiany
+    arcs = new TWeightUpdate[mirror ? 2 * count : count];
+    olds = new int[mirror ? 2 * count : count];
+
+    int m = 0;
+    bool rebuild = false;
+    // Dla kazdej zmiany wagi ...
+    for (int k = 0; k < count; k++) {
+        TWeightUpdate &U = updates[k];
+        // ... (z pominieciem zmian blednych) ...
+        if (U.startId < 0 || U.startId >= n || U.stopId < 0 || U.stopId >= n
+         || U.startId == U.stopId || U.weight < 0)
+            continue;
+        // ... i dla kazdego z kierunkow przejscia ...
+        for (int dir = 0; dir < (mirror ? 2 : 1); dir++) {
+            int u = (dir == 0) ? U.startId : U.stopId;
+            int v = (dir == 0) ? U.stopId : U.startId;
+            // ... (o ile waga rzeczywiscie sie zmienia) ...
+            int old = G->adjMatrix[u][v];
+            if (old == U.weight)
+                continue;
+            // ... zapamietanie luku i jego wagi sprzed zmiany ...
+            arcs[m].startId = u;
+            arcs[m].stopId = v;
+            arcs[m].weight = U.weight;
+            olds[m++] = old;
+            // ... oraz wprowadzenie zmiany do grafu (dodanie lub usuniecie
+            // krawedzi - tylko w macierzy sasiedztwa, z przebudowa modelu
+            // po wprowadzeniu calego pakietu zmian)
+            if (old == 0 || U.weight == 0) {
+                G->adjMatrix[u][v] = U.weight;
+                rebuild = true;
+            }
+            else changeWeight(G, u, v, U.weight);
+        }
+    }
+    // Przebudowa modelu po dodaniu lub usunieciu krawedzi
+    if (rebuild)
+        rebuildModel(G);
+
+    // Zwrocenie ilosci zmienionych lukow
+    return m;
+}
+
+
+void updateGraph(TGraph *G, int count, TWeightUpdate updates[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL || updates == NULL)
+        return;
+
+    // Wprowadzenie zmian do grafu (bez naprawy dziennika obliczen)
+    TWeightUpdate *arcs;
+    int *olds;
+    _applyUpdates(G, count, updates, arcs, olds);
+    delete[] arcs;
+    delete[] olds;
+}
+
+
+void _resetEntry(TJournal *J, int Id, TIdList &L) {
+    // Uniewaznienie wpisu (dystans i wezel poprzedzajacy nieznane, status -
+    // nie zwiedzony) i dopisanie wezla do listy
+    setDistance(J, Id, INF);
+    setPrev(J, Id, -1);
+    setVisited(J, Id, false);
+    _appendId(L, Id);
+}
+
+
+void _resetSubtree(TJournal *J, TGraph *G, int rootId, TIdList &L) {
+    // Uniewaznienie wpisu korzenia poddrzewa, ...
+    int first = L.count;
+    _resetEntry(J, rootId, L);
+    // ... a nastepnie (przejsciem wszerz) wpisow wszystkich jego potomkow
+    // w drzewie najkrotszych sciezek, tj. nastepnikow wskazujacych wezel
+    // biezacy jako poprzedzajacy
+    for (int i = first; i < L.count; i++) {
+        int currId = L.Ids[i];
+        for (int a = 0; a < nodeDegree(G, currId); a++) {
+            int nextId = G->adjList[currId][a];
+            if (entryPrev(J, nextId) == currId)
+                _resetEntry(J, nextId, L);
+        }
+    }
+}
+
+
+void _repairPrev(TJournal *J, TGraph *G, int startId, int Id) {
+    // Pominiecie wezla startowego (nie ma wezla poprzedzajacego)
+    if (Id == startId)
+        return;
+
+    // Wezel nieosiagalny nie ma wezla poprzedzajacego i nie jest zwiedzony
+    INT64 d = entryDistance(J, Id);
+    if (d == INF) {
+        setPrev(J, Id, -1);
+        setVisited(J, Id, false);
+        return;
+    }
+    // Wybor wezla poprzedzajacego wg reguly silnika sekwencyjnego, tj.
+    // sposrod poprzednikow na najkrotszych sciezkach - o najmniejszym
+    // dystansie, a przy remisie o najmniejszym Id
+    int prevId = -1;
+    for (int a = 0; a < nodeInDegree(G, Id); a++) {
+        int u = G->revList[Id][a];
+        INT64 du = entryDistance(J, u);
+        if (du == INF || du + edgeWeight(G, u, Id) != d)
+            continue;
+        if (prevId == -1 || du < entryDistance(J, prevId)
+         || (du == entryDistance(J, prevId) && u < prevId))
+            prevId = u;
+    }
+    setPrev(J, Id, prevId);
+    setVisited(J, Id, true);
+}
+
+
+int repairJournal(TJournal *J, TGraph *G, int startId, int count, TWeightUpdate updates[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (J == NULL || G == NULL || updates == NULL)
+        return -1;
+
+    // Wprowadzenie zmian do grafu (z zapamietaniem zmienionych lukow i ich
+    // wag sprzed zmiany)
+    TWeightUpdate *arcs;
+    int *olds;
+    int m = _applyUpdates(G, count, updates, arcs, olds);
+
+    // Listy wezlow uniewaznionych (etap 1.) i o skroconych dystansach
+    // (etapy 2. i 3.) oraz kopiec wezlow do przetworzenia
+    TIdList reset, shorter;
+    _initIds(reset);
+    _initIds(shorter);
+    TRepairHeap Q;
+    Q.size = Q.capacity = 0;
+    Q.keys = NULL;
+    Q.Ids = NULL;
+    Q.sifts = 0;
+
+// *** Etap 1. - uniewaznienie poddrzew krawedzi drzewa o wiekszej wadze ***
+
+    for (int k = 0; k < m; k++)
+        if ((arcs[k].weight == 0 || arcs[k].weight > olds[k])
+         && entryPrev(J, arcs[k].stopId) == arcs[k].startId)
+            _resetSubtree(J, G, arcs[k].stopId, reset);
+
+    // Wyznaczenie dystansow wezlow uniewaznionych z ich poprzednikow spoza
+    // uniewaznionych poddrzew (wezly uniewaznione maja dystans nieznany)
+    for (int i = 0; i < reset.count; i++) {
+        int v = reset.Ids[i];
+        INT64 d = INF;
+        for (int a = 0; a < nodeInDegree(G, v); a++) {
+            int u = G->revList[v][a];
+            if (entryDistance(J, u) != INF && entryDistance(J, u) + edgeWeight(G, u, v) < d)
+                d = entryDistance(J, u) + edgeWeight(G, u, v);
+        }
+        if (d != INF) {
+            setDistance(J, v, d);
+            _repairPush(Q, v, d);
+        }
+    }
+
+// *** Etap 2. - skrocenie dystansow przez krawedzie o mniejszej wadze ***
+
+    for (int k = 0; k < m; k++) {
+        int u = arcs[k].startId;
+        int v = arcs[k].stopId;
+        // (waga luku po wprowadzeniu calego pakietu zmian)
+        int w = edgeWeight(G, u, v);
+        if (w > 0 && entryDistance(J, u) != INF && entryDistance(J, u) + w < entryDistance(J, v)) {
+            setDistance(J, v, entryDistance(J, u) + w);
+            setVisited(J, v, false);
+            _repairPush(Q, v, entryDistance(J, v));
+            _appendId(shorter, v);
+        }
+    }
+
+// *** Etap 3. - propagacja zmian algorytmem Dijkstry ***
+
+    J->settled = 0;
+    // Tak dlugo jak w kopcu sa wezly do przetworzenia, ...
+    while (Q.size > 0) {
+        // ... zdjecie wezla o najmniejszym dystansie (z pominieciem par
+        // nieaktualnych) ...
+        INT64 d;
+        int currId = _repairPop(Q, d);
+        if (d != entryDistance(J, currId))
+            continue;
+        setVisited(J, currId, true);
+        J->settled++;
+        // ... i skrocenie dystansow nastepnikow, o ile droga przez wezel
+        // biezacy jest krotsza (w przeciwnym razie propagacja zatrzymuje sie)
+        for (int a = 0; a < nodeDegree(G, currId); a++) {
+            int nextId = G->adjList[currId][a];
+            INT64 dist = d + edgeWeight(G, currId, nextId);
+            if (dist < entryDistance(J, nextId)) {
+                setDistance(J, nextId, dist);
+                setVisited(J, nextId, false);
+                _repairPush(Q, nextId, dist);
+                _appendId(shorter, nextId);
+            }
+        }
+    }
+
+// *** Wyznaczenie wezlow poprzedzajacych w obszarze zmian ***
+
+    // Wezly uniewaznione i o skroconych dystansach oraz ich nastepniki, ...
+    for (int pass = 0; pass < 2; pass++) {
+        TIdList &L = (pass == 0) ? reset : shorter;
+        for (int i = 0; i < L.count; i++) {
+            int currId = L.Ids[i];
+            _repairPrev(J, G, startId, currId);
+            for (int a = 0; a < nodeDegree(G, currId); a++)
+                _repairPrev(J, G, startId, G->adjList[currId][a]);
+        }
+    }
+    // ... a takze wezly koncowe zmienionych lukow
+    for (int k = 0; k < m; k++)
+        _repairPrev(J, G, startId, arcs[k].stopId);
+
+    // Zapamietanie statystyki obliczen
+    J->sifts = Q.sifts;
+    int affected = reset.count;
+
+    // Skasowanie struktur roboczych
+    delete[] Q.keys;
+    delete[] Q.Ids;
+    _killIds(reset);
+    _killIds(shorter);
+    delete[] arcs;
+    delete[] olds;
+
+    // Zwrocenie ilosci wpisow uniewaznionych w etapie 1.
+    return affected;
+}
+
+
+#undef INF
@@ -0,0 +1,27 @@
+#ifndef AC_ENGINE_DYNAMIC_H
+#define AC_ENGINE_DYNAMIC_H
+
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+
+
+/*
+  Struktura definiujaca zmiane wagi krawedzi
+  startId   - indeks wezla poczatkowego krawedzi
+  stopId    - indeks wezla koncowego krawedzi
+  weight    - nowa waga krawedzi (0 - usuniecie krawedzi; waga dodatnia
+              krawedzi nieistniejacej - dodanie krawedzi)
+*/
+struct TWeightUpdate {
+    int startId;
+    int stopId;
+    int weight;
+};
+
+
+void updateGraph(TGraph *G, int count, TWeightUpdate updates[]);
+int repairJournal(TJournal *J, TGraph *G, int startId, int count, TWeightUpdate updates[]);
+
+
+#endif // AC_ENGINE_DYNAMIC_H
@@ -0,0 +1,259 @@
+/* ----------------------------------------------------------------------------
+
+  TArcFlags - flagi krawedzi (ang. arc flags) z podzialem grafu na komorki
+
+  UWAGI:
+  - graf dzielony jest na k komorek metoda przeszukiwania wszerz: komorka
+    "rosnie" od wezla o najmniejszym Id sposrod nieprzydzielonych, przejmujac
+    kolejne wezly sasiednie (bez wzgledu na kierunek krawedzi), az osiagnie
+    rozmiar n/k (zaokraglony w gore); gdy przeszukiwanie wyczerpie skladowa,
+    komorka rosnie dalej od kolejnego nieprzydzielonego wezla;
+  - kazda krawedz ma slowo 64-bitowe flag (po bicie na komorke), zapisane
+    rownolegle do listy sasiedztwa - koszt pamieci wynosi zatem dokladnie
+    8 bajtow na krawedz;
+  - flaga komorki c jest ustawiona dla krawedzi wewnatrz komorki c oraz dla
+    krawedzi lezacych na najkrotszej sciezce do ktoregos z wezlow brzegowych
+    komorki c (tj. wezlow z krawedziami wchodzacymi spoza komorki) - kazda
+    najkrotsza sciezka do wezla komorki wchodzi do niej ostatni raz przez
+    wezel brzegowy, wiec cala przebiega po krawedziach z flaga komorki;
+  - krawedzie na najkrotszych sciezkach do wezla brzegowego wyznacza
+    eksploracja grafu wstecz od tego wezla: krawedz u->v lezy na takiej
+    sciezce, gdy d(u) = w(u,v) + d(v);
+  - obliczenia wstepne prowadzone sa rownolegle - kazdy wezel brzegowy to
+    osobne zadanie, a kazdy watek ma wlasny dziennik obliczen i wlasna kopie
+    flag, scalana na koniec (suma bitowa), dzieki czemu watki nie zapisuja
+    wspolnych danych;
+  - wyszukiwanie najkrotszej sciezki (exploreGraph) pomija krawedzie bez
+    flagi komorki wezla koncowego, o ile flagi wskazano w dzienniku obliczen.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include "common.h"
+#include "flags.h"
+#include "dsp.h"
+#include "parallel.h"
+
+using namespace std::chrono;
+
+
+/*
+  Struktura kontekstu zadan rownoleglych obliczen flag krawedzi
+  G         - graf
+  F         - flagi krawedzi (podzial na komorki)
+  boundary  - tablica Id wezlow brzegowych (po jednym na zadanie)
+  journals  - dzienniki obliczen przydzielone poszczegolnym watkom
+  buffers   - kopie flag przydzielone poszczegolnym watkom
+*/
+struct TArcFlagsTask {
+    TGraph *G;
+    TArcFlags *F;
+    int *boundary;
+    TJournal **journals;
+    UINT64 ***buffers;
+};
+
+
+void _partition(TGraph *G, int cells, int cell[]) {
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Oznaczenie wszystkich wezlow jako nieprzydzielonych
+    for (int v = 0; v < n; v++)
+        cell[v] = -1;
+
+    // Kolejka przeszukiwania wszerz
+    int *queue = new int[n];
+    int size = (n + cells -1) / cells;
+
+    int seed = 0;
+    int c = 0;
+    int filled = 0;
+    // Tak dlugo jak sa nieprzydzielone wezly, ...
+    while (seed < n) {
+        // ... wybor wezla poczatkowego (najmniejsze nieprzydzielone Id) ...
+        while (seed < n && cell[seed] != -1)
+            seed++;
+        if (seed == n)
+            break;
+        // ... i przeszukiwanie wszerz od niego, z przydzialem wezlow do
+        // biezacej komorki (az do osiagniecia jej rozmiaru)
+        int head = 0;
+        int tail = 0;
+        cell[seed] = c;
+        queue[tail++] = seed;
+        filled++;
+        while (head < tail) {
+            int currId = queue[head++];
+            for (int k = 0; k < 2; k++) {
+                int degree = k ? nodeInDegree(G, currId) : nodeDegree(G, currId);
+                for (int i = 0; i < degree; i++) {
+                    if (filled == size && c < cells -1)
+                        break;
+                    int nextId = k ? G->revList[currId][i] : G->adjList[currId][i];
+                    if (cell[nextId] != -1)
+                        continue;
+                    cell[nextId] = c;
+                    queue[tail++] = nextId;
+                    filled++;
+                }
+            }
+            if (filled == size && c < cells -1)
+                break;
+        }
+        // Przejscie do kolejnej komorki, gdy biezaca jest pelna
+        if (filled == size && c < cells -1) {
+            c++;
+            filled = 0;
+        }
+    }
+    delete[] queue;
+}
+
+
+void _arcFlagsTask(void *context, int index, int worker) {
+    TArcFlagsTask *T = (TArcFlagsTask *)context;
+    TGraph *G = T->G;
+    TJournal *J = T->journals[worker];
+    UINT64 **buffer = T->buffers[worker];
+
+    // Eksploracja grafu wstecz od wezla brzegowego, ...
+    int b = T->boundary[index];
+    exploreReverse(J, G, b);
+    UINT64 mask = (UINT64)1 << T->F->cell[b];
+
+    // ... i ustawienie flagi jego komorki krawedziom lezacym na najkrotszych
+    // sciezkach do niego
+    for (int u = 0; u < G->order; u++) {
+        INT64 du = entryDistance(J, u);
+        if (du == 2147483647)
+            continue;
+        for (int i = 0; i < nodeDegree(G, u); i++) {
+            int v = G->adjList[u][i];
+            INT64 dv = entryDistance(J, v);
+            if (dv != 2147483647 && du == dv + edgeWeight(G, u, v))
+                buffer[u][i] |= mask;
+        }
+    }
+}
+
+
+UINT64** _initFlags(TGraph *G, int e) {
+    // Alokacja wspolnego bloku flag wszystkich krawedzi i tablicy wskaznikow
+    // na flagi krawedzi poszczegolnych wezlow (rownoleglej do listy sasiedztwa)
+    UINT64 **flags = new UINT64*[G->order];
+    UINT64 *block = new UINT64[e];
+    for (int i = 0; i < e; i++)
+        block[i] = 0;
+    for (int v = 0, k = 0; v < G->order; k += nodeDegree(G, v), v++)
+        flags[v] = block + k;
+    return flags;
+}
+
+
+void _killFlags(UINT64** &flags) {
+    // Skasowanie wspolnego bloku flag (wskazywanego przez pierwszy wiersz)
+    // i tablicy wskaznikow
+    delete[] flags[0];
+    delete[] flags;
+    flags = NULL;
+}
+
+
+TArcFlags* initArcFlags(TGraph *G, int cells, int threads) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL || G->order == 0)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen wstepnych
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+    // Ilosc komorek ograniczona iloscia bitow flag i iloscia wezlow
+    if (cells > MAX_CELLS)
+        cells = MAX_CELLS;
+    if (cells > n)
+        cells = n;
+    if (cells < 1)
+        cells = 1;
+
+    // Ilosc krawedzi (dlugosc listy sasiedztwa)
+    int e = 0;
+    for (int v = 0; v < n; v++)
+        e += nodeDegree(G, v);
+
+    // Alokacja nowych flag ...
+    TArcFlags *F = new TArcFlags;
+    F->cells = cells;
+    F->cell = new int[n];
+    // ... i podzial grafu na komorki
+    _partition(G, cells, F->cell);
+    F->flags = _initFlags(G, e);
+
+// *** Flagi krawedzi wewnatrz komorek i wyszukanie wezlow brzegowych ***
+
+    int *boundary = new int[n];
+    F->boundary = 0;
+    for (int v = 0; v < n; v++) {
+        bool b = false;
+        for (int i = 0; i < nodeInDegree(G, v); i++)
+            if (F->cell[G->revList[v][i]] != F->cell[v])
+                b = true;
+        if (b)
+            boundary[F->boundary++] = v;
+        for (int i = 0; i < nodeDegree(G, v); i++)
+            if (F->cell[G->adjList[v][i]] == F->cell[v])
+                F->flags[v][i] |= (UINT64)1 << F->cell[v];
+    }
+
+// *** Rownolegle wyznaczenie flag krawedzi od wezlow brzegowych ***
+
+    // Dzienniki obliczen i kopie flag dla kazdego z watkow
+    int t = workerCount(threads, F->boundary);
+    TJournal **journals = new TJournal*[t];
+    UINT64 ***buffers = new UINT64**[t];
+    for (int w = 0; w < t; w++) {
+        journals[w] = initJournal(n);
+        journals[w]->queue = chooseQueue(G);
+        buffers[w] = _initFlags(G, e);
+    }
+    // Uruchomienie obliczen (po jednym zadaniu na wezel brzegowy) ...
+    TArcFlagsTask T = { G, F, boundary, journals, buffers };
+    runParallel(F->boundary, t, _arcFlagsTask, &T);
+
+    // ... i scalenie kopii flag watkow
+    for (int w = 0; w < t; w++) {
+        for (int i = 0; i < e; i++)
+            F->flags[0][i] |= buffers[w][0][i];
+        killJournal(journals[w]);
+        _killFlags(buffers[w]);
+    }
+    delete[] journals;
+    delete[] buffers;
+    delete[] boundary;
+
+    // Zapamietanie statystyki obliczen wstepnych
+    F->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+    F->memory = (INT64)e * sizeof(UINT64) + (INT64)n * (sizeof(int) + sizeof(UINT64 *));
+
+    // Zwrocenie wskaznika na zainicjowane flagi krawedzi
+    return F;
+}
+
+
+void killArcFlags(TArcFlags* &F) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (F == NULL)
+        return;
+
+    // Skasowanie flag krawedzi i podzialu na komorki
+    _killFlags(F->flags);
+    delete[] F->cell;
+
+    // Skasowanie struktury i zwrocenie przez parametr wyzerowanego wskaznika
+    delete F;
+    F = NULL;
+}
@@ -0,0 +1,46 @@
+#ifndef AC_ENGINE_FLAGS_H
+#define AC_ENGINE_FLAGS_H
+
+#include "common.h"
+#include "graph.h"
+
+
+#define MAX_CELLS  64
+
+
+/*
+  Struktura definiujaca flagi krawedzi (ang. arc flags) z podzialem grafu
+  na komorki
+  cells     - ilosc komorek podzialu grafu (co najwyzej MAX_CELLS)
+  cell      - n-elementowa tablica numerow komorek wezlow
+  flags     - n-wierszowa tablica flag krawedzi, rownolegla do listy sasiedztwa
+              (flags[v][i] dotyczy krawedzi od v do i-tego sasiada); bit c
+              jest ustawiony, gdy krawedz lezy na najkrotszej sciezce do
+              jakiegos wezla komorki c
+  boundary  - statystyka: ilosc wezlow brzegowych (z krawedziami wchodzacymi
+              spoza komorki)
+  time      - statystyka: czas obliczen wstepnych [us]
+  memory    - statystyka: pamiec zajmowana przez flagi i podzial [B]
+*/
+struct TArcFlags {
+    int cells;
+    int *cell;
+    UINT64 **flags;
+    int boundary;
+    INT64 time;
+    INT64 memory;
+};
+
+
+inline bool arcFlag(TArcFlags *F, int Id, int a, int stopId) {
+    // Zwrocenie wartosci logicznej czy a-ta krawedz wezla o podanym Id lezy
+    // na najkrotszej sciezce do komorki wezla koncowego
+    return (F->flags[Id][a] >> F->cell[stopId]) & 1;
+}
+
+
+TArcFlags* initArcFlags(TGraph *G, int cells, int threads);
+void killArcFlags(TArcFlags* &F);
+
+
+#endif // AC_ENGINE_FLAGS_H
@@ -0,0 +1,324 @@
+/* ----------------------------------------------------------------------------
+
+  TDistMatrix - najkrotsze drogi pomiedzy wszystkimi parami wezlow (algorytm
+  Floyda-Warshalla z podzialem macierzy na bloki)
+
+  UWAGI:
+  - dystanse przechowywane sa w ciaglej macierzy liczb 32-bitowych, ktorej
+    wiersze dopelniono do wielokrotnosci rozmiaru bloku (FLOYD_BLOCK), by
+    macierz dzielila sie na rowne bloki; brak krawedzi (drogi) oznacza
+    wartosc FLOYD_INF, a suma dwoch takich wartosci wciaz miesci sie w typie
+    int, wiec obliczenia nie wymagaja sprawdzania przepelnienia;
+  - macierz wyznaczana jest fazami - dla kolejnego bloku diagonalnego k:
+    (1) blok k,k, (2) bloki wiersza i kolumny k, (3) wszystkie pozostale
+    bloki; bloki w fazach 2. i 3. sa niezalezne, wiec przetwarzane sa
+    rownolegle przez zespol watkow, synchronizowany na barierze;
+  - rozmiar bloku dobrano tak, by trzy bloki uzywane przez jadro obliczen
+    (po 16 KB) miescily sie w pamieci podrecznej procesora;
+  - jadro obliczen to iloczyn macierzy w algebrze (min, +), liczony wektorowo
+    (po LANES dystansow naraz, rozszerzenia wektorowe kompilatora GCC; 8 przy
+    dostepnym AVX2, w przeciwnym razie 4), z pominieciem wierszy bez drogi;
+  - macierz nastepnikow (16-bitowa) wyznaczana jest po obliczeniu dystansow:
+    nastepnikiem wezla i na drodze do j jest sasiad u o najmniejszym Id,
+    dla ktorego w(i,u) + d(u,j) = d(i,j), co pozwala odtworzyc dowolna
+    najkrotsza sciezke bez ponownej eksploracji grafu;
+  - macierz wyznacza sie tylko, gdy dystans kazdej sciezki prostej miesci
+    sie ponizej FLOYD_INF, a ilosc wezlow - ponizej FLOYD_NONE.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include "common.h"
+#include "floyd.h"
+#include "parallel.h"
+
+using namespace std::chrono;
+
+
+#define FLOYD_BLOCK  64
+
+
+#if defined(__GNUC__)
+#if defined(__AVX2__)
+#define LANES  8
+#else
+#define LANES  4
+#endif
+typedef int TLanes __attribute__((vector_size(LANES * sizeof(int))));
+#endif
+
+
+/*
+  Struktura kontekstu zespolu watkow algorytmu Floyda-Warshalla
+  M         - macierze najkrotszych drog (wynik)
+  blocks    - ilosc blokow w wierszu (i kolumnie) macierzy dystansow
+  threads   - ilosc watkow zespolu
+  barrier   - bariera synchronizacji watkow pomiedzy fazami
+*/
+struct TFloydTask {
+    TDistMatrix *M;
+    int blocks;
+    int threads;
+    TBarrier barrier;
+};
+
+
+/*
+  Struktura kontekstu zadan wyznaczenia macierzy nastepnikow (jedno zadanie
+  - jeden wiersz macierzy)
+  G         - graf
+  M         - macierze najkrotszych drog
+*/
+struct TNextTask {
+    TGraph *G;
+    TDistMatrix *M;
+};
+
+
+inline int* _block(TDistMatrix *M, int i, int j) {
+    // Zwrocenie wskaznika na poczatek bloku (i,j) macierzy dystansow
+    return M->dist + ((INT64)i * M->stride + j) * FLOYD_BLOCK;
+}
+
+
+void _minPlus(int *C, int *A, int *B, int stride) {
+    // Aktualizacja bloku C dystansami przez wezly posrednie bloku:
+    // C[i][j] = min(C[i][j], A[i][k] + B[k][j]), kolejno dla kazdego k
+    // (bloki moga sie pokrywac, bo w kroku k nie zmienia sie ani wiersz,
+    // ani kolumna k - dystans d(k,k) wynosi 0)
+    for (int k = 0; k < FLOYD_BLOCK; k++)
+        for (int i = 0; i < FLOYD_BLOCK; i++) {
+            const int a = A[i * stride + k];
+            // Pominiecie wiersza bez drogi do wezla posredniego
+            if (a >= FLOYD_INF)
+                continue;
+            int *c = C + i * stride;
+            const int *b = B + k * stride;
+#ifdef LANES
+            // Przejscie po wierszu bloku po LANES dystansow naraz
+            TLanes va = a - (TLanes){};
+            for (int j = 0; j < FLOYD_BLOCK; j += LANES) {
+                TLanes x, y;
+                memcpy(&x, c + j, sizeof(x));
+                memcpy(&y, b + j, sizeof(y));
+                y += va;
+                x = (y < x) ? y : x;
+                memcpy(c + j, &x, sizeof(x));
+            }
+#else
+            for (int j = 0; j < FLOYD_BLOCK; j++)
+                if (a + b[j] < c[j])
+                    c[j] = a + b[j];
+#endif
+        }
+}
+
+
+void _floydWorker(void *context, int index, int worker) {
+    TFloydTask *T = (TFloydTask *)context;
+    // Aliasy na macierz, ilosc blokow i ilosc watkow
+    TDistMatrix *M = T->M;
+    const int &m = T->blocks;
+    const int &t = T->threads;
+
+    for (int k = 0; k < m; k++) {
+        // Faza 1.: blok diagonalny (jeden watek)
+        if (worker == 0)
+            _minPlus(_block(M, k, k), _block(M, k, k), _block(M, k, k), M->stride);
+        waitBarrier(&T->barrier);
+
+        // Faza 2.: bloki wiersza k (parzyste zadania) i kolumny k
+        // (nieparzyste), rozdzielone po rowno na watki
+        for (int b = worker; b < 2 * (m -1); b += t) {
+            int x = b / 2;
+            if (x >= k)
+                x++;
+            if (b % 2 == 0)
+                 _minPlus(_block(M, k, x), _block(M, k, k), _block(M, k, x), M->stride);
+            else _minPlus(_block(M, x, k), _block(M, x, k), _block(M, k, k), M->stride);
+        }
+        waitBarrier(&T->barrier);
+
+        // Faza 3.: pozostale bloki (niezalezne od siebie)
+        for (int b = worker; b < (m -1) * (m -1); b += t) {
+            int i = b / (m -1);
+            int j = b % (m -1);
+            if (i >= k)
+                i++;
+            if (j >= k)
+                j++;
+            _minPlus(_block(M, i, j), _block(M, i, k), _block(M, k, j), M->stride);
+        }
+        waitBarrier(&T->barrier);
+    }
+}
+
+
+void _nextTask(void *context, int index, int worker) {
+    TNextTask *T = (TNextTask *)context;
+    // Aliasy na rzad grafu, wiersz dystansow i wiersz nastepnikow
+    const int &n = T->G->order;
+    const int *di = T->M->dist + (INT64)index * T->M->stride;
+    unsigned short *next = T->M->next + (INT64)index * n;
+
+    // Zainicjowanie wiersza nastepnikow (z policzeniem wezlow osiagalnych)
+    int left = 0;
+    for (int j = 0; j < n; j++) {
+        next[j] = FLOYD_NONE;
+        if (j != index && di[j] < FLOYD_INF)
+            left++;
+    }
+    next[index] = index;
+
+    // Przejscie po wezlach sasiednich w porzadku rosnacych Id, ...
+    for (int a = 0; a < nodeDegree(T->G, index) && left > 0; a++) {
+        int u = T->G->adjList[index][a];
+        int w = T->G->adjMatrix[index][u];
+        const int *du = T->M->dist + (INT64)u * T->M->stride;
+        // ... z przypisaniem sasiada wezlom, do ktorych prowadzi
+        // najkrotsza droga przez niego (o ile nie maja jeszcze nastepnika)
+        for (int j = 0; j < n; j++)
+            if (next[j] == FLOYD_NONE && j != index && w + du[j] == di[j]) {
+                next[j] = u;
+                left--;
+            }
+    }
+}
+
+
+TDistMatrix* initDistMatrix(TGraph *G, int threads) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub dystanse albo Id
+    // wezlow nie mieszcza sie w macierzach)
+    if (G == NULL || G->order == 0 || G->order >= FLOYD_NONE
+     || (INT64)G->profile[gpMaxWeight] * (G->order -1) >= FLOYD_INF)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowych macierzy (z dopelnieniem wierszy do wielokrotnosci
+    // rozmiaru bloku) ...
+    TDistMatrix *M = new TDistMatrix;
+    M->length = n;
+    int m = (n + FLOYD_BLOCK -1) / FLOYD_BLOCK;
+    M->stride = m * FLOYD_BLOCK;
+    M->dist = new int[(INT64)M->stride * M->stride];
+    M->next = new unsigned short[(INT64)n * n];
+    // ... i wypelnienie macierzy dystansow wagami krawedzi
+    for (int i = 0; i < M->stride; i++)
+        for (int j = 0; j < M->stride; j++) {
+            int w = (i < n && j < n) ? G->adjMatrix[i][j] : 0;
+            M->dist[(INT64)i * M->stride + j] = (i == j) ? 0 : ((w > 0) ? w : FLOYD_INF);
+        }
+
+    // Wyznaczenie dystansow w zespole watkow ...
+    TFloydTask T;
+    T.M = M;
+    T.blocks = m;
+    T.threads = workerCount(threads, m * m);
+    initBarrier(&T.barrier, T.threads);
+    runTeam(T.threads, _floydWorker, &T);
+    // ... i wyznaczenie nastepnikow (po jednym zadaniu na wiersz)
+    TNextTask X = { G, M };
+    runParallel(n, threads, _nextTask, &X);
+
+    // Zapamietanie statystyki obliczen (najwiekszy dystans, czas obliczen
+    // i pamiec macierzy)
+    M->diameter = 0;
+    for (int i = 0; i < n; i++)
+        for (int j = 0; j < n; j++) {
+            int d = M->dist[(INT64)i * M->stride + j];
+            if (d < FLOYD_INF && d > M->diameter)
+                M->diameter = d;
+        }
+    M->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+    M->memory = (INT64)M->stride * M->stride * sizeof(int) + (INT64)n * n * sizeof(unsigned short);
+
+    // Zwrocenie wskaznika na wyznaczone macierze
+    return M;
+}
+
+
+void killDistMatrix(TDistMatrix* &M) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (M == NULL)
+        return;
+
+    // Skasowanie macierzy i zwrocenie przez parametr wyzerowanego wskaznika
+    delete[] M->dist;
+    delete[] M->next;
+    delete M;
+    M = NULL;
+}
+
+
+int matrixPath(TDistMatrix *M, int startId, int stopId, int Ids[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (M == NULL)
+        return -1;
+
+// Zaklada sie, ze dla podanej tablicy wynikowej przydzielono pamiec
+// w rozmiarze wystarczajacym do wpisania calej sekwencji wezlow.
+
+    // Brak drogi - sekwencja zawiera jedynie wezel koncowy (jak w dzienniku
+    // obliczen)
+    if (nextHop(M, startId, stopId) == FLOYD_NONE) {
+        Ids[0] = stopId;
+        return 1;
+    }
+
+    // Zebranie w tablicy wynikowej sekwencji wezlow po najkrotszej sciezce,
+    // od wezla startowego do koncowego, wg kolejnych nastepnikow
+    int n = 0;
+    int currId = startId;
+    Ids[n++] = currId;
+    while (currId != stopId) {
+        currId = nextHop(M, currId, stopId);
+        Ids[n++] = currId;
+    }
+
+    // Zwrocenie ilosci elementow w tablicy wynikowej
+    return n;
+}
+
+
+bool saveDistMatrix(TDistMatrix *M, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (M == NULL)
+        return false;
+
+    // Otwarcie pliku do zapisu (binarnie, by zachowac konce linii jak
+    // w danych zrodlowych)
+    ofstream fs(filename.c_str(), ios::out | ios::binary);
+    if (! fs.is_open())
+        return false;
+
+    // Zapis macierzy dystansow w postaci tekstowej, jak dane zrodlowe grafu
+    // (wiersze wezlow zrodlowych, wartosci rozdzielone tabulacja; "-" - brak
+    // drogi)
+    for (int i = 0; i < M->length; i++) {
+        for (int j = 0; j < M->length; j++) {
+            INT64 d = matrixDistance(M, i, j);
+            if (j > 0)
+                fs << "\t";
+            if (d == 2147483647)
+                 fs << "-";
+            else fs << d;
+        }
+        fs << "\r\n";
+    }
+    return fs.good();
+}
+
+
+#undef FLOYD_BLOCK
+#ifdef LANES
+#undef LANES
+#endif
@@ -0,0 +1,63 @@
+#ifndef AC_ENGINE_FLOYD_H
+#define AC_ENGINE_FLOYD_H
+
+#include <string>
+#include "common.h"
+#include "graph.h"
+
+using namespace std;
+
+
+#define FLOYD_INF   0x3fffffff
+#define FLOYD_NONE  65535
+
+
+/*
+  Struktura definiujaca macierze najkrotszych drog pomiedzy wszystkimi parami
+  wezlow (wynik algorytmu Floyda-Warshalla)
+  length    - ilosc wezlow grafu
+  stride    - dlugosc wiersza macierzy dystansow (ilosc wezlow dopelniona do
+              wielokrotnosci rozmiaru bloku)
+  dist      - (stride*stride)-elementowa, ciagla tablica dystansow (wierszami
+              - od kolejnych wezlow zrodlowych), FLOYD_INF - brak drogi
+  next      - (n*n)-elementowa tablica nastepnikow, tj. Id wezla, do ktorego
+              prowadzi pierwsza krawedz najkrotszej drogi (FLOYD_NONE - brak
+              drogi)
+  diameter  - statystyka: najwiekszy skonczony dystans
+  time      - statystyka: czas obliczen [us]
+  memory    - statystyka: pamiec zajmowana przez macierze [B]
+*/
+struct TDistMatrix {
+    int length;
+    int stride;
+    int *dist;
+    unsigned short *next;
+    INT64 diameter;
+    INT64 time;
+    INT64 memory;
+};
+
+
+inline INT64 matrixDistance(TDistMatrix *M, int startId, int stopId) {
+    // Zwrocenie dystansu od wezla startowego do koncowego (2147483647 - brak
+    // drogi, jak w dzienniku obliczen)
+    int d = M->dist[(INT64)startId * M->stride + stopId];
+    return (d < FLOYD_INF) ? d : 2147483647;
+}
+
+
+inline int nextHop(TDistMatrix *M, int startId, int stopId) {
+    // Zwrocenie wezla nastepnego po startowym na najkrotszej drodze
+    // do wezla koncowego
+    return M->next[(INT64)startId * M->length + stopId];
+}
+
+
+TDistMatrix* initDistMatrix(TGraph *G, int threads);
+void killDistMatrix(TDistMatrix* &M);
+
+int matrixPath(TDistMatrix *M, int startId, int stopId, int Ids[]);
+bool saveDistMatrix(TDistMatrix *M, string filename);
+
+
+#endif // AC_ENGINE_FLOYD_H
@@ -8,7 +8,13 @@
     laczacych wezly grafu (macierz w ukladzie: wezel poczatkowy w wierszu,
     wezly koncowe w kolumnach);
   - wezlom grafu mozna przypisac nazwy, jednak unikalnosc tych nazw w calym
-    grafie nie jest sprawdzana.
+    grafie nie jest sprawdzana;
+  - obok listy sasiedztwa tworzona jest odwrocona lista sasiedztwa (potrzebna
+    np. do przeszukiwania grafu wstecz, od wezla koncowego), przy czym dla
+    grafu nieskierowanego obie listy sa tozsame;
+  - zmiana wagi istniejacej krawedzi uaktualnia model grafu bez jego
+    przebudowy (macierz sasiedztwa, lista krawedzi i charakterystyka grafu),
+    natomiast dodanie lub usuniecie krawedzi wymaga przebudowy modelu.
 
   Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
 
@@ -35,9 +41,13 @@ TGraph* initGraph(int order) {
         G->adjMatrix[i] = _clearArray(new int[n], n);
 
     // Wyczyszczenie wskaznikow na niezainicjowane jeszcze struktury podrzedne
+    G->adjList = NULL;
+    G->revList = NULL;
     G->nodes = NULL;
     G->edges = NULL;
     G->profile = NULL;
+    G->weightSum = 0;
+    G->arcCount = 0;
 
     // Zwrocenie wskaznika na zainicjowany graf
     return G;
@@ -105,6 +115,93 @@ void buildModel(TGraph *G) {
 }
 
 
+void rebuildModel(TGraph *G) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL)
+        return;
+
+    // Skasowanie struktur podrzednych (np. po dodaniu lub usunieciu krawedzi
+    // w macierzy sasiedztwa) ...
+    deleteEdgeList(G, countEdges(G));
+    deleteProfile(G);
+    deleteAdjList(G);
+    deleteNodeList(G);
+    // ... i utworzenie ich na nowo
+    buildModel(G);
+}
+
+
+void _pairProfile(TGraph *G, int i, int j, int sign) {
+    // Doliczenie (sign = 1) albo odliczenie (sign = -1) udzialu pary wezlow
+    // w charakterystyce grafu, wg zasad przyjetych w createProfile
+    int iForth = G->adjMatrix[i][j];
+    int iBack  = G->adjMatrix[j][i];
+    if (iForth > 0 && ! (iBack == iForth && i > j)) {
+        G->profile[gpDirected] += sign * (iForth != iBack);
+        G->profile[gpWeighted] += sign * (iForth > 1);
+        G->profile[gpEdges] += sign;
+    }
+    if (iBack > 0 && ! (iForth == iBack && j > i)) {
+        G->profile[gpDirected] += sign * (iBack != iForth);
+        G->profile[gpWeighted] += sign * (iBack > 1);
+        G->profile[gpEdges] += sign;
+    }
+}
+
+
+void changeWeight(TGraph *G, int startId, int stopId, int weight) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL)
+        return;
+
+// Zaklada sie, ze krawedz istnieje, a nowa waga jest dodatnia (dodanie lub
+// usuniecie krawedzi wymaga przebudowy modelu - funkcja rebuildModel).
+
+    // Zapamietanie wagi sprzed zmiany
+    int old = G->adjMatrix[startId][stopId];
+
+    // Odliczenie udzialu pary wezlow w charakterystyce grafu, ...
+    _pairProfile(G, startId, stopId, -1);
+    // ... zapis nowej wagi w macierzy sasiedztwa ...
+    G->adjMatrix[startId][stopId] = weight;
+    // ... i doliczenie udzialu pary wezlow z nowa waga
+    _pairProfile(G, startId, stopId, 1);
+
+    // Uaktualnienie ilosci cykli (wg zasady 4. z createProfile) ...
+    const int &n = G->order;
+    if ((G->profile[gpIsolated] == 0)
+     && (G->profile[gpDirected] == 0))
+         G->profile[gpCycles] = 1+ G->profile[gpEdges] -n;
+    else G->profile[gpCycles] = -1;
+    // ... najwiekszej wagi krawedzi (przy obnizeniu wag pozostaje ona
+    // ograniczeniem gornym, az do przebudowy modelu) ...
+    if (G->profile[gpMaxWeight] < weight)
+        G->profile[gpMaxWeight] = weight;
+    // ... oraz sredniej wagi krawedzi (z sumy wag, do ktorej dolicza sie
+    // jedynie roznice wag, bez przegladania wszystkich krawedzi)
+    G->weightSum += weight - old;
+    if (G->arcCount > 0)
+        G->profile[gpMeanWeight] =
+            (int)((G->weightSum + G->arcCount -1) / G->arcCount);
+
+    // Wyszukanie krawedzi na liscie krawedzi (uporzadkowanej wg wezla
+    // poczatkowego, a nastepnie koncowego) i zapis jej nowej wagi
+    int lo = 0;
+    int hi = countEdges(G) -1;
+    while (lo <= hi) {
+        int mid = (lo + hi) / 2;
+        TEdge *edge = G->edges[mid];
+        if (edge->startId == startId && edge->stopId == stopId) {
+            edge->weight = weight;
+            break;
+        }
+        if (edge->startId < startId || (edge->startId == startId && edge->stopId < stopId))
+             lo = mid +1;
+        else hi = mid -1;
+    }
+}
+
+
 void createNodeList(TGraph *G) {
     // Zakonczenie, gdy podany wskaznik jest pusty
     if (G == NULL)
@@ -124,6 +221,7 @@ void createNodeList(TGraph *G) {
         node->Id = i;
         node->name = "";
         node->degree = 0;
+        node->inDegree = 0;
         // ... i zapisanie jej wskaznika na liscie wezlow
         G->nodes[i] = node;
     }
@@ -169,6 +267,37 @@ void createAdjList(TGraph *G) {
         // ... i zapamietywaniem ich dlugosci (w strukturze wezla)
         G->nodes[i]->degree = d;
     }
+
+    // Sprawdzenie czy macierz sasiedztwa jest symetryczna (graf nieskierowany), ...
+    bool symmetric = true;
+    for (int i = 0; i < n && symmetric; i++)
+        for (int j = 0; j < i; j++)
+            if (G->adjMatrix[i][j] != G->adjMatrix[j][i]) {
+                symmetric = false;
+                break;
+            }
+    // ... bo jesli tak, to odwrocona lista sasiedztwa jest tozsama z lista
+    // sasiedztwa (wspoldzieli z nia wiersze), ...
+    if (symmetric) {
+        G->revList = G->adjList;
+        for (int i = 0; i < n; i++)
+            G->nodes[i]->inDegree = G->nodes[i]->degree;
+        return;
+    }
+    // ... w przeciwnym razie (graf skierowany) nalezy ja utworzyc z kolumn
+    // macierzy sasiedztwa, tj. ...
+    int *V = new int[n];
+    G->revList = new int*[n];
+    for (int j = 0; j < n; j++) {
+        // ... skopiowac kolumne macierzy do wektora roboczego, ...
+        for (int i = 0; i < n; i++)
+            V[i] = G->adjMatrix[i][j];
+        // ... utworzyc na jego podstawie wiersz odwroconej listy sasiedztwa ...
+        int d = _createAdjTuple(V, n, G->revList[j]);
+        // ... i zapamietac jego dlugosc (w strukturze wezla)
+        G->nodes[j]->inDegree = d;
+    }
+    delete[] V;
 }
 
 
@@ -200,7 +329,11 @@ void createProfile(TGraph *G) {
     const int &n = G->order;
 
     // Alokacja tablicy charakterystyki grafu (z wyzerowaniem jej zawartosci)
-    G->profile = _clearArray(new int[6], 6);
+    G->profile = _clearArray(new int[8], 8);
+
+    // Wyzerowanie sumy wag i ilosci krawedzi (w obu kierunkach przejscia)
+    G->weightSum = 0;
+    G->arcCount = 0;
 
     // Dla kazdego wezla grafu ...
     for (int i = 0; i < n; i++) {
@@ -214,6 +347,12 @@ void createProfile(TGraph *G) {
                 // ... wage krawedzi laczacej/ych wezel biezacy z sasiednim ...
                 int iForth = G->adjMatrix[i][j];
                 int iBack  = G->adjMatrix[j][i];
+                // (zapamietac najwieksza napotkana wage krawedzi)
+                if (G->profile[gpMaxWeight] < iForth)
+                    G->profile[gpMaxWeight] = iForth;
+                // (i zsumowac wagi wszystkich krawedzi)
+                G->weightSum += iForth;
+                G->arcCount++;
                 if (iBack == iForth && (i > j))
                     // (wykluczyc podwojna analize krawedzi nieskierowanych)
                     continue;
@@ -227,6 +366,9 @@ void createProfile(TGraph *G) {
             G->profile[gpIsolated]++;
     }
     G->profile[gpNodes] = n;
+    if (G->arcCount > 0)
+        G->profile[gpMeanWeight] =
+            (int)((G->weightSum + G->arcCount -1) / G->arcCount);
     // Adn. 4)
     if ((G->profile[gpIsolated] == 0)
      && (G->profile[gpDirected] == 0))
@@ -312,6 +454,19 @@ void deleteAdjList(TGraph *G) {
     // Alias na rzad grafu (ilosc wezlow)
     const int &n = G->order;
 
+    // Skasowanie odwroconej listy sasiedztwa (o ile nie jest tozsama
+    // z lista sasiedztwa), tj. ...
+    if (G->revList != G->adjList) {
+        for (int i = 0; i < n; i++) {
+            // ... najpierw skasowanie wierszy, ...
+            delete[] G->revList[i];
+            G->revList[i] = NULL;
+        }
+        // ... nastepnie skasowanie tablic wskaznikow na wiersze
+        delete[] G->revList;
+    }
+    G->revList = NULL;
+
     // Skasowanie listy sasiedztwa (2-wym. tablicy), tj. ...
     for (int i = 0; i < n; i++) {
         // ... najpierw skasowanie wierszy, ...
@@ -8,11 +8,15 @@
   Struktura definiujaca wezel (wierzcholek) grafu
   Id        - identyfikator wezla, tzn. indeks wezla na liscie wezlow
   degree    - stopien wezla, tzn. liczba wezlow sasiednich
+  inDegree  - stopien wejsciowy wezla, tzn. liczba wezlow, z ktorych prowadza
+              krawedzie do danego wezla (w grafie nieskierowanym - rowny
+              stopniowi wezla)
   name      - nazwa wezla
 */
 struct TNode {
     int Id;
     int degree;
+    int inDegree;
     string name;
 };
 
@@ -40,20 +44,31 @@ struct TEdge {
   adjList   - lista sasiedztwa, tj. 2-wym. n-wierszowa tablica dynamiczna
               (gdzie n jest rzedem grafu) przechowujaca dla kazdego wezla
               indeksy wezlow sasiadujacych z nim
+  revList   - odwrocona lista sasiedztwa, tj. 2-wym. n-wierszowa tablica
+              dynamiczna przechowujaca dla kazdego wezla indeksy wezlow,
+              z ktorych prowadza do niego krawedzie (w grafie nieskierowanym
+              jest tozsama z lista sasiedztwa)
   nodes     - lista wezlow, tj. tablica dynamiczna przechowujaca wskazniki
               wszystkich wezlow grafu
   edges     - lista krawedzi, tj. tablica dynamiczna przechowujaca wskazniki
               rozpoznanych krawedzi grafu
   profile   - tablica dynamiczna przechowujaca cechy charakterystyczne grafu,
               np. ilosc cykli, czy jest grafem skierowanym, wazonym, itp.
+  weightSum - suma wag krawedzi (krawedzie nieskierowane liczone w obu
+              kierunkach przejscia), podstawa sredniej wagi krawedzi
+  arcCount  - ilosc krawedzi liczonych w obu kierunkach przejscia (suma
+              stopni wezlow)
 */
 struct TGraph {
     int order;
     int **adjMatrix;
     int **adjList;
+    int **revList;
     TNode **nodes;
     TEdge **edges;
     int *profile;
+    INT64 weightSum;
+    int arcCount;
 };
 
 
@@ -66,6 +81,11 @@ struct TGraph {
   gpIsolated - ilosc wezlow bez sasiedztwa (wierzcholkow izolowanych)
   gpDirected - ilosc krawedzi skierowanych (jesli 0, graf nieskierowany)
   gpWeighted - ilosc krawedzi wazonych (jesli > 0, graf wazony)
+  gpMaxWeight - najwieksza waga krawedzi (po obnizeniu wag funkcja
+               changeWeight - ograniczenie gorne wag krawedzi, az do
+               przebudowy modelu)
+  gpMeanWeight - srednia waga krawedzi (zaokraglona w gore; krawedzie
+               nieskierowane liczone w obu kierunkach przejscia)
 */
 enum EGraphProfile {
     gpNodes,
@@ -73,7 +93,9 @@ enum EGraphProfile {
     gpCycles,
     gpIsolated,
     gpDirected,
-    gpWeighted
+    gpWeighted,
+    gpMaxWeight,
+    gpMeanWeight
 };
 
 
@@ -110,6 +132,21 @@ inline TNode* nodeNeighbour(TGraph *G, int Id, int a) {
     return G->nodes[iAdj];
 }
 
+inline int nodeInDegree(TGraph *G, int Id) {
+    // Wybor z listy wezlow wskaznika na wezel o podanym Id
+    // i zwrocenie stopnia wejsciowego tego wezla
+    return G->nodes[Id]->inDegree;
+}
+
+inline TNode* nodePredecessor(TGraph *G, int Id, int a) {
+    // Pobranie z odwroconej listy sasiedztwa indeksu a-tego wezla, z ktorego
+    // prowadzi krawedz do wezla o podanym Id, ...
+    int iAdj = G->revList[Id][a];
+    // ... wybor z listy wezlow wskaznika na wezel o takim indeksie
+    // i zwrocenie tego wskaznika
+    return G->nodes[iAdj];
+}
+
 inline int edgeWeight(TGraph *G, int startId, int stopId) {
     // Pobranie z macierzy sasiedztwa (tj. z odpowiedniego wektora,
     // zwiazanego z wezlem poczatkowym o podanym Id) "wagi" krawedzi
@@ -122,6 +159,8 @@ TGraph* initGraph(int order);
 void killGraph(TGraph* &G);
 
 void buildModel(TGraph *G);
+void rebuildModel(TGraph *G);
+void changeWeight(TGraph *G, int startId, int stopId, int weight);
 int countEdges(TGraph *G);
 
 
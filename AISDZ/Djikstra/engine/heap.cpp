@@ -8,7 +8,24 @@
   - elementami kopca sa wskazniki na 64-bitowe liczby calkowite;
   - ilosc elementow w kopcu okresla liczba wskazywana przez H[0];
   - sortowanie elementow kopca odbywa sie w porzadku "na szczycie wskaznik
-    do wartosci minimalnej".
+    do wartosci minimalnej";
+  - wariant indeksowany kopca przechowuje identyfikatory (Id) elementow
+    z zakresu od 0 do n-1 wraz z ich kluczami, a mapa pozycji pozwala
+    w czasie stalym odnalezc element w kopcu - dzieki temu zmniejszenie klucza
+    wymaga jedynie przesiania elementu w gore struktury, O(log n), zamiast
+    przebudowy calego kopca, O(n);
+  - wariant indeksowany zlicza operacje przesiewania (przesuniecia elementow
+    w gore i w dol struktury), a licznik moze byc zerowany przez uzytkownika;
+  - zdjecie elementu ze szczytu przywraca w mapie pozycji jego oznaczenie
+    "poza kopcem", wiec kopiec oprozniony zdejmowaniem elementow nadaje sie
+    do ponownego uzycia bez przegladu mapy pozycji; kopiec niepusty oproznia
+    sie funkcja heapClear, w czasie proporcjonalnym do ilosci elementow
+    pozostawionych w kopcu;
+  - kopiec 4-arny to odmiana kopca indeksowanego o dwukrotnie mniejszej
+    wysokosci, w ktorym klucze przechowywane sa razem z identyfikatorami
+    elementow, a czworka potomkow kazdego rodzica zajmuje jedna linie pamieci
+    podrecznej - wybor "potomka minimalnego" nie wymaga odwolan do innych
+    obszarow pamieci.
 
   Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
 
@@ -133,3 +150,328 @@ INT64* heapPop(INT64* H[]) {
 // okreslony przez licznik elementow kopca. Tym samym, sukcesywne zdejmowanie
 // elementow ze szczytu tworzy w tablicy posortowany liniowo ciag wartosci.
 // Wlasnosc te mozna wykorzystac do sortowania na kopcu.
+
+
+
+
+// *** Indeksowany kopiec binarny typu minimalnego ***
+
+
+TIndexHeap* initIndexHeap(int n) {
+    // Alokacja nowego kopca, ...
+    TIndexHeap *H = new TIndexHeap;
+    // ... z wyzerowaniem licznikow
+    H->size = 0;
+    H->sifts = 0;
+
+    // Alokacja tablicy elementow kopca, ...
+    H->items = new int[1+ n];
+    // ... mapy pozycji (z oznaczeniem wszystkich elementow jako "poza kopcem") ...
+    H->where = new int[n];
+    for (int i = 0; i < n; i++)
+        H->where[i] = 0;
+    // ... oraz tablicy kluczy
+    H->keys = new INT64[n];
+
+    // Zwrocenie wskaznika na zainicjowany kopiec
+    return H;
+}
+
+
+void killIndexHeap(TIndexHeap* &H) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return;
+
+    // Skasowanie tablic kopca, ...
+    delete[] H->items;
+    delete[] H->where;
+    delete[] H->keys;
+
+    // ... a nastepnie kopca i zwrocenie przez parametr wyzerowanego wskaznika
+    delete H;
+    H = NULL;
+}
+
+
+void heapClear(TIndexHeap *H) {
+    // Oznaczenie elementow pozostawionych w kopcu jako "poza kopcem" ...
+    for (int i = 1; i <= H->size; i++)
+        H->where[H->items[i]] = 0;
+    // ... i wyzerowanie licznikow
+    H->size = 0;
+    H->sifts = 0;
+}
+
+
+void _siftUp(TIndexHeap *H, int i) {
+    // Zapamietanie przesiewanego elementu i jego klucza
+    int Id = H->items[i];
+    INT64 key = H->keys[Id];
+
+    while (i > 1) {
+        // Ustalenie indeksu rodzica ...
+        int p = i >> 1;
+        // ... i sprawdzenie czy przesiewany element ma mniejszy klucz, ...
+        if (key < H->keys[H->items[p]]) {
+            // ... bo jesli tak, to zepchniecie rodzica do roli potomka
+            // (z aktualizacja mapy pozycji) ...
+            H->items[i] = H->items[p];
+            H->where[H->items[i]] = i;
+            H->sifts++;
+            // ... i kontynuacja od miejsca zwolnionego przez rodzica
+            i = p;
+        }
+        else break;
+    }
+    // Zapis przesiewanego elementu w ustalone miejsce
+    H->items[i] = Id;
+    H->where[Id] = i;
+}
+
+
+void _siftDown(TIndexHeap *H, int i) {
+    int n = H->size;
+    // Zapamietanie przesiewanego elementu i jego klucza
+    int Id = H->items[i];
+    INT64 key = H->keys[Id];
+
+    while (true) {
+        // Obliczenie indeksu potomka lewego, ...
+        int c = i << 1;
+        // ... przy czym, gdy element nie ma potomkow - koniec
+        if (c > n)
+            break;
+        // Wybor "potomka minimalnego"
+        if (c < n && H->keys[H->items[c +1]] < H->keys[H->items[c]])
+            c++;
+        // Sprawdzenie czy "potomek minimalny" ma mniejszy klucz, ...
+        if (H->keys[H->items[c]] < key) {
+            // ... bo jesli tak, to wciagniecie go do roli rodzica
+            // (z aktualizacja mapy pozycji) ...
+            H->items[i] = H->items[c];
+            H->where[H->items[i]] = i;
+            H->sifts++;
+            // ... i kontynuacja od miejsca zwolnionego przez potomka
+            i = c;
+        }
+        else break;
+    }
+    // Zapis przesiewanego elementu w ustalone miejsce
+    H->items[i] = Id;
+    H->where[Id] = i;
+}
+
+
+void heapPush(TIndexHeap *H, int Id, INT64 key) {
+    // Zapis klucza elementu, ...
+    H->keys[Id] = key;
+    // ... dopisanie elementu na koncu kopca ...
+    int i = ++H->size;
+    H->items[i] = Id;
+    H->where[Id] = i;
+    // ... i przesianie go w gore struktury
+    _siftUp(H, i);
+}
+
+
+int heapPop(TIndexHeap *H) {
+    int n = H->size;
+    // Zakonczenie, gdy kopiec jest pusty
+    if (n == 0)
+        return -1;
+
+    // Zapamietanie elementu ze szczytu kopca ...
+    int Id = H->items[1];
+    // ... i oznaczenie go jako "poza kopcem"
+    H->where[Id] = 0;
+    // Przeniesienie ostatniego elementu na szczyt ...
+    H->items[1] = H->items[n];
+    H->size = --n;
+    // ... i (o ile kopiec jest niepusty) przesianie go w dol struktury
+    if (n > 0) {
+        H->where[H->items[1]] = 1;
+        _siftDown(H, 1);
+    }
+
+    // Zwrocenie Id elementu, ktory byl na szczycie
+    return Id;
+}
+
+
+void decreaseKey(TIndexHeap *H, int Id, INT64 key) {
+    // Zakonczenie, gdy elementu nie ma w kopcu lub klucz nie maleje
+    if (! heapContains(H, Id) || key >= H->keys[Id])
+        return;
+
+    // Zapis nowego (mniejszego) klucza ...
+    H->keys[Id] = key;
+    // ... i przesianie elementu w gore struktury
+    _siftUp(H, H->where[Id]);
+}
+
+
+
+// *** Indeksowany kopiec 4-arny typu minimalnego ***
+
+
+#define QUAD_ROOT  3
+#define CACHE_LINE  64
+
+
+TQuadHeap* initQuadHeap(int n) {
+    // Alokacja nowego kopca, ...
+    TQuadHeap *H = new TQuadHeap;
+    // ... z wyzerowaniem licznikow
+    H->size = 0;
+    H->sifts = 0;
+
+    // Alokacja obszaru pamieci na tablice elementow kopca (z zapasem
+    // na wyrownanie) i ustawienie poczatku tablicy na granicy linii pamieci
+    H->block = new char[(QUAD_ROOT + n +4) * sizeof(TQuadItem) + CACHE_LINE];
+    H->items = (TQuadItem*)(((size_t)H->block + CACHE_LINE -1) & ~(size_t)(CACHE_LINE -1));
+    // Alokacja mapy pozycji (z oznaczeniem wszystkich elementow jako "poza kopcem")
+    H->where = new int[n];
+    for (int i = 0; i < n; i++)
+        H->where[i] = 0;
+
+    // Zwrocenie wskaznika na zainicjowany kopiec
+    return H;
+}
+
+
+void killQuadHeap(TQuadHeap* &H) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return;
+
+    // Skasowanie tablic kopca, ...
+    delete[] H->block;
+    delete[] H->where;
+
+    // ... a nastepnie kopca i zwrocenie przez parametr wyzerowanego wskaznika
+    delete H;
+    H = NULL;
+}
+
+
+void heapClear(TQuadHeap *H) {
+    // Oznaczenie elementow pozostawionych w kopcu jako "poza kopcem" ...
+    for (int i = QUAD_ROOT; i < QUAD_ROOT + H->size; i++)
+        H->where[H->items[i].Id] = 0;
+    // ... i wyzerowanie licznikow
+    H->size = 0;
+    H->sifts = 0;
+}
+
+
+void _siftUp(TQuadHeap *H, int i) {
+    // Zapamietanie przesiewanego elementu
+    TQuadItem x = H->items[i];
+
+    while (i > QUAD_ROOT) {
+        // Ustalenie pozycji rodzica ...
+        int p = ((i - QUAD_ROOT -1) >> 2) + QUAD_ROOT;
+        // ... i sprawdzenie czy przesiewany element ma mniejszy klucz, ...
+        if (x.key < H->items[p].key) {
+            // ... bo jesli tak, to zepchniecie rodzica do roli potomka
+            // (z aktualizacja mapy pozycji) ...
+            H->items[i] = H->items[p];
+            H->where[H->items[i].Id] = i;
+            H->sifts++;
+            // ... i kontynuacja od miejsca zwolnionego przez rodzica
+            i = p;
+        }
+        else break;
+    }
+    // Zapis przesiewanego elementu w ustalone miejsce
+    H->items[i] = x;
+    H->where[x.Id] = i;
+}
+
+
+void _siftDown(TQuadHeap *H, int i) {
+    // Pozycja ostatniego elementu kopca
+    int last = H->size + QUAD_ROOT -1;
+    // Zapamietanie przesiewanego elementu
+    TQuadItem x = H->items[i];
+
+    while (true) {
+        // Obliczenie pozycji pierwszego potomka, ...
+        int c = ((i - QUAD_ROOT) << 2) + QUAD_ROOT +1;
+        // ... przy czym, gdy element nie ma potomkow - koniec
+        if (c > last)
+            break;
+        // Wybor "potomka minimalnego" sposrod (co najwyzej) czterech
+        int m = c;
+        int e = (c +3 < last) ? c +3 : last;
+        for (int k = c +1; k <= e; k++)
+            if (H->items[k].key < H->items[m].key)
+                m = k;
+        // Sprawdzenie czy "potomek minimalny" ma mniejszy klucz, ...
+        if (H->items[m].key < x.key) {
+            // ... bo jesli tak, to wciagniecie go do roli rodzica
+            // (z aktualizacja mapy pozycji) ...
+            H->items[i] = H->items[m];
+            H->where[H->items[i].Id] = i;
+            H->sifts++;
+            // ... i kontynuacja od miejsca zwolnionego przez potomka
+            i = m;
+        }
+        else break;
+    }
+    // Zapis przesiewanego elementu w ustalone miejsce
+    H->items[i] = x;
+    H->where[x.Id] = i;
+}
+
+
+void heapPush(TQuadHeap *H, int Id, INT64 key) {
+    // Dopisanie elementu na koncu kopca ...
+    int i = QUAD_ROOT + H->size++;
+    H->items[i].key = key;
+    H->items[i].Id = Id;
+    H->where[Id] = i;
+    // ... i przesianie go w gore struktury
+    _siftUp(H, i);
+}
+
+
+int heapPop(TQuadHeap *H) {
+    // Zakonczenie, gdy kopiec jest pusty
+    if (H->size == 0)
+        return -1;
+
+    // Zapamietanie elementu ze szczytu kopca ...
+    int Id = int(H->items[QUAD_ROOT].Id);
+    // ... i oznaczenie go jako "poza kopcem"
+    H->where[Id] = 0;
+    // Przeniesienie ostatniego elementu na szczyt ...
+    H->size--;
+    H->items[QUAD_ROOT] = H->items[QUAD_ROOT + H->size];
+    // ... i (o ile kopiec jest niepusty) przesianie go w dol struktury
+    if (H->size > 0) {
+        H->where[H->items[QUAD_ROOT].Id] = QUAD_ROOT;
+        _siftDown(H, QUAD_ROOT);
+    }
+
+    // Zwrocenie Id elementu, ktory byl na szczycie
+    return Id;
+}
+
+
+void decreaseKey(TQuadHeap *H, int Id, INT64 key) {
+    // Zakonczenie, gdy elementu nie ma w kopcu lub klucz nie maleje
+    int i = H->where[Id];
+    if (i == 0 || key >= H->items[i].key)
+        return;
+
+    // Zapis nowego (mniejszego) klucza ...
+    H->items[i].key = key;
+    // ... i przesianie elementu w gore struktury
+    _siftUp(H, i);
+}
+
+
+#undef QUAD_ROOT
+#undef CACHE_LINE
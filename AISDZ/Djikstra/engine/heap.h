@@ -23,4 +23,102 @@ void heapPush(INT64* H[], INT64 *item);
 INT64* heapPop(INT64* H[]);
 
 
+/*
+  Struktura definiujaca indeksowany kopiec binarny typu minimalnego
+  size      - ilosc elementow w kopcu
+  items     - (1+ n)-elementowa tablica identyfikatorow elementow kopca
+              (indeksowanie elementow kopca zaczyna sie od 1)
+  where     - mapa pozycji, tj. n-elementowa tablica okreslajaca dla kazdego
+              identyfikatora jego pozycje w kopcu (0 - poza kopcem)
+  keys      - n-elementowa tablica kluczy (priorytetow) elementow
+  sifts     - licznik operacji przesiewania (przesuniec elementow w kopcu)
+*/
+struct TIndexHeap {
+    int size;
+    int *items;
+    int *where;
+    INT64 *keys;
+    INT64 sifts;
+};
+
+
+inline int heapSize(TIndexHeap *H) {
+    // Zwrocenie ilosci elementow w kopcu
+    return H->size;
+}
+
+inline bool heapContains(TIndexHeap *H, int Id) {
+    // Zwrocenie wartosci logicznej czy element o podanym Id jest w kopcu
+    return (H->where[Id] > 0);
+}
+
+inline int heapTop(TIndexHeap *H) {
+    // Zwrocenie Id elementu ze szczytu kopca (-1 gdy kopiec jest pusty)
+    return (H->size > 0) ? H->items[1] : -1;
+}
+
+
+TIndexHeap* initIndexHeap(int n);
+void killIndexHeap(TIndexHeap* &H);
+
+void heapClear(TIndexHeap *H);
+
+void heapPush(TIndexHeap *H, int Id, INT64 key);
+int heapPop(TIndexHeap *H);
+void decreaseKey(TIndexHeap *H, int Id, INT64 key);
+
+
+/*
+  Struktura definiujaca element kopca 4-arnego
+  key       - klucz (priorytet) elementu
+  Id        - identyfikator elementu
+*/
+struct TQuadItem {
+    INT64 key;
+    INT64 Id;
+};
+
+
+/*
+  Struktura definiujaca indeksowany kopiec 4-arny typu minimalnego
+  size      - ilosc elementow w kopcu
+  items     - tablica elementow kopca (klucz wraz z identyfikatorem),
+              wyrownana do granicy linii pamieci podrecznej (64 bajty);
+              szczyt kopca lezy na pozycji 3, dzieki czemu czworka potomkow
+              kazdego rodzica zajmuje dokladnie jedna linie pamieci
+  where     - mapa pozycji, tj. n-elementowa tablica okreslajaca dla kazdego
+              identyfikatora jego pozycje w kopcu (0 - poza kopcem)
+  block     - obszar pamieci zaalokowany dla tablicy elementow kopca
+  sifts     - licznik operacji przesiewania (przesuniec elementow w kopcu)
+*/
+struct TQuadHeap {
+    int size;
+    TQuadItem *items;
+    int *where;
+    char *block;
+    INT64 sifts;
+};
+
+
+inline int heapSize(TQuadHeap *H) {
+    // Zwrocenie ilosci elementow w kopcu
+    return H->size;
+}
+
+inline bool heapContains(TQuadHeap *H, int Id) {
+    // Zwrocenie wartosci logicznej czy element o podanym Id jest w kopcu
+    return (H->where[Id] > 0);
+}
+
+
+TQuadHeap* initQuadHeap(int n);
+void killQuadHeap(TQuadHeap* &H);
+
+void heapClear(TQuadHeap *H);
+
+void heapPush(TQuadHeap *H, int Id, INT64 key);
+int heapPop(TQuadHeap *H);
+void decreaseKey(TQuadHeap *H, int Id, INT64 key);
+
+
 #endif // AC_ENGINE_HEAP_H
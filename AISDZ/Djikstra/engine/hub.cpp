@@ -0,0 +1,550 @@
+/* ----------------------------------------------------------------------------
+
+  THubLabels - etykiety wezlow (ang. hub labeling), wyrocznia dystansow
+
+  UWAGI:
+  - kazdy wezel v otrzymuje etykiete wyjsciowa (huby h wraz z dystansami
+    d(v,h)) i wejsciowa (huby h wraz z dystansami d(h,v)), tak aby dla kazdej
+    pary wezlow s, t najkrotsza droga prowadzila przez wspolny hub etykiety
+    wyjsciowej s i wejsciowej t; dystans to wowczas najmniejsza suma
+    d(s,h) + d(h,t) po wspolnych hubach;
+  - etykiety budowane sa metoda "przycinanych punktow orientacyjnych" (ang.
+    pruned landmark labeling): wezly przetwarzane sa w zadanym porzadku
+    (od najwazniejszych), a z kazdego prowadzi sie algorytm Dijkstry w przod
+    i wstecz, ktory nie rozwija wezlow, dla ktorych etykiety juz zbudowane
+    daja dystans nie dluzszy - dzieki czemu etykiety pozostaja niewielkie;
+  - porzadek wezlow podaje sie w parametrze (np. wg rang hierarchii skrotow),
+    a w jego braku przyjmuje sie porzadek malejacych stopni wezlow;
+  - huby zapisywane sa jako rangi wezlow w tym porzadku, wiec kazda etykieta
+    jest posortowana rosnaco (huby dopisywane sa w kolejnosci przetwarzania),
+    a zapytanie o dystans to jednokrotne, rownolegle przejscie dwoch
+    posortowanych tablic (scalanie) - bez eksploracji grafu;
+  - kazda etykieta konczy sie wartownikiem (hubem rownym n), dzieki czemu
+    petla scalania nie sprawdza konca tablic;
+  - w grafie nieskierowanym etykiety wejsciowe sa tozsame z wyjsciowymi;
+  - etykiety mozna zapisac w pliku w postaci zwartej: liczby kodowane sa
+    zmienna iloscia bajtow (po 7 bitow na bajt), a rangi hubow - jako roznice
+    wzgledem poprzedniego huba w etykiecie;
+  - przy odczycie z pliku etykiety sa sprawdzane (ilosc wezlow i znacznik
+    grafu skierowanego zgodne z grafem - przed alokacja pamieci, ilosc wpisow
+    nie wieksza niz ilosc wezlow, rangi hubow scisle rosnace i mniejsze niz
+    ilosc wezlow, dystanse nieujemne) - plik uszkodzony jest odrzucany
+    w calosci, zanim etykiety trafia do zapytan o dystans;
+  - poczatki etykiet w zwartych tablicach sa liczbami typu int, wiec etykiety
+    o lacznej ilosci wpisow (z wartownikami) spoza tego zakresu sa odrzucane,
+    zarowno przy budowie, jak i przy odczycie z pliku.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <string>
+#include <fstream>
+#include <chrono>
+#include "common.h"
+#include "hub.h"
+#include "heap.h"
+
+using namespace std;
+using namespace std::chrono;
+
+
+#define INF  2147483647
+
+
+/*
+  Struktura definiujaca etykiete wezla w trakcie budowy
+  count     - ilosc wpisow etykiety
+  size      - pojemnosc tablic etykiety
+  hub       - tablica rang hubow
+  dist      - tablica dystansow
+*/
+struct TLabel {
+    int count;
+    int size;
+    int *hub;
+    int *dist;
+};
+
+
+void _appendLabel(TLabel &L, int hub, int dist) {
+    // Powiekszenie (dwukrotne) tablic etykiety, gdy sa zapelnione
+    if (L.count == L.size) {
+        int size = (L.size > 0) ? 2 * L.size : 4;
+        int *h = new int[size];
+        int *d = new int[size];
+        for (int i = 0; i < L.count; i++) {
+            h[i] = L.hub[i];
+            d[i] = L.dist[i];
+        }
+        delete[] L.hub;
+        delete[] L.dist;
+        L.hub = h;
+        L.dist = d;
+        L.size = size;
+    }
+    // Dopisanie wpisu na koncu etykiety
+    L.hub[L.count] = hub;
+    L.dist[L.count] = dist;
+    L.count++;
+}
+
+
+void _prunedSearch(TGraph *G, int rootId, int rank, bool backward,
+                   TLabel *roots, TLabel *labels, INT64 *tmp,
+                   INT64 *dist, int *touched, TIndexHeap *Q) {
+    // Zaladowanie etykiety wezla startowego do tablicy dystansow hubow
+    // (do szybkiego wyznaczania dystansu z etykiet juz zbudowanych)
+    TLabel &R = roots[rootId];
+    for (int i = 0; i < R.count; i++)
+        tmp[R.hub[i]] = R.dist[i];
+
+    int reached = 0;
+    dist[rootId] = 0;
+    touched[reached++] = rootId;
+    heapPush(Q, rootId, 0);
+
+    // Algorytm Dijkstry (w przod lub wstecz) od wezla startowego, ...
+    while (heapSize(Q) > 0) {
+        int currId = heapPop(Q);
+        INT64 d = dist[currId];
+        // ... z przycieciem wezlow, dla ktorych etykiety juz zbudowane
+        // daja dystans nie dluzszy, ...
+        TLabel &C = labels[currId];
+        INT64 q = INF;
+        for (int i = 0; i < C.count; i++)
+            if (tmp[C.hub[i]] + C.dist[i] < q)
+                q = tmp[C.hub[i]] + C.dist[i];
+        if (q <= d)
+            continue;
+        // ... a w przeciwnym razie dopisaniem wezla startowego (jego rangi)
+        // do etykiety wezla i rozwinieciem jego sasiedztwa
+        _appendLabel(C, rank, (int)d);
+        int degree = backward ? nodeInDegree(G, currId) : nodeDegree(G, currId);
+        for (int i = 0; i < degree; i++) {
+            int nextId = backward ? nodePredecessor(G, currId, i)->Id
+                                  : nodeNeighbour(G, currId, i)->Id;
+            INT64 nd = d + (backward ? edgeWeight(G, nextId, currId)
+                                     : edgeWeight(G, currId, nextId));
+            if (dist[nextId] > nd) {
+                if (dist[nextId] == INF)
+                    touched[reached++] = nextId;
+                dist[nextId] = nd;
+                if (heapContains(Q, nextId))
+                    decreaseKey(Q, nextId, nd);
+                else heapPush(Q, nextId, nd);
+            }
+        }
+    }
+
+    // Wyczyszczenie tablic roboczych
+    for (int i = 0; i < reached; i++)
+        dist[touched[i]] = INF;
+    for (int i = 0; i < R.count; i++)
+        tmp[R.hub[i]] = INF;
+}
+
+
+bool _packLabels(TLabel *labels, int n, int* &first, int* &hub, int* &dist) {
+    // Ustalenie poczatkow etykiet (kazda z wartownikiem na koncu), ...
+    first = new int[n +1];
+    first[0] = 0;
+    INT64 total = 0;
+    for (int v = 0; v < n; v++) {
+        total += labels[v].count + 1;
+        // ... z odrzuceniem etykiet, gdy laczna ilosc wpisow przekracza
+        // zakres poczatkow etykiet, ...
+        if (total > 2147483647) {
+            delete[] first;
+            first = hub = dist = NULL;
+            return false;
+        }
+        first[v +1] = (int)total;
+    }
+    // ... i przepisanie etykiet do zwartych tablic
+    hub = new int[first[n]];
+    dist = new int[first[n]];
+    for (int v = 0; v < n; v++) {
+        int k = first[v];
+        for (int i = 0; i < labels[v].count; i++, k++) {
+            hub[k] = labels[v].hub[i];
+            dist[k] = labels[v].dist[i];
+        }
+        hub[k] = n;
+        dist[k] = 0;
+    }
+    return true;
+}
+
+
+void _labelStats(THubLabels *L) {
+    // Alias na ilosc wezlow
+    const int &n = L->length;
+
+    // Zliczenie wpisow etykiet (bez wartownikow) i najwiekszej etykiety
+    L->entries = 0;
+    L->maxLabel = 0;
+    for (int v = 0; v < n; v++) {
+        int c = L->outFirst[v +1] - L->outFirst[v] - 1;
+        if (L->directed) {
+            int d = L->inFirst[v +1] - L->inFirst[v] - 1;
+            L->entries += d;
+            if (d > L->maxLabel)
+                L->maxLabel = d;
+        }
+        L->entries += c;
+        if (c > L->maxLabel)
+            L->maxLabel = c;
+    }
+    // Ustalenie pamieci zajmowanej przez etykiety
+    L->memory = (INT64)(n +1) * sizeof(int) + (INT64)L->outFirst[n] * 2 * sizeof(int);
+    if (L->directed)
+        L->memory += (INT64)(n +1) * sizeof(int) + (INT64)L->inFirst[n] * 2 * sizeof(int);
+}
+
+
+THubLabels* initHubLabels(TGraph *G, int order[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL)
+        return NULL;
+
+    // Poczatek pomiaru czasu budowy etykiet
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowych etykiet
+    THubLabels *L = new THubLabels;
+    L->length = n;
+    L->directed = (G->profile[gpDirected] > 0);
+
+// *** Ustalenie porzadku wezlow ***
+
+    int *rankOrder = new int[n];
+    if (order != NULL)
+        for (int r = 0; r < n; r++)
+            rankOrder[r] = order[r];
+    else {
+        // Porzadek malejacych stopni wezlow (sortowanie przez zliczanie,
+        // przy rownych stopniach - rosnaco wg Id)
+        int *count = new int[2 * n +2];
+        for (int d = 0; d < 2 * n +2; d++)
+            count[d] = 0;
+        for (int v = 0; v < n; v++)
+            count[nodeDegree(G, v) + nodeInDegree(G, v)]++;
+        int r = 0;
+        for (int d = 2 * n +1; d >= 0; d--) {
+            int c = count[d];
+            count[d] = r;
+            r += c;
+        }
+        for (int v = 0; v < n; v++)
+            rankOrder[count[nodeDegree(G, v) + nodeInDegree(G, v)]++] = v;
+        delete[] count;
+    }
+
+// *** Budowa etykiet metoda przycinanych punktow orientacyjnych ***
+
+    TLabel *out = new TLabel[n];
+    TLabel *in = L->directed ? new TLabel[n] : out;
+    for (int v = 0; v < n; v++) {
+        out[v].count = in[v].count = 0;
+        out[v].size = in[v].size = 0;
+        out[v].hub = in[v].hub = NULL;
+        out[v].dist = in[v].dist = NULL;
+    }
+
+    // Tablice robocze przeszukiwan
+    INT64 *tmp = new INT64[n];
+    INT64 *dist = new INT64[n];
+    int *touched = new int[n];
+    for (int v = 0; v < n; v++)
+        tmp[v] = dist[v] = INF;
+    TIndexHeap *Q = initIndexHeap(n);
+
+    // Dla kolejnych wezlow w porzadku - przeszukiwanie w przod (uzupelnia
+    // etykiety wejsciowe) i wstecz (uzupelnia etykiety wyjsciowe)
+    for (int r = 0; r < n; r++) {
+        int v = rankOrder[r];
+        _prunedSearch(G, v, r, false, out, in, tmp, dist, touched, Q);
+        if (L->directed)
+            _prunedSearch(G, v, r, true, in, out, tmp, dist, touched, Q);
+    }
+
+    killIndexHeap(Q);
+    delete[] tmp;
+    delete[] dist;
+    delete[] touched;
+    delete[] rankOrder;
+
+// *** Zapisanie etykiet w postaci zwartej ***
+
+    L->inFirst = L->inHub = L->inDist = NULL;
+    bool packed = _packLabels(out, n, L->outFirst, L->outHub, L->outDist);
+    if (L->directed)
+        packed = packed && _packLabels(in, n, L->inFirst, L->inHub, L->inDist);
+    else {
+        L->inFirst = L->outFirst;
+        L->inHub = L->outHub;
+        L->inDist = L->outDist;
+    }
+
+    // Skasowanie etykiet roboczych
+    for (int v = 0; v < n; v++) {
+        delete[] out[v].hub;
+        delete[] out[v].dist;
+        if (L->directed) {
+            delete[] in[v].hub;
+            delete[] in[v].dist;
+        }
+    }
+    if (L->directed)
+        delete[] in;
+    delete[] out;
+
+    // Odrzucenie etykiet, ktorych nie da sie zapisac w postaci zwartej
+    if (! packed) {
+        killHubLabels(L);
+        return NULL;
+    }
+
+    // Zapamietanie statystyki etykiet
+    _labelStats(L);
+    L->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+
+    // Zwrocenie wskaznika na zbudowane etykiety
+    return L;
+}
+
+
+void killHubLabels(THubLabels* &L) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (L == NULL)
+        return;
+
+    // Skasowanie etykiet wejsciowych (o ile nie sa tozsame z wyjsciowymi), ...
+    if (L->directed) {
+        delete[] L->inFirst;
+        delete[] L->inHub;
+        delete[] L->inDist;
+    }
+    // ... i wyjsciowych
+    delete[] L->outFirst;
+    delete[] L->outHub;
+    delete[] L->outDist;
+
+    // Skasowanie etykiet i zwrocenie przez parametr wyzerowanego wskaznika
+    delete L;
+    L = NULL;
+}
+
+
+INT64 hubDistance(THubLabels *L, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (L == NULL)
+        return -1;
+
+    // Etykieta wyjsciowa wezla startowego i wejsciowa wezla koncowego
+    const int *ah = L->outHub + L->outFirst[startId];
+    const int *ad = L->outDist + L->outFirst[startId];
+    const int *bh = L->inHub + L->inFirst[stopId];
+    const int *bd = L->inDist + L->inFirst[stopId];
+
+    INT64 best = INF;
+    // Scalanie posortowanych etykiet, az do wartownikow (rowne huby -
+    // kandydat na najkrotsza droge, w przeciwnym razie przesuniecie
+    // w etykiecie o mniejszym hubie)
+    for (;;) {
+        int a = *ah;
+        int b = *bh;
+        if (a == b) {
+            if (a == L->length)
+                break;
+            INT64 d = (INT64)*ad + *bd;
+            if (d < best)
+                best = d;
+            ah++; ad++;
+            bh++; bd++;
+        }
+        else if (a < b) {
+            ah++; ad++;
+        }
+        else {
+            bh++; bd++;
+        }
+    }
+    // Zwrocenie dystansu (INF - wezel koncowy nieosiagalny)
+    return best;
+}
+
+
+// *** Zapis i odczyt etykiet w postaci zwartej ***
+
+
+void _writeNumber(ofstream &fs, unsigned int v) {
+    // Zapis liczby zmienna iloscia bajtow, po 7 bitow na bajt
+    // (najstarszy bit oznacza kolejny bajt)
+    while (v >= 0x80) {
+        fs.put((char)((v & 0x7f) | 0x80));
+        v >>= 7;
+    }
+    fs.put((char)v);
+}
+
+
+unsigned int _readNumber(ifstream &fs) {
+    // Odczyt liczby zapisanej zmienna iloscia bajtow
+    unsigned int v = 0;
+    for (int shift = 0; shift < 35; shift += 7) {
+        int c = fs.get();
+        if (c == EOF)
+            break;
+        v |= (unsigned int)(c & 0x7f) << shift;
+        if ((c & 0x80) == 0)
+            break;
+    }
+    return v;
+}
+
+
+void _writeLabels(ofstream &fs, int n, int *first, int *hub, int *dist) {
+    // Dla kazdego wezla - ilosc wpisow, a nastepnie pary: roznica rang hubow
+    // i dystans
+    for (int v = 0; v < n; v++) {
+        _writeNumber(fs, first[v +1] - first[v] - 1);
+        int prev = 0;
+        for (int i = first[v]; i < first[v +1] - 1; i++) {
+            _writeNumber(fs, hub[i] - prev);
+            _writeNumber(fs, dist[i]);
+            prev = hub[i];
+        }
+    }
+}
+
+
+bool _readLabels(ifstream &fs, int n, int* &first, int* &hub, int* &dist) {
+    // Odczyt ilosci wpisow wszystkich etykiet i ustalenie ich poczatkow
+    // (wymaga dwoch przejsc, dlatego etykiety czytane sa do pamieci roboczej)
+    TLabel *labels = new TLabel[n];
+    for (int v = 0; v < n; v++) {
+        labels[v].count = labels[v].size = 0;
+        labels[v].hub = NULL;
+        labels[v].dist = NULL;
+    }
+    bool valid = true;
+    for (int v = 0; v < n && valid; v++) {
+        // Odrzucenie etykiety o ilosci wpisow wiekszej niz ilosc wezlow
+        // (przed alokacja pamieci na jej wpisy)
+        unsigned int count = _readNumber(fs);
+        if (fs.fail() || count > (unsigned int)n) {
+            valid = false;
+            break;
+        }
+        labels[v].count = labels[v].size = (int)count;
+        labels[v].hub = new int[count];
+        labels[v].dist = new int[count];
+        INT64 prev = 0;
+        for (int i = 0; i < (int)count; i++) {
+            unsigned int delta = _readNumber(fs);
+            unsigned int d = _readNumber(fs);
+            prev += delta;
+            // Odrzucenie wpisu, gdy plik jest niekompletny, rangi hubow
+            // nie rosna scisle lub wychodza poza zakres (co najmniej n -
+            // tj. wartownik), albo dystans jest ujemny
+            if (fs.fail() || (i > 0 && delta == 0) || prev >= n || d > 2147483647u) {
+                valid = false;
+                break;
+            }
+            labels[v].hub[i] = (int)prev;
+            labels[v].dist[i] = (int)d;
+        }
+    }
+    // Przepisanie etykiet do zwartych tablic (o ile sa poprawne)
+    if (valid)
+         valid = _packLabels(labels, n, first, hub, dist);
+    else first = hub = dist = NULL;
+    for (int v = 0; v < n; v++) {
+        delete[] labels[v].hub;
+        delete[] labels[v].dist;
+    }
+    delete[] labels;
+
+    // Zwrocenie wartosci logicznej czy etykiety sa poprawne
+    return valid;
+}
+
+
+bool saveHubLabels(THubLabels *L, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (L == NULL)
+        return false;
+
+    // Proba otwarcia pliku do zapisu
+    ofstream fs(filename.c_str(), ios::out | ios::binary);
+    if (! fs.is_open())
+        return false;
+
+    // Zapis naglowka (sygnatura, ilosc wezlow, znacznik grafu skierowanego), ...
+    fs.write("HUB1", 4);
+    _writeNumber(fs, L->length);
+    _writeNumber(fs, L->directed ? 1 : 0);
+    // ... etykiet wyjsciowych i (w grafie skierowanym) wejsciowych
+    _writeLabels(fs, L->length, L->outFirst, L->outHub, L->outDist);
+    if (L->directed)
+        _writeLabels(fs, L->length, L->inFirst, L->inHub, L->inDist);
+
+    // Zwrocenie wartosci logicznej czy zapis sie powiodl
+    return fs.good();
+}
+
+
+THubLabels* loadHubLabels(string filename, int order, bool directed) {
+    // Proba otwarcia pliku do odczytu
+    ifstream fs(filename.c_str(), ios::in | ios::binary);
+    if (! fs.is_open())
+        return NULL;
+
+    // Sprawdzenie sygnatury pliku
+    char sign[4];
+    fs.read(sign, 4);
+    if (! fs.good() || string(sign, 4) != "HUB1")
+        return NULL;
+
+    // Odczyt naglowka (z odrzuceniem etykiet innego grafu, tj. o innej ilosci
+    // wezlow lub skierowaniu, zanim zostanie przydzielona pamiec) ...
+    unsigned int length = _readNumber(fs);
+    bool oriented = (_readNumber(fs) != 0);
+    if (fs.fail() || order < 0 || length != (unsigned int)order || oriented != directed)
+        return NULL;
+
+    // ... i alokacja nowych etykiet (poczatkowo pustych), ...
+    THubLabels *L = new THubLabels;
+    L->length = order;
+    L->directed = directed;
+    L->outFirst = L->outHub = L->outDist = NULL;
+    L->inFirst = L->inHub = L->inDist = NULL;
+    // ... z odczytem etykiet wyjsciowych i (w grafie skierowanym) wejsciowych
+    bool valid = _readLabels(fs, L->length, L->outFirst, L->outHub, L->outDist);
+    if (L->directed)
+        valid = valid && _readLabels(fs, L->length, L->inFirst, L->inHub, L->inDist);
+    else {
+        L->inFirst = L->outFirst;
+        L->inHub = L->outHub;
+        L->inDist = L->outDist;
+    }
+    // Etykiety z pliku nie maja czasu budowy
+    L->time = 0;
+
+    // Odrzucenie etykiet z uszkodzonego pliku
+    if (! valid || fs.fail()) {
+        killHubLabels(L);
+        return NULL;
+    }
+    // Zapamietanie statystyki etykiet i zwrocenie wskaznika na etykiety
+    _labelStats(L);
+    return L;
+}
+
+
+#undef INF
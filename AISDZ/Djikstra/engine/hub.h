@@ -0,0 +1,54 @@
+#ifndef AC_ENGINE_HUB_H
+#define AC_ENGINE_HUB_H
+
+#include <string>
+#include "common.h"
+#include "graph.h"
+
+using namespace std;
+
+
+/*
+  Struktura definiujaca etykiety wezlow (ang. hub labels) - wyrocznie dystansow
+  length    - ilosc wezlow grafu
+  directed  - wartosc logiczna czy etykiety wejsciowe sa odrebne od wyjsciowych
+              (graf skierowany)
+  outFirst  - (n+1)-elementowa tablica poczatkow etykiet wyjsciowych wezlow
+  outHub    - tablica rang wezlow-hubow etykiet wyjsciowych (w kazdej etykiecie
+              rosnaco, zakonczona wartownikiem rownym n)
+  outDist   - tablica dystansow od wezlow do hubow etykiet wyjsciowych
+  inFirst   - (n+1)-elementowa tablica poczatkow etykiet wejsciowych wezlow
+  inHub     - tablica rang wezlow-hubow etykiet wejsciowych
+  inDist    - tablica dystansow od hubow do wezlow etykiet wejsciowych
+              (w grafie nieskierowanym tablice in... sa tozsame z out...)
+  entries   - statystyka: laczna ilosc wpisow w etykietach (bez wartownikow)
+  maxLabel  - statystyka: najwieksza ilosc wpisow w etykiecie
+  time      - statystyka: czas budowy etykiet [us]
+  memory    - statystyka: pamiec zajmowana przez etykiety [B]
+*/
+struct THubLabels {
+    int length;
+    bool directed;
+    int *outFirst;
+    int *outHub;
+    int *outDist;
+    int *inFirst;
+    int *inHub;
+    int *inDist;
+    INT64 entries;
+    int maxLabel;
+    INT64 time;
+    INT64 memory;
+};
+
+
+THubLabels* initHubLabels(TGraph *G, int order[]);
+void killHubLabels(THubLabels* &L);
+
+INT64 hubDistance(THubLabels *L, int startId, int stopId);
+
+bool saveHubLabels(THubLabels *L, string filename);
+THubLabels* loadHubLabels(string filename, int order, bool directed);
+
+
+#endif // AC_ENGINE_HUB_H
@@ -0,0 +1,380 @@
+/* ----------------------------------------------------------------------------
+
+  TManyTable - tablica dystansow pomiedzy zbiorem wezlow zrodlowych a zbiorem
+  wezlow docelowych (ang. many-to-many)
+
+  UWAGI:
+  - bez hierarchii skrotow kazdy wezel zrodlowy to osobny algorytm Dijkstry,
+    ktory sledzi zbior wezlow docelowych i konczy prace z chwila zwiedzenia
+    ostatniego z nich (zamiast eksplorowac caly graf);
+  - z hierarchia skrotow dystanse wyznacza metoda kubelkow: z kazdego wezla
+    docelowego t prowadzone jest pelne przeszukiwanie grafu "w dol" (wstecz,
+    do wezlow wyzszej rangi), a kazdy osiagniety wezel v otrzymuje w swoim
+    kubelku wpis (t, d(v,t)); nastepnie z kazdego wezla zrodlowego s
+    prowadzone jest przeszukiwanie grafu "w gore", a dla kazdego osiagnietego
+    wezla v dystanse d(s,v) + d(v,t) z wpisow jego kubelka uaktualniaja
+    wiersz tablicy - najkrotsza droga przechodzi przez wezel najwyzszej rangi,
+    osiagany z obu stron, wiec minimum jest dokladnym dystansem;
+  - przestrzenie przeszukiwania w hierarchii sa male, dlatego kazdy watek ma
+    wlasne tablice robocze, z ktorych po kazdym przeszukiwaniu czysci
+    wylacznie odwiedzone pozycje;
+  - przeszukiwania z wezlow docelowych, a potem z wezlow zrodlowych,
+    prowadzone sa rownolegle (kubelki sa wspolne, ale tylko do odczytu).
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include <fstream>
+#include "common.h"
+#include "many.h"
+#include "heap.h"
+#include "parallel.h"
+
+using namespace std::chrono;
+
+
+#define INF  2147483647
+
+
+/*
+  Struktura definiujaca tablice robocze przeszukiwania (wlasne dla watku)
+  dist      - n-elementowa tablica dystansow (INF - wezel nieosiagniety)
+  done      - n-elementowa tablica znacznikow zwiedzenia wezlow
+  touched   - tablica Id wezlow osiagnietych w biezacym przeszukiwaniu
+  count     - ilosc wezlow osiagnietych w biezacym przeszukiwaniu
+  Q         - kolejka priorytetowa (kopiec pozycyjny)
+  settled   - statystyka: ilosc zwiedzonych wezlow (we wszystkich
+              przeszukiwaniach watku)
+*/
+struct TSearchSpace {
+    INT64 *dist;
+    bool *done;
+    int *touched;
+    int count;
+    TIndexHeap *Q;
+    INT64 settled;
+};
+
+
+/*
+  Struktura kontekstu zadan rownoleglych (jedno zadanie - jeden wezel
+  docelowy albo jeden wezel zrodlowy)
+  G         - graf
+  H         - hierarchia skrotow (NULL - przeszukiwania z wczesnym zakonczeniem)
+  M         - tablica dystansow (wynik)
+  spaces    - tablice robocze przeszukiwan poszczegolnych watkow
+  mark      - n-elementowa tablica znacznikow wezlow docelowych
+  distinct  - ilosc roznych wezlow docelowych
+  found     - ilosci wezlow osiagnietych z kolejnych wezlow docelowych
+  foundIds  - Id wezlow osiagnietych z kolejnych wezlow docelowych
+  foundDist - dystanse wezlow osiagnietych z kolejnych wezlow docelowych
+  first     - (n+1)-elementowa tablica poczatkow kubelkow wezlow
+  column    - tablica numerow wezlow docelowych we wpisach kubelkow
+  distance  - tablica dystansow we wpisach kubelkow
+*/
+struct TManyTask {
+    TGraph *G;
+    THierarchy *H;
+    TManyTable *M;
+    TSearchSpace *spaces;
+    bool *mark;
+    int distinct;
+    int *found;
+    int **foundIds;
+    INT64 **foundDist;
+    int *first;
+    int *column;
+    INT64 *distance;
+};
+
+
+void _initSpace(TSearchSpace &S, int n) {
+    // Alokacja tablic roboczych (z oznaczeniem wszystkich wezlow jako
+    // nieosiagniete)
+    S.dist = new INT64[n];
+    S.done = new bool[n];
+    S.touched = new int[n];
+    for (int v = 0; v < n; v++) {
+        S.dist[v] = INF;
+        S.done[v] = false;
+    }
+    S.count = 0;
+    S.Q = initIndexHeap(n);
+    S.settled = 0;
+}
+
+
+void _killSpace(TSearchSpace &S) {
+    // Skasowanie tablic roboczych
+    delete[] S.dist;
+    delete[] S.done;
+    delete[] S.touched;
+    killIndexHeap(S.Q);
+}
+
+
+void _resetSpace(TSearchSpace &S) {
+    // Wyczyszczenie pozycji osiagnietych w ostatnim przeszukiwaniu
+    // (oraz oproznienie kolejki po przerwanym przeszukiwaniu)
+    for (int i = 0; i < S.count; i++) {
+        S.dist[S.touched[i]] = INF;
+        S.done[S.touched[i]] = false;
+    }
+    S.count = 0;
+    while (heapSize(S.Q) > 0)
+        heapPop(S.Q);
+}
+
+
+void _reach(TSearchSpace &S, int Id, INT64 dist) {
+    // Uaktualnienie dystansu wezla, gdy droga jest krotsza (z zapamietaniem
+    // wezla przy pierwszym osiagnieciu)
+    if (S.dist[Id] == INF) {
+        S.touched[S.count++] = Id;
+        S.dist[Id] = dist;
+        heapPush(S.Q, Id, dist);
+    }
+    else if (! S.done[Id] && dist < S.dist[Id]) {
+        S.dist[Id] = dist;
+        decreaseKey(S.Q, Id, dist);
+    }
+}
+
+
+void _searchHierarchy(TSearchSpace &S, int *first, int *head, INT64 *weight, int startId) {
+    // Pelne przeszukiwanie grafu hierarchii (w postaci CSR) od podanego wezla
+    _reach(S, startId, 0);
+    while (heapSize(S.Q) > 0) {
+        int currId = heapPop(S.Q);
+        S.done[currId] = true;
+        S.settled++;
+        for (int i = first[currId]; i < first[currId +1]; i++)
+            _reach(S, head[i], S.dist[currId] + weight[i]);
+    }
+}
+
+
+void _searchGraph(TSearchSpace &S, TGraph *G, int startId, bool *mark, int distinct) {
+    // Przeszukiwanie grafu od podanego wezla, az do zwiedzenia wszystkich
+    // wezlow docelowych
+    int left = distinct;
+    _reach(S, startId, 0);
+    while (heapSize(S.Q) > 0 && left > 0) {
+        int currId = heapPop(S.Q);
+        S.done[currId] = true;
+        S.settled++;
+        if (mark[currId])
+            left--;
+        for (int i = 0; i < nodeDegree(G, currId); i++) {
+            int nextId = G->adjList[currId][i];
+            _reach(S, nextId, S.dist[currId] + G->adjMatrix[currId][nextId]);
+        }
+    }
+}
+
+
+void _manyTargetTask(void *context, int index, int worker) {
+    TManyTask *T = (TManyTask *)context;
+    TSearchSpace &S = T->spaces[worker];
+
+    // Przeszukiwanie grafu "w dol" z wezla docelowego ...
+    _searchHierarchy(S, T->H->downFirst, T->H->downHead, T->H->downWeight, T->M->targetIds[index]);
+    // ... i zapamietanie osiagnietych wezlow (przyszle wpisy kubelkow)
+    T->found[index] = S.count;
+    T->foundIds[index] = new int[S.count];
+    T->foundDist[index] = new INT64[S.count];
+    for (int i = 0; i < S.count; i++) {
+        T->foundIds[index][i] = S.touched[i];
+        T->foundDist[index][i] = S.dist[S.touched[i]];
+    }
+    _resetSpace(S);
+}
+
+
+void _manySourceTask(void *context, int index, int worker) {
+    TManyTask *T = (TManyTask *)context;
+    TSearchSpace &S = T->spaces[worker];
+    // Alias na wiersz tablicy wynikowej
+    INT64 *row = T->M->dist + (INT64)index * T->M->cols;
+
+    if (T->H != NULL) {
+        // Przeszukiwanie grafu "w gore" z wezla zrodlowego ...
+        _searchHierarchy(S, T->H->upFirst, T->H->upHead, T->H->upWeight, T->M->sourceIds[index]);
+        // ... z uaktualnieniem wiersza wpisami kubelkow osiagnietych wezlow
+        for (int j = 0; j < T->M->cols; j++)
+            row[j] = INF;
+        for (int i = 0; i < S.count; i++) {
+            int v = S.touched[i];
+            for (int b = T->first[v]; b < T->first[v +1]; b++)
+                if (S.dist[v] + T->distance[b] < row[T->column[b]])
+                    row[T->column[b]] = S.dist[v] + T->distance[b];
+        }
+    }
+    else {
+        // Przeszukiwanie grafu z wczesnym zakonczeniem ...
+        _searchGraph(S, T->G, T->M->sourceIds[index], T->mark, T->distinct);
+        // ... i przepisanie dystansow wezlow docelowych do wiersza
+        for (int j = 0; j < T->M->cols; j++)
+            row[j] = S.dist[T->M->targetIds[j]];
+    }
+    _resetSpace(S);
+}
+
+
+void _buildBuckets(TManyTask *T, int n) {
+    // Zliczenie wpisow w kubelkach kolejnych wezlow, ...
+    T->first = new int[n +1];
+    for (int v = 0; v <= n; v++)
+        T->first[v] = 0;
+    for (int j = 0; j < T->M->cols; j++)
+        for (int i = 0; i < T->found[j]; i++)
+            T->first[T->foundIds[j][i] +1]++;
+    for (int v = 0; v < n; v++)
+        T->first[v +1] += T->first[v];
+
+    // ... i rozmieszczenie wpisow w kubelkach (w porzadku wezlow docelowych)
+    T->column = new int[T->first[n]];
+    T->distance = new INT64[T->first[n]];
+    int *next = new int[n];
+    for (int v = 0; v < n; v++)
+        next[v] = T->first[v];
+    for (int j = 0; j < T->M->cols; j++) {
+        for (int i = 0; i < T->found[j]; i++) {
+            int b = next[T->foundIds[j][i]]++;
+            T->column[b] = j;
+            T->distance[b] = T->foundDist[j][i];
+        }
+        delete[] T->foundIds[j];
+        delete[] T->foundDist[j];
+    }
+    delete[] next;
+}
+
+
+TManyTable* initManyTable(TGraph *G, THierarchy *H, int threads,
+                          int rows, int sourceIds[], int cols, int targetIds[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub zbiory wezlow sa puste)
+    if (G == NULL || rows < 1 || cols < 1)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowej tablicy dystansow (z kopiami zbiorow wezlow)
+    TManyTable *M = new TManyTable;
+    M->rows = rows;
+    M->cols = cols;
+    M->sourceIds = new int[rows];
+    M->targetIds = new int[cols];
+    for (int i = 0; i < rows; i++)
+        M->sourceIds[i] = sourceIds[i];
+    for (int j = 0; j < cols; j++)
+        M->targetIds[j] = targetIds[j];
+    M->dist = new INT64[(INT64)rows * cols];
+
+    // Tablice robocze dla kazdego z watkow
+    int t = workerCount(threads, (rows > cols) ? rows : cols);
+    TManyTask T = { G, H, M, new TSearchSpace[t], NULL, 0, NULL, NULL, NULL, NULL, NULL, NULL };
+    for (int w = 0; w < t; w++)
+        _initSpace(T.spaces[w], n);
+
+    if (H != NULL) {
+        // Przeszukiwania z wezlow docelowych (po jednym zadaniu na wezel)
+        // i zbudowanie z ich wynikow kubelkow wezlow
+        T.found = new int[cols];
+        T.foundIds = new int*[cols];
+        T.foundDist = new INT64*[cols];
+        runParallel(cols, t, _manyTargetTask, &T);
+        _buildBuckets(&T, n);
+        M->buckets = T.first[n];
+    }
+    else {
+        // Oznaczenie (roznych) wezlow docelowych
+        T.mark = new bool[n];
+        for (int v = 0; v < n; v++)
+            T.mark[v] = false;
+        for (int j = 0; j < cols; j++)
+            if (! T.mark[targetIds[j]]) {
+                T.mark[targetIds[j]] = true;
+                T.distinct++;
+            }
+        M->buckets = 0;
+    }
+    // Przeszukiwania z wezlow zrodlowych (po jednym zadaniu na wezel)
+    runParallel(rows, t, _manySourceTask, &T);
+
+    // Zapamietanie statystyki obliczen (laczna ilosc zwiedzonych wezlow
+    // i czas obliczen) ...
+    M->settled = 0;
+    for (int w = 0; w < t; w++) {
+        M->settled += T.spaces[w].settled;
+        _killSpace(T.spaces[w]);
+    }
+    M->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+    // ... i skasowanie struktur roboczych
+    delete[] T.spaces;
+    delete[] T.mark;
+    delete[] T.found;
+    delete[] T.foundIds;
+    delete[] T.foundDist;
+    delete[] T.first;
+    delete[] T.column;
+    delete[] T.distance;
+
+    // Zwrocenie wskaznika na wyznaczona tablice dystansow
+    return M;
+}
+
+
+void killManyTable(TManyTable* &M) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (M == NULL)
+        return;
+
+    // Skasowanie tablicy i zwrocenie przez parametr wyzerowanego wskaznika
+    delete[] M->sourceIds;
+    delete[] M->targetIds;
+    delete[] M->dist;
+    delete M;
+    M = NULL;
+}
+
+
+bool saveManyTable(TManyTable *M, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (M == NULL)
+        return false;
+
+    // Otwarcie pliku do zapisu (binarnie, by zachowac konce linii jak
+    // w danych zrodlowych)
+    ofstream fs(filename.c_str(), ios::out | ios::binary);
+    if (! fs.is_open())
+        return false;
+
+    // Zapis tablicy w postaci tekstowej: naglowek z Id wezlow docelowych,
+    // a dalej wiersze z Id wezla zrodlowego i dystansami (wartosci
+    // rozdzielone tabulacja; "-" - brak drogi)
+    for (int j = 0; j < M->cols; j++)
+        fs << "\t" << M->targetIds[j];
+    fs << "\r\n";
+    for (int i = 0; i < M->rows; i++) {
+        fs << M->sourceIds[i];
+        for (int j = 0; j < M->cols; j++) {
+            INT64 d = manyDistance(M, i, j);
+            fs << "\t";
+            if (d == INF)
+                 fs << "-";
+            else fs << d;
+        }
+        fs << "\r\n";
+    }
+    return fs.good();
+}
+
+
+#undef INF
@@ -0,0 +1,51 @@
+#ifndef AC_ENGINE_MANY_H
+#define AC_ENGINE_MANY_H
+
+#include <string>
+#include "common.h"
+#include "graph.h"
+#include "ch.h"
+
+using namespace std;
+
+
+/*
+  Struktura definiujaca tablice dystansow pomiedzy zbiorem wezlow zrodlowych
+  a zbiorem wezlow docelowych (ang. many-to-many)
+  rows      - ilosc wezlow zrodlowych
+  cols      - ilosc wezlow docelowych
+  sourceIds - tablica Id wezlow zrodlowych (rows elementow)
+  targetIds - tablica Id wezlow docelowych (cols elementow)
+  dist      - (rows*cols)-elementowa tablica dystansow (wierszami - od
+              kolejnych wezlow zrodlowych), 2147483647 - brak drogi
+  buckets   - statystyka: ilosc wpisow w kubelkach wezlow (0 - obliczenia
+              bez hierarchii skrotow)
+  settled   - statystyka: laczna ilosc zwiedzonych wezlow
+  time      - statystyka: czas obliczen [us]
+*/
+struct TManyTable {
+    int rows;
+    int cols;
+    int *sourceIds;
+    int *targetIds;
+    INT64 *dist;
+    INT64 buckets;
+    INT64 settled;
+    INT64 time;
+};
+
+
+inline INT64 manyDistance(TManyTable *M, int row, int col) {
+    // Zwrocenie dystansu od row-tego wezla zrodlowego do col-tego wezla
+    // docelowego
+    return M->dist[(INT64)row * M->cols + col];
+}
+
+
+TManyTable* initManyTable(TGraph *G, THierarchy *H, int threads,
+                          int rows, int sourceIds[], int cols, int targetIds[]);
+void killManyTable(TManyTable* &M);
+bool saveManyTable(TManyTable *M, string filename);
+
+
+#endif // AC_ENGINE_MANY_H
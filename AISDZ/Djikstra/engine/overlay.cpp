@@ -0,0 +1,197 @@
+/* ----------------------------------------------------------------------------
+
+  TOverlay - nakladka zmian grafu ("what-if")
+
+  UWAGI:
+  - nakladka opisuje hipotetyczne zmiany grafu (zamkniete krawedzie, zmienione
+    wagi krawedzi, zablokowane wezly), nie zmieniajac macierzy sasiedztwa,
+    list sasiedztwa ani listy krawedzi - wskazana w dzienniku obliczen jest
+    uwzgledniana przez silniki przy relaksacji krawedzi;
+  - krawedz incydentna z wezlem zablokowanym jest zamknieta (w tym krawedzie
+    wezla startowego - z zablokowanego wezla nie da sie wyjsc);
+  - zablokowane wezly i wezly, z ktorych wychodza zmienione krawedzie, to
+    mapy bitowe, a zmienione krawedzie - niewielka tablica uporzadkowana wg
+    wezla poczatkowego i koncowego; relaksacja krawedzi wezla bez zmian
+    kosztuje wiec jedynie sprawdzenie dwoch bitow, a wage zmienionej
+    krawedzi odczytuje sie wyszukiwaniem binarnym;
+  - utworzenie nakladki kosztuje O(n / 64), a kazda zmiana - O(k), gdzie k to
+    ilosc zmienionych krawedzi, wiec nakladke tworzy sie tanio dla kazdego
+    zapytania;
+  - w grafie nieskierowanym zmiana krawedzi obowiazuje w obu kierunkach;
+  - nakladka jest podczas obliczen jedynie odczytywana, a graf pozostaje
+    niezmieniony - wiele zapytan "what-if" (kazde z wlasnym dziennikiem
+    obliczen i wlasna nakladka) moze wiec przebiegac rownolegle na jednym,
+    wspolnym grafie;
+  - wyniki obliczen wstepnych (hierarchia skrotow, flagi krawedzi, etykiety
+    wezlow, tablice dystansow) dotycza grafu bez zmian, wiec z nakladka nie
+    sa uzywane; potencjaly ALT pozostaja poprawne, o ile zadnej wagi nie
+    obnizono.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include "common.h"
+#include "graph.h"
+#include "overlay.h"
+
+
+TOverlay* initOverlay(TGraph *G) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub graf nie ma modelu)
+    if (G == NULL || G->profile == NULL)
+        return NULL;
+
+    // Alokacja nowej nakladki ...
+    TOverlay *O = new TOverlay;
+    O->length = G->order;
+    O->directed = (G->profile[gpDirected] > 0);
+    O->lowered = false;
+    O->maxWeight = 0;
+
+    // Alias na ilosc slow map bitowych
+    const int words = (O->length + 63) / 64;
+
+    // ... z alokacja (pustych) map bitowych wezlow ...
+    O->blocked = new UINT64[words];
+    O->tails = new UINT64[words];
+    for (int w = 0; w < words; w++)
+        O->blocked[w] = O->tails[w] = 0;
+    // ... i (pustej) tablicy zmienionych krawedzi
+    O->count = 0;
+    O->capacity = 8;
+    O->arcs = new TEdge[O->capacity];
+
+    // Zwrocenie wskaznika na zainicjowana nakladke
+    return O;
+}
+
+
+void killOverlay(TOverlay* &O) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (O == NULL)
+        return;
+
+    // Skasowanie map bitowych i tablicy zmienionych krawedzi ...
+    delete[] O->blocked;
+    delete[] O->tails;
+    delete[] O->arcs;
+    O->blocked = NULL;
+    O->tails = NULL;
+    O->arcs = NULL;
+
+    // ... i nakladki oraz zwrocenie przez parametr wyzerowanego wskaznika
+    delete O;
+    O = NULL;
+}
+
+
+void clearOverlay(TOverlay *O) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (O == NULL)
+        return;
+
+    // Wyzerowanie map bitowych i tablicy zmienionych krawedzi (bez
+    // kasowania, do ponownego uzycia nakladki)
+    for (int w = 0; w < (O->length + 63) / 64; w++)
+        O->blocked[w] = O->tails[w] = 0;
+    O->count = 0;
+    O->lowered = false;
+    O->maxWeight = 0;
+}
+
+
+int _overlayPos(TOverlay *O, int startId, int stopId) {
+    // Wyszukiwanie binarne pozycji krawedzi w tablicy zmienionych krawedzi
+    // (pierwsza pozycja nie mniejsza niz para wezlow krawedzi)
+    int lo = 0;
+    int hi = O->count;
+    while (lo < hi) {
+        int mid = (lo + hi) / 2;
+        TEdge &e = O->arcs[mid];
+        if (e.startId < startId || (e.startId == startId && e.stopId < stopId))
+             lo = mid +1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+
+int overlayArc(TOverlay *O, TGraph *G, int startId, int stopId) {
+    // Odczyt wagi krawedzi z tablicy zmienionych krawedzi, ...
+    int k = _overlayPos(O, startId, stopId);
+    if (k < O->count && O->arcs[k].startId == startId && O->arcs[k].stopId == stopId)
+        return O->arcs[k].weight;
+    // ... a gdy krawedzi nie zmieniono - z macierzy sasiedztwa
+    return edgeWeight(G, startId, stopId);
+}
+
+
+void _putArc(TOverlay *O, TGraph *G, int startId, int stopId, int weight) {
+    // Wyszukanie pozycji krawedzi w tablicy zmienionych krawedzi ...
+    int k = _overlayPos(O, startId, stopId);
+    // ... i nadpisanie wagi, gdy krawedz juz zmieniono, ...
+    if (k < O->count && O->arcs[k].startId == startId && O->arcs[k].stopId == stopId)
+        O->arcs[k].weight = weight;
+    else {
+        // ... a w przeciwnym razie (z ewentualnym powiekszeniem tablicy)
+        // wstawienie krawedzi na jej pozycje
+        if (O->count == O->capacity) {
+            TEdge *larger = new TEdge[2 * O->capacity];
+            for (int i = 0; i < O->count; i++)
+                larger[i] = O->arcs[i];
+            delete[] O->arcs;
+            O->arcs = larger;
+            O->capacity *= 2;
+        }
+        for (int i = O->count; i > k; i--)
+            O->arcs[i] = O->arcs[i -1];
+        O->arcs[k].startId = startId;
+        O->arcs[k].stopId = stopId;
+        O->arcs[k].weight = weight;
+        O->count++;
+    }
+    // Oznaczenie wezla poczatkowego jako wezla ze zmienionymi krawedziami
+    O->tails[startId >> 6] |= (UINT64)1 << (startId & 63);
+    // (obnizenie wagi uniewaznia dolne ograniczenia dystansow, a wage
+    // wieksza od wag grafu musza pomiescic kolejki priorytetowe)
+    if (weight > 0 && weight < edgeWeight(G, startId, stopId))
+        O->lowered = true;
+    if (weight > O->maxWeight)
+        O->maxWeight = weight;
+}
+
+
+bool blockNode(TOverlay *O, int Id) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub Id spoza zakresu)
+    if (O == NULL || Id < 0 || Id >= O->length)
+        return false;
+
+    // Zablokowanie wezla
+    O->blocked[Id >> 6] |= (UINT64)1 << (Id & 63);
+    return true;
+}
+
+
+bool reweightEdge(TOverlay *O, TGraph *G, int startId, int stopId, int weight) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub nakladka nie dotyczy
+    // grafu)
+    if (O == NULL || G == NULL || O->length != G->order)
+        return false;
+    // Odrzucenie zmiany spoza zakresu Id wezlow, wagi ujemnej albo krawedzi
+    // nieistniejacej w grafie (nakladka nie dodaje krawedzi)
+    if (startId < 0 || startId >= O->length || stopId < 0 || stopId >= O->length
+                    || weight < 0 || edgeWeight(G, startId, stopId) == 0)
+        return false;
+
+    // Zapis zmiany krawedzi (w grafie nieskierowanym - w obu kierunkach)
+    _putArc(O, G, startId, stopId, weight);
+    if (! O->directed)
+        _putArc(O, G, stopId, startId, weight);
+    return true;
+}
+
+
+bool blockEdge(TOverlay *O, TGraph *G, int startId, int stopId) {
+    // Zamkniecie krawedzi, tj. zmiana jej wagi na 0
+    return reweightEdge(O, G, startId, stopId, 0);
+}
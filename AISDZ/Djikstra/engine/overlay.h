@@ -0,0 +1,79 @@
+#ifndef AC_ENGINE_OVERLAY_H
+#define AC_ENGINE_OVERLAY_H
+
+#include "common.h"
+#include "graph.h"
+
+
+/*
+  Struktura definiujaca nakladke zmian grafu ("what-if"), tj. zbior
+  zamknietych lub przewazonych krawedzi oraz zablokowanych wezlow,
+  uwzgledniany przy relaksacji krawedzi bez zmiany struktur grafu
+  length    - ilosc wezlow grafu
+  directed  - znacznik grafu skierowanego (w nieskierowanym zmiany krawedzi
+              obowiazuja w obu kierunkach)
+  lowered   - znacznik obnizenia wagi ktorejkolwiek krawedzi (wowczas
+              potencjaly ALT nie ograniczaja dystansow od dolu)
+  maxWeight - najwieksza waga krawedzi zmienionych w nakladce
+  blocked   - mapa bitowa wezlow zablokowanych (po 64 wezly w slowie)
+  tails     - mapa bitowa wezlow, z ktorych wychodza zmienione krawedzie
+  count     - ilosc zmienionych krawedzi
+  capacity  - pojemnosc tablicy zmienionych krawedzi
+  arcs      - tablica zmienionych krawedzi, uporzadkowana wg wezla
+              poczatkowego i koncowego (waga 0 - krawedz zamknieta)
+*/
+struct TOverlay {
+    int length;
+    bool directed;
+    bool lowered;
+    int maxWeight;
+    UINT64 *blocked;
+    UINT64 *tails;
+    int count;
+    int capacity;
+    TEdge *arcs;
+};
+
+
+int overlayArc(TOverlay *O, TGraph *G, int startId, int stopId);
+
+
+inline bool isBlocked(TOverlay *O, int Id) {
+    // Sprawdzenie czy wezel o podanym Id jest zablokowany
+    return (O != NULL) && ((O->blocked[Id >> 6] >> (Id & 63)) & 1);
+}
+
+inline int arcWeight(TOverlay *O, TGraph *G, int startId, int stopId) {
+    // Bez nakladki - waga krawedzi z macierzy sasiedztwa
+    if (O == NULL)
+        return edgeWeight(G, startId, stopId);
+    // Krawedz incydentna z wezlem zablokowanym jest zamknieta (waga 0)
+    if (((O->blocked[startId >> 6] >> (startId & 63)) & 1)
+     || ((O->blocked[stopId >> 6] >> (stopId & 63)) & 1))
+        return 0;
+    // Waga z nakladki (o ile zmieniono krawedzie wychodzace z wezla
+    // poczatkowego), a w przeciwnym razie - z macierzy sasiedztwa
+    if ((O->tails[startId >> 6] >> (startId & 63)) & 1)
+        return overlayArc(O, G, startId, stopId);
+    return edgeWeight(G, startId, stopId);
+}
+
+inline int maxArcWeight(TOverlay *O, TGraph *G) {
+    // Zwrocenie najwiekszej wagi krawedzi grafu z uwzglednieniem nakladki
+    // (np. do ustalenia ilosci kubelkow kolejki priorytetowej)
+    if (O != NULL && O->maxWeight > G->profile[gpMaxWeight])
+        return O->maxWeight;
+    return G->profile[gpMaxWeight];
+}
+
+
+TOverlay* initOverlay(TGraph *G);
+void killOverlay(TOverlay* &O);
+void clearOverlay(TOverlay *O);
+
+bool blockNode(TOverlay *O, int Id);
+bool blockEdge(TOverlay *O, TGraph *G, int startId, int stopId);
+bool reweightEdge(TOverlay *O, TGraph *G, int startId, int stopId, int weight);
+
+
+#endif // AC_ENGINE_OVERLAY_H
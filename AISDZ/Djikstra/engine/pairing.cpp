@@ -0,0 +1,201 @@
+/* ----------------------------------------------------------------------------
+
+  Kopiec parujacy (ang. pairing heap) typu minimalnego
+
+  UWAGI:
+  - kopiec przechowuje identyfikatory (Id) elementow z zakresu od 0 do n-1
+    wraz z ich kluczami;
+  - kopiec to drzewo wielokierunkowe, w ktorym potomkowie kazdego elementu
+    tworza liste dwukierunkowa (pierwszy potomek wskazuje wstecz na rodzica);
+  - wprowadzenie elementu i zmniejszenie klucza to odciecie poddrzewa
+    i polaczenie go ze szczytem kopca - O(1);
+  - zdjecie elementu ze szczytu laczy jego potomkow w pary (od lewej do
+    prawej), a nastepnie laczy powstale poddrzewa od prawej do lewej -
+    zamortyzowany koszt O(log n);
+  - licznik operacji zlicza laczenia poddrzew;
+  - dowiazania elementu ustawiane sa przy jego wprowadzeniu do kopca, a zdjecie
+    elementu ze szczytu przywraca jego znacznik "poza kopcem" - kopiec
+    oprozniony zdejmowaniem elementow nadaje sie wiec do ponownego uzycia bez
+    przegladu tablic, a kopiec niepusty oproznia sie funkcja pairingClear,
+    w czasie proporcjonalnym do ilosci elementow pozostawionych w kopcu.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include "common.h"
+#include "pairing.h"
+
+
+TPairingHeap* initPairingHeap(int n) {
+    // Alokacja nowego kopca, ...
+    TPairingHeap *H = new TPairingHeap;
+    // ... z wyzerowaniem licznikow
+    H->size = 0;
+    H->root = -1;
+    H->sifts = 0;
+
+    // Alokacja tablic dowiazan, znacznikow i kluczy elementow
+    H->child = new int[n];
+    H->sibling = new int[n];
+    H->prev = new int[n];
+    H->inside = new bool[n];
+    H->keys = new INT64[n];
+    // Oznaczenie wszystkich elementow jako "poza kopcem"
+    for (int i = 0; i < n; i++)
+        H->inside[i] = false;
+
+    // Zwrocenie wskaznika na zainicjowany kopiec
+    return H;
+}
+
+
+void killPairingHeap(TPairingHeap* &H) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (H == NULL)
+        return;
+
+    // Skasowanie tablic kopca, ...
+    delete[] H->child;
+    delete[] H->sibling;
+    delete[] H->prev;
+    delete[] H->inside;
+    delete[] H->keys;
+
+    // ... a nastepnie kopca i zwrocenie przez parametr wyzerowanego wskaznika
+    delete H;
+    H = NULL;
+}
+
+
+void pairingClear(TPairingHeap *H) {
+    // Przejscie po drzewie kopca od szczytu (elementy do odwiedzenia tworza
+    // liste wiazana przez "sibling") ...
+    int pending = H->root;
+    while (pending != -1) {
+        int Id = pending;
+        pending = H->sibling[Id];
+        // ... z oznaczeniem kazdego elementu jako "poza kopcem" ...
+        H->inside[Id] = false;
+        // ... i dopisaniem jego potomkow do listy elementow do odwiedzenia
+        int c = H->child[Id];
+        while (c != -1) {
+            int nextC = H->sibling[c];
+            H->sibling[c] = pending;
+            pending = c;
+            c = nextC;
+        }
+    }
+    // Wyzerowanie licznikow
+    H->size = 0;
+    H->root = -1;
+    H->sifts = 0;
+}
+
+
+int _link(TPairingHeap *H, int a, int b) {
+    // Zakonczenie, gdy ktores z poddrzew jest puste
+    if (a == -1)
+        return b;
+    if (b == -1)
+        return a;
+
+    H->sifts++;
+    // Ustalenie, ktore poddrzewo ma mniejszy klucz w korzeniu ...
+    if (H->keys[b] < H->keys[a]) {
+        int x = a;
+                a = b;
+                    b = x;
+    }
+    // ... i podpiecie drugiego poddrzewa jako pierwszego potomka
+    H->sibling[b] = H->child[a];
+    if (H->child[a] != -1)
+        H->prev[H->child[a]] = b;
+    H->prev[b] = a;
+    H->child[a] = b;
+    H->sibling[a] = -1;
+    H->prev[a] = -1;
+
+    // Zwrocenie korzenia polaczonego drzewa
+    return a;
+}
+
+
+void pairingPush(TPairingHeap *H, int Id, INT64 key) {
+    // Utworzenie jednoelementowego poddrzewa ...
+    H->keys[Id] = key;
+    H->child[Id] = -1;
+    H->sibling[Id] = -1;
+    H->prev[Id] = -1;
+    H->inside[Id] = true;
+    // ... i polaczenie go ze szczytem kopca
+    H->root = _link(H, H->root, Id);
+    H->size++;
+}
+
+
+int pairingPop(TPairingHeap *H) {
+    // Zakonczenie, gdy kopiec jest pusty
+    if (H->size == 0)
+        return -1;
+
+    // Zapamietanie elementu ze szczytu kopca ...
+    int Id = H->root;
+    H->inside[Id] = false;
+    H->size--;
+
+    // ... i polaczenie jego potomkow w pary, od lewej do prawej
+    // (korzenie par tworza liste wiazana przez "sibling" w odwrotnej kolejnosci)
+    int pairs = -1;
+    int c = H->child[Id];
+    while (c != -1) {
+        int a = c;
+        int b = H->sibling[a];
+        c = (b != -1) ? H->sibling[b] : -1;
+        H->sibling[a] = -1;
+        if (b != -1)
+            H->sibling[b] = -1;
+        int r = _link(H, a, b);
+        H->sibling[r] = pairs;
+        pairs = r;
+    }
+    // Polaczenie par w jedno drzewo, od prawej do lewej
+    int root = -1;
+    while (pairs != -1) {
+        int nextPair = H->sibling[pairs];
+        H->sibling[pairs] = -1;
+        root = _link(H, root, pairs);
+        pairs = nextPair;
+    }
+    H->root = root;
+    if (root != -1)
+        H->prev[root] = -1;
+
+    // Zwrocenie Id elementu, ktory byl na szczycie
+    return Id;
+}
+
+
+void decreaseKey(TPairingHeap *H, int Id, INT64 key) {
+    // Zakonczenie, gdy elementu nie ma w kopcu lub klucz nie maleje
+    if (! H->inside[Id] || key >= H->keys[Id])
+        return;
+
+    // Zapis nowego (mniejszego) klucza, ...
+    H->keys[Id] = key;
+    // ... przy czym zmiana klucza w korzeniu nie narusza struktury kopca
+    if (Id == H->root)
+        return;
+
+    // Odciecie poddrzewa elementu od rodzica (lub poprzedniego rodzenstwa) ...
+    int p = H->prev[Id];
+    if (H->child[p] == Id)
+        H->child[p] = H->sibling[Id];
+    else H->sibling[p] = H->sibling[Id];
+    if (H->sibling[Id] != -1)
+        H->prev[H->sibling[Id]] = p;
+    H->sibling[Id] = -1;
+    H->prev[Id] = -1;
+    // ... i polaczenie go ze szczytem kopca
+    H->root = _link(H, H->root, Id);
+}
@@ -0,0 +1,52 @@
+#ifndef AC_ENGINE_PAIRING_H
+#define AC_ENGINE_PAIRING_H
+
+#include "common.h"
+
+
+/*
+  Struktura definiujaca kopiec parujacy (ang. pairing heap) typu minimalnego
+  size      - ilosc elementow w kopcu
+  root      - Id elementu na szczycie kopca (-1 - kopiec pusty)
+  child     - n-elementowa tablica Id pierwszych potomkow elementow
+  sibling   - n-elementowa tablica Id nastepnego rodzenstwa elementow
+  prev      - n-elementowa tablica Id poprzedniego rodzenstwa elementow
+              (dla pierwszego potomka - Id rodzica)
+  inside    - n-elementowa tablica znacznikow obecnosci elementow w kopcu
+  keys      - n-elementowa tablica kluczy (priorytetow) elementow
+  sifts     - licznik operacji laczenia poddrzew
+*/
+struct TPairingHeap {
+    int size;
+    int root;
+    int *child;
+    int *sibling;
+    int *prev;
+    bool *inside;
+    INT64 *keys;
+    INT64 sifts;
+};
+
+
+inline int pairingSize(TPairingHeap *H) {
+    // Zwrocenie ilosci elementow w kopcu
+    return H->size;
+}
+
+inline bool pairingContains(TPairingHeap *H, int Id) {
+    // Zwrocenie wartosci logicznej czy element o podanym Id jest w kopcu
+    return H->inside[Id];
+}
+
+
+TPairingHeap* initPairingHeap(int n);
+void killPairingHeap(TPairingHeap* &H);
+
+void pairingClear(TPairingHeap *H);
+
+void pairingPush(TPairingHeap *H, int Id, INT64 key);
+int pairingPop(TPairingHeap *H);
+void decreaseKey(TPairingHeap *H, int Id, INT64 key);
+
+
+#endif // AC_ENGINE_PAIRING_H
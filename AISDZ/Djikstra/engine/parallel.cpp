@@ -0,0 +1,119 @@
+/* ----------------------------------------------------------------------------
+
+  Rownolegle wykonywanie zadan
+
+  UWAGI:
+  - zadania to wywolania wspolnej funkcji z kolejnymi numerami zadan, przy
+    czym watki pobieraja numery zadan z licznika atomowego, dzieki czemu
+    zadania o roznym czasie wykonania rozkladaja sie rowno na watki;
+  - kazde wywolanie funkcji zadania otrzymuje numer watku, ktory je wykonuje,
+    co pozwala przydzielic kazdemu watkowi wlasne struktury robocze (np.
+    dziennik obliczen), wspoldzielac zas jedynie struktury tylko do odczytu
+    (np. graf);
+  - gdy liczba watkow wynosi 1 (albo jest jedno zadanie), zadania wykonywane
+    sa kolejno w watku wywolujacym;
+  - algorytmy przetwarzajace dane fazami uruchamiaja zespol watkow (kazdy
+    watek wykonuje dokladnie jedno zadanie, o numerze rownym numerowi watku),
+    a watki zespolu synchronizuja sie pomiedzy fazami na barierze; bariera
+    oczekuje aktywnie (z oddaniem czasu procesora), bo fazy sa krotkie.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <thread>
+#include <atomic>
+#include "common.h"
+#include "parallel.h"
+
+
+int hardwareThreads() {
+    // Ustalenie ilosci watkow sprzetowych (co najmniej 1)
+    int t = (int)thread::hardware_concurrency();
+    return (t > 0) ? t : 1;
+}
+
+
+int workerCount(int threads, int count) {
+    // Ustalenie ilosci watkow roboczych, tj. zadanej ilosci watkow
+    // (0 - wszystkie watki sprzetowe), ale nie wiecej niz ilosc zadan
+    int t = (threads > 0) ? threads : hardwareThreads();
+    if (t > count)
+        t = count;
+    return (t > 0) ? t : 1;
+}
+
+
+void _runWorker(atomic<int> *next, int count, int worker, TTask task, void *context) {
+    // Pobieranie kolejnych numerow zadan z licznika i wykonywanie zadan,
+    // az do wyczerpania puli
+    for (int i = (*next)++; i < count; i = (*next)++)
+        task(context, i, worker);
+}
+
+
+void runParallel(int count, int threads, TTask task, void *context) {
+    // Ustalenie ilosci watkow roboczych
+    int t = workerCount(threads, count);
+
+    // Licznik numerow zadan wspolny dla wszystkich watkow
+    atomic<int> next(0);
+
+    // Gdy watek jest jeden - wykonanie zadan w watku wywolujacym, ...
+    if (t == 1) {
+        _runWorker(&next, count, 0, task, context);
+        return;
+    }
+    // ... w przeciwnym razie uruchomienie watkow roboczych (watek wywolujacy
+    // pracuje jako watek o numerze 0) ...
+    thread *workers = new thread[t -1];
+    for (int w = 1; w < t; w++)
+        workers[w -1] = thread(_runWorker, &next, count, w, task, context);
+    _runWorker(&next, count, 0, task, context);
+    // ... i oczekiwanie na zakonczenie ich pracy
+    for (int w = 1; w < t; w++)
+        workers[w -1].join();
+    delete[] workers;
+}
+
+
+void runTeam(int threads, TTask task, void *context) {
+    // Zakonczenie, gdy zespol jest pusty
+    if (threads < 1)
+        return;
+
+    // Uruchomienie watkow zespolu (watek wywolujacy pracuje jako watek
+    // o numerze 0), z ktorych kazdy wykonuje jedno zadanie o swoim numerze, ...
+    thread *workers = new thread[threads -1];
+    for (int w = 1; w < threads; w++)
+        workers[w -1] = thread(task, context, w, w);
+    task(context, 0, 0);
+    // ... i oczekiwanie na zakonczenie ich pracy
+    for (int w = 1; w < threads; w++)
+        workers[w -1].join();
+    delete[] workers;
+}
+
+
+void initBarrier(TBarrier *B, int count) {
+    // Ustawienie ilosci watkow zespolu i wyzerowanie stanu bariery
+    B->count = count;
+    B->waiting = 0;
+    B->phase = 0;
+}
+
+
+void waitBarrier(TBarrier *B) {
+    // Zapamietanie numeru biezacej fazy, ...
+    int phase = B->phase;
+    // ... przy czym ostatni z oczekujacych watkow zeruje licznik i otwiera
+    // bariere (przechodzac do nastepnej fazy), ...
+    if (++B->waiting == B->count) {
+        B->waiting = 0;
+        B->phase++;
+        return;
+    }
+    // ... a pozostale czekaja az faza sie zmieni
+    while (B->phase == phase)
+        this_thread::yield();
+}
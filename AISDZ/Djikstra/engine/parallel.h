@@ -0,0 +1,41 @@
+#ifndef AC_ENGINE_PARALLEL_H
+#define AC_ENGINE_PARALLEL_H
+
+#include <atomic>
+#include "common.h"
+
+
+/*
+  Typ funkcji zadania wykonywanego rownolegle
+  context   - wspolny kontekst wszystkich zadan (dane wejsciowe i wyjsciowe)
+  index     - numer zadania (od 0 do count-1)
+  worker    - numer watku wykonujacego zadanie (od 0 do threads-1), np. do
+              wyboru struktur roboczych przydzielonych watkowi
+*/
+typedef void (*TTask)(void *context, int index, int worker);
+
+
+/*
+  Struktura definiujaca bariere synchronizacji zespolu watkow
+  count     - ilosc watkow zespolu
+  waiting   - ilosc watkow oczekujacych na barierze
+  phase     - numer biezacej fazy (zwiekszany przy kazdym przejsciu bariery)
+*/
+struct TBarrier {
+    int count;
+    atomic<int> waiting;
+    atomic<int> phase;
+};
+
+
+int hardwareThreads();
+int workerCount(int threads, int count);
+
+void runParallel(int count, int threads, TTask task, void *context);
+void runTeam(int threads, TTask task, void *context);
+
+void initBarrier(TBarrier *B, int count);
+void waitBarrier(TBarrier *B);
+
+
+#endif // AC_ENGINE_PARALLEL_H
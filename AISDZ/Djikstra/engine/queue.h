@@ -0,0 +1,241 @@
+#ifndef AC_ENGINE_QUEUE_H
+#define AC_ENGINE_QUEUE_H
+
+#include "common.h"
+#include "heap.h"
+#include "pairing.h"
+#include "bucket.h"
+
+
+/*
+  Enumerator rodzajow kolejki priorytetowej
+  qkBinaryHeap  - indeksowany kopiec binarny
+  qkQuadHeap    - indeksowany kopiec 4-arny (wyrownany do linii pamieci)
+  qkPairingHeap - kopiec parujacy
+  qkBuckets     - kolejka kubelkowa Diala (niewielkie wagi krawedzi)
+  qkRadix       - kopiec pozycyjny (dowolne nieujemne wagi krawedzi)
+  qkArray       - tablica dystansow przegladana liniowo (grafy geste; obsluguje
+                  ja osobny silnik eksploracji grafu w przod, pozostale silniki
+                  uzywaja w jej miejsce kopca binarnego)
+  qkBitset      - maska bitowa wezlow osiagnietych (grafy do BITSET_ORDER
+                  wezlow; obsluguje ja osobny silnik eksploracji grafu,
+                  pozostale silniki uzywaja w jej miejsce kopca binarnego)
+*/
+enum EQueueKind {
+    qkBinaryHeap,
+    qkQuadHeap,
+    qkPairingHeap,
+    qkBuckets,
+    qkRadix,
+    qkArray,
+    qkBitset
+};
+
+
+#define BITSET_ORDER  64
+
+// Najwieksza waga krawedzi, przy ktorej uzywa sie kolejki kubelkowej Diala
+// (przy wiekszych wagach silniki zastepuja ja kopcem pozycyjnym)
+#define DIAL_MAX_WEIGHT  1024
+
+
+// *** Otoczki funkcji kolejek - jednolity interfejs kolejki priorytetowej
+//   (elementami kolejki sa Id wezlow, a kluczami ich dystanse), na ktorym
+//   opiera sie szablon silnika obliczeniowego DSP ***
+
+
+inline void initQueue(TIndexHeap* &Q, int n, int) {
+    // Alokacja indeksowanego kopca binarnego (podobnie jak dla pozostalych
+    // kopcow, najwieksza waga krawedzi nie ma tu znaczenia)
+    Q = initIndexHeap(n);
+}
+
+inline void initQueue(TQuadHeap* &Q, int n, int) {
+    // Alokacja indeksowanego kopca 4-arnego
+    Q = initQuadHeap(n);
+}
+
+inline void initQueue(TPairingHeap* &Q, int n, int) {
+    // Alokacja kopca parujacego
+    Q = initPairingHeap(n);
+}
+
+inline void initQueue(TBucketQueue* &Q, int n, int maxWeight) {
+    // Alokacja kolejki kubelkowej Diala (ilosc kubelkow zalezy od najwiekszej
+    // wagi krawedzi)
+    Q = initBucketQueue(n, maxWeight);
+}
+
+inline void initQueue(TRadixHeap* &Q, int n, int) {
+    // Alokacja kopca pozycyjnego
+    Q = initRadixHeap(n);
+}
+
+inline void killQueue(TIndexHeap* &Q) {
+    // Skasowanie indeksowanego kopca binarnego
+    killIndexHeap(Q);
+}
+
+inline void killQueue(TQuadHeap* &Q) {
+    // Skasowanie indeksowanego kopca 4-arnego
+    killQuadHeap(Q);
+}
+
+inline void killQueue(TPairingHeap* &Q) {
+    // Skasowanie kopca parujacego
+    killPairingHeap(Q);
+}
+
+inline void killQueue(TBucketQueue* &Q) {
+    // Skasowanie kolejki kubelkowej Diala
+    killBucketQueue(Q);
+}
+
+inline void killQueue(TRadixHeap* &Q) {
+    // Skasowanie kopca pozycyjnego
+    killRadixHeap(Q);
+}
+
+inline void clearQueue(TIndexHeap *Q) {
+    // Oproznienie indeksowanego kopca binarnego (do ponownego uzycia)
+    heapClear(Q);
+}
+
+inline void clearQueue(TQuadHeap *Q) {
+    // Oproznienie indeksowanego kopca 4-arnego
+    heapClear(Q);
+}
+
+inline void clearQueue(TPairingHeap *Q) {
+    // Oproznienie kopca parujacego
+    pairingClear(Q);
+}
+
+inline void clearQueue(TBucketQueue *Q) {
+    // Oproznienie kolejki kubelkowej Diala
+    bucketClear(Q);
+}
+
+inline void clearQueue(TRadixHeap *Q) {
+    // Oproznienie kopca pozycyjnego
+    radixClear(Q);
+}
+
+inline int queueSize(TIndexHeap *Q) {
+    // Zwrocenie ilosci elementow w indeksowanym kopcu binarnym
+    return heapSize(Q);
+}
+
+inline int queueSize(TQuadHeap *Q) {
+    // Zwrocenie ilosci elementow w indeksowanym kopcu 4-arnym
+    return heapSize(Q);
+}
+
+inline int queueSize(TPairingHeap *Q) {
+    // Zwrocenie ilosci elementow w kopcu parujacym
+    return pairingSize(Q);
+}
+
+inline int queueSize(TBucketQueue *Q) {
+    // Zwrocenie ilosci elementow w kolejce kubelkowej Diala
+    return bucketSize(Q);
+}
+
+inline int queueSize(TRadixHeap *Q) {
+    // Zwrocenie ilosci elementow w kopcu pozycyjnym
+    return radixSize(Q);
+}
+
+inline bool queued(TIndexHeap *Q, int Id) {
+    // Zwrocenie wartosci logicznej czy wezel oczekuje w indeksowanym kopcu binarnym
+    return heapContains(Q, Id);
+}
+
+inline bool queued(TQuadHeap *Q, int Id) {
+    // Zwrocenie wartosci logicznej czy wezel oczekuje w indeksowanym kopcu 4-arnym
+    return heapContains(Q, Id);
+}
+
+inline bool queued(TPairingHeap *Q, int Id) {
+    // Zwrocenie wartosci logicznej czy wezel oczekuje w kopcu parujacym
+    return pairingContains(Q, Id);
+}
+
+inline bool queued(TBucketQueue *Q, int Id) {
+    // Zwrocenie wartosci logicznej czy wezel oczekuje w kolejce kubelkowej Diala
+    return bucketContains(Q, Id);
+}
+
+inline bool queued(TRadixHeap *Q, int Id) {
+    // Zwrocenie wartosci logicznej czy wezel oczekuje w kopcu pozycyjnym
+    return radixContains(Q, Id);
+}
+
+inline void enqueue(TIndexHeap *Q, int Id, INT64 key) {
+    // Wprowadzenie wezla do indeksowanego kopca binarnego
+    heapPush(Q, Id, key);
+}
+
+inline void enqueue(TQuadHeap *Q, int Id, INT64 key) {
+    // Wprowadzenie wezla do indeksowanego kopca 4-arnego
+    heapPush(Q, Id, key);
+}
+
+inline void enqueue(TPairingHeap *Q, int Id, INT64 key) {
+    // Wprowadzenie wezla do kopca parujacego
+    pairingPush(Q, Id, key);
+}
+
+inline void enqueue(TBucketQueue *Q, int Id, INT64 key) {
+    // Wprowadzenie wezla do kolejki kubelkowej Diala
+    bucketPush(Q, Id, key);
+}
+
+inline void enqueue(TRadixHeap *Q, int Id, INT64 key) {
+    // Wprowadzenie wezla do kopca pozycyjnego
+    radixPush(Q, Id, key);
+}
+
+inline int dequeue(TIndexHeap *Q) {
+    // Wyjecie z indeksowanego kopca binarnego wezla o najmniejszym kluczu
+    return heapPop(Q);
+}
+
+inline int dequeue(TQuadHeap *Q) {
+    // Wyjecie z indeksowanego kopca 4-arnego wezla o najmniejszym kluczu
+    return heapPop(Q);
+}
+
+inline int dequeue(TPairingHeap *Q) {
+    // Wyjecie z kopca parujacego wezla o najmniejszym kluczu
+    return pairingPop(Q);
+}
+
+inline int dequeue(TBucketQueue *Q) {
+    // Wyjecie z kolejki kubelkowej Diala wezla o najmniejszym kluczu
+    return bucketPop(Q);
+}
+
+inline int dequeue(TRadixHeap *Q) {
+    // Wyjecie z kopca pozycyjnego wezla o najmniejszym kluczu
+    return radixPop(Q);
+}
+
+
+template <typename TQueue>
+inline void requeue(TQueue *Q, int Id, INT64 key) {
+    // Uaktualnienie pozycji elementu w kolejce priorytetowej (po zmniejszeniu
+    // klucza) albo wprowadzenie go do kolejki, gdy jeszcze w niej nie byl
+    if (queued(Q, Id))
+        decreaseKey(Q, Id, key);
+    else enqueue(Q, Id, key);
+}
+
+template <typename TQueue>
+inline INT64 queueSifts(TQueue *Q) {
+    // Zwrocenie ilosci operacji porzadkowania kolejki priorytetowej
+    return Q->sifts;
+}
+
+
+#endif // AC_ENGINE_QUEUE_H
@@ -0,0 +1,180 @@
+/* ----------------------------------------------------------------------------
+
+  TDistTable - tablica dystansow od wszystkich wezlow zrodlowych (rownolegla
+  n-krotna eksploracja grafu algorytmem Dijkstry)
+
+  UWAGI:
+  - kazdy wezel zrodlowy to osobne zadanie, a kazdy watek ma wlasny dziennik
+    obliczen (uzywany ponownie we wszystkich swoich zadaniach), natomiast
+    graf jest wspoldzielony tylko do odczytu;
+  - wynik zadania (wiersz dystansow) zapisywany jest od razu do wczesniej
+    przydzielonej tablicy 32-bitowej - watki zapisuja rozlaczne wiersze, wiec
+    nie wymagaja synchronizacji;
+  - tablica moze byc odwzorowana w pamieci z pliku na dysku (plik binarny:
+    n*n liczb 32-bitowych, wierszami), dzieki czemu wyniki trafiaja wprost
+    do pliku, a wielkosc tablicy nie jest ograniczona pamiecia operacyjna;
+    odwzorowanie realizuja funkcje systemu Windows albo POSIX.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include "common.h"
+#include "table.h"
+#include "dsp.h"
+#include "parallel.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#endif
+
+using namespace std::chrono;
+
+
+/*
+  Struktura kontekstu zadan rownoleglych (jedno zadanie - jeden wezel
+  zrodlowy)
+  G         - graf (tylko do odczytu)
+  T         - tablica dystansow (wynik)
+  journals  - dzienniki obliczen poszczegolnych watkow
+  settled   - ilosci zwiedzonych wezlow (osobno dla kazdego z watkow)
+*/
+struct TSourcesTask {
+    TGraph *G;
+    TDistTable *T;
+    TJournal **journals;
+    INT64 *settled;
+};
+
+
+UINT32* _mapFile(string filename, INT64 size) {
+    // Utworzenie pliku o podanej wielkosci i odwzorowanie go w pamieci
+    // (zwraca NULL, gdy sie nie powiodlo)
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(filename.c_str(), GENERIC_READ | GENERIC_WRITE, 0, NULL,
+                              CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE)
+        return NULL;
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READWRITE,
+                                        (DWORD)(size >> 32), (DWORD)(size & 0xffffffff), NULL);
+    void *view = (mapping != NULL) ? MapViewOfFile(mapping, FILE_MAP_WRITE, 0, 0, 0) : NULL;
+    // (odwzorowanie pozostaje wazne po zamknieciu uchwytow)
+    if (mapping != NULL)
+        CloseHandle(mapping);
+    CloseHandle(file);
+    return (UINT32 *)view;
+#else
+    int fd = open(filename.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+        return NULL;
+    void *view = MAP_FAILED;
+    if (ftruncate(fd, size) == 0)
+        view = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    // (odwzorowanie pozostaje wazne po zamknieciu pliku)
+    close(fd);
+    return (view != MAP_FAILED) ? (UINT32 *)view : NULL;
+#endif
+}
+
+
+void _unmapFile(UINT32 *view, INT64 size) {
+    // Zakonczenie odwzorowania pliku w pamieci (z zapisem zmian na dysku)
+#if defined(_WIN32)
+    UnmapViewOfFile(view);
+#else
+    munmap(view, size);
+#endif
+}
+
+
+void _sourceTask(void *context, int index, int worker) {
+    TSourcesTask *S = (TSourcesTask *)context;
+    // Aliasy na rzad grafu i dziennik obliczen watku
+    const int &n = S->G->order;
+    TJournal *J = S->journals[worker];
+
+    // Eksploracja grafu z wezla zrodlowego ...
+    exploreGraph(J, S->G, index);
+    S->settled[worker] += J->settled;
+    // ... i zapis dystansow w wierszu tablicy
+    UINT32 *row = S->T->dist + (INT64)index * n;
+    for (int v = 0; v < n; v++) {
+        INT64 d = entryDistance(J, v);
+        row[v] = (d != 2147483647) ? (UINT32)d : TABLE_NONE;
+    }
+}
+
+
+TDistTable* initDistTable(TGraph *G, int queue, int threads, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (G == NULL || G->order == 0)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowej tablicy dystansow - w pamieci operacyjnej albo
+    // odwzorowanej z pliku o podanej nazwie
+    TDistTable *T = new TDistTable;
+    T->length = n;
+    T->memory = (INT64)n * n * sizeof(UINT32);
+    T->mapped = (filename != "");
+    if (T->mapped) {
+        T->dist = _mapFile(filename, T->memory);
+        // Zakonczenie, gdy odwzorowanie pliku sie nie powiodlo
+        if (T->dist == NULL) {
+            delete T;
+            return NULL;
+        }
+    }
+    else T->dist = new UINT32[(INT64)n * n];
+
+    // Dzienniki obliczen dla kazdego z watkow ...
+    int t = workerCount(threads, n);
+    TSourcesTask S = { G, T, new TJournal*[t], new INT64[t] };
+    for (int w = 0; w < t; w++) {
+        S.journals[w] = initJournal(n);
+        S.journals[w]->queue = queue;
+        S.settled[w] = 0;
+    }
+    // ... i uruchomienie obliczen (po jednym zadaniu na wezel zrodlowy)
+    runParallel(n, t, _sourceTask, &S);
+
+    // Zapamietanie statystyki obliczen (laczna ilosc zwiedzonych wezlow
+    // i czas obliczen) ...
+    T->settled = 0;
+    for (int w = 0; w < t; w++)
+        T->settled += S.settled[w];
+    T->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+    // ... i skasowanie dziennikow obliczen watkow
+    for (int w = 0; w < t; w++)
+        killJournal(S.journals[w]);
+    delete[] S.journals;
+    delete[] S.settled;
+
+    // Zwrocenie wskaznika na wyznaczona tablice dystansow
+    return T;
+}
+
+
+void killDistTable(TDistTable* &T) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (T == NULL)
+        return;
+
+    // Skasowanie tablicy (albo zakonczenie jej odwzorowania z pliku)
+    // i zwrocenie przez parametr wyzerowanego wskaznika
+    if (T->mapped)
+         _unmapFile(T->dist, T->memory);
+    else delete[] T->dist;
+    delete T;
+    T = NULL;
+}
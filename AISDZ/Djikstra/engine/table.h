@@ -0,0 +1,50 @@
+#ifndef AC_ENGINE_TABLE_H
+#define AC_ENGINE_TABLE_H
+
+#include <string>
+#include "common.h"
+#include "graph.h"
+
+using namespace std;
+
+
+#define TABLE_NONE  0xffffffffu
+
+
+/*
+  Struktura definiujaca tablice dystansow od wszystkich wezlow zrodlowych
+  (wynik n-krotnej eksploracji grafu algorytmem Dijkstry)
+  length    - ilosc wezlow grafu
+  dist      - (n*n)-elementowa tablica dystansow 32-bitowych bez znaku
+              (wierszami - od kolejnych wezlow zrodlowych), TABLE_NONE - brak
+              drogi; tablica moze byc odwzorowana w pamieci z pliku na dysku
+  mapped    - znacznik tablicy odwzorowanej z pliku (zapis tablicy trafia
+              bezposrednio do pliku)
+  settled   - statystyka: laczna ilosc zwiedzonych wezlow
+  time      - statystyka: czas obliczen [us]
+  memory    - statystyka: pamiec (lub wielkosc pliku) zajmowana przez
+              tablice [B]
+*/
+struct TDistTable {
+    int length;
+    UINT32 *dist;
+    bool mapped;
+    INT64 settled;
+    INT64 time;
+    INT64 memory;
+};
+
+
+inline INT64 tableDistance(TDistTable *T, int startId, int stopId) {
+    // Zwrocenie dystansu od wezla startowego do koncowego (2147483647 - brak
+    // drogi, jak w dzienniku obliczen)
+    UINT32 d = T->dist[(INT64)startId * T->length + stopId];
+    return (d != TABLE_NONE) ? d : 2147483647;
+}
+
+
+TDistTable* initDistTable(TGraph *G, int queue, int threads, string filename);
+void killDistTable(TDistTable* &T);
+
+
+#endif // AC_ENGINE_TABLE_H
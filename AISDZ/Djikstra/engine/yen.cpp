@@ -0,0 +1,489 @@
+/* ----------------------------------------------------------------------------
+
+  TPathSet - k najkrotszych sciezek prostych pomiedzy para wezlow (algorytm
+  J.Y.Yena)
+
+  UWAGI:
+  - kolejna sciezka wyznaczana jest z poprzedniej: kazdy wezel poprzedniej
+    sciezki (z wyjatkiem koncowego) jest wezlem odgalezienia - sciezka
+    kandydujaca to korzen (poczatek poprzedniej sciezki do wezla
+    odgalezienia) przedluzony najkrotsza sciezka odgalezienia do wezla
+    koncowego, ktora omija wezly korzenia oraz krawedzie wychodzace z wezla
+    odgalezienia po sciezkach juz wyznaczonych o tym samym korzeniu;
+  - kolejna sciezka zostaje najkrotszy kandydat (przy remisie - o mniejszej
+    ilosci wezlow, a dalej - o mniejszych Id wezlow), a pozostali kandydaci
+    czekaja na nastepne iteracje;
+  - wyszukiwanie poprzedza jedno przeszukanie grafu wstecz od wezla
+    koncowego; drzewo najkrotszych sciezek do wezla koncowego daje od razu
+    pierwsza sciezke, a dla kazdego odgalezienia:
+    * jesli sciezka drzewa z wezla odgalezienia nie przechodzi przez wezly
+      ani krawedzie pominiete, to jest najkrotsza sciezka odgalezienia
+      (bez przeszukiwania grafu),
+    * w przeciwnym razie dystanse do wezla koncowego sa potencjalami
+      algorytmu A* - pominiecie wezlow i krawedzi moze dystanse jedynie
+      zwiekszyc, wiec potencjaly sa spojne, a przeszukanie obejmuje zwykle
+      niewielka czesc grafu;
+  - wezly i krawedzie pominiete to nakladka zmian grafu ("what-if"), wiec
+    graf nie jest zmieniany, a odgalezienia jednej iteracji sa od siebie
+    niezalezne - wyszukuje sie je rownolegle (kazdy watek ma wlasny
+    dziennik obliczen i wlasna nakladke), o ile przeszukania poprzedniej
+    iteracji zwiedzaly srednio co najmniej SPUR_PARALLEL_WORK wezlow
+    (przeszukania z potencjalami sa zwykle tak krotkie, ze uruchomienie
+    watkow kosztowaloby wiecej niz same obliczenia);
+  - wynik to zwarta tablica Id wezlow wszystkich sciezek wraz z tablica ich
+    poczatkow i dystansow.
+
+  Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
+
+---------------------------------------------------------------------------- */
+
+#include <chrono>
+#include "common.h"
+#include "yen.h"
+#include "overlay.h"
+#include "parallel.h"
+
+using namespace std::chrono;
+
+
+#define INF                  2147483647
+#define SPUR_PARALLEL_WORK   2048
+
+
+/*
+  Struktura definiujaca sciezke robocza algorytmu (wyznaczona albo
+  kandydujaca)
+  Ids       - tablica Id wezlow sciezki (od wezla startowego do koncowego)
+  length    - ilosc wezlow sciezki
+  cost      - dystans sciezki
+*/
+struct TYenPath {
+    int *Ids;
+    int length;
+    INT64 cost;
+};
+
+
+/*
+  Struktura definiujaca liste sciezek roboczych
+  count     - ilosc sciezek na liscie
+  size      - pojemnosc tablicy sciezek
+  paths     - tablica sciezek
+*/
+struct TYenList {
+    int count;
+    int size;
+    TYenPath *paths;
+};
+
+
+/*
+  Struktura kontekstu zadan rownoleglych (jedno zadanie - jeden wezel
+  odgalezienia poprzedniej sciezki)
+  G         - graf
+  R         - dziennik przeszukiwania wstecz od wezla koncowego (drzewo
+              najkrotszych sciezek do wezla koncowego i potencjaly)
+  stopId    - Id wezla koncowego
+  path      - poprzednia sciezka (zrodlo korzeni i wezlow odgalezien)
+  accepted  - lista sciezek juz wyznaczonych
+  journals  - dzienniki obliczen przydzielone poszczegolnym watkom
+  overlays  - nakladki zmian grafu przydzielone poszczegolnym watkom
+  spurs     - sciezki odgalezien wg numeru wezla odgalezienia (wyniki; Ids
+              NULL - brak sciezki)
+  searched  - znaczniki przeszukania grafu wg numeru wezla odgalezienia
+  settled   - ilosci zwiedzonych wezlow wg numeru wezla odgalezienia
+*/
+struct TSpurTask {
+    TGraph *G;
+    TJournal *R;
+    int stopId;
+    TYenPath *path;
+    TYenList *accepted;
+    TJournal **journals;
+    TOverlay **overlays;
+    TYenPath *spurs;
+    bool *searched;
+    int *settled;
+};
+
+
+void _appendPath(TYenList &L, TYenPath &P) {
+    // Dopisanie sciezki do listy (z ewentualnym powiekszeniem tablicy)
+    if (L.count == L.size) {
+        int size = (L.size > 0) ? 2 * L.size : 8;
+        TYenPath *larger = new TYenPath[size];
+        for (int i = 0; i < L.count; i++)
+            larger[i] = L.paths[i];
+        delete[] L.paths;
+        L.paths = larger;
+        L.size = size;
+    }
+    L.paths[L.count++] = P;
+}
+
+
+bool _samePath(TYenPath &A, TYenPath &B) {
+    // Sprawdzenie czy sciezki przechodza przez te same wezly
+    if (A.length != B.length)
+        return false;
+    for (int i = 0; i < A.length; i++)
+        if (A.Ids[i] != B.Ids[i])
+            return false;
+    return true;
+}
+
+
+bool _betterPath(TYenPath &A, TYenPath &B) {
+    // Porownanie sciezek: mniejszy dystans, przy remisie - mniej wezlow,
+    // a dalej - mniejsze Id wezlow
+    if (A.cost != B.cost)
+        return A.cost < B.cost;
+    if (A.length != B.length)
+        return A.length < B.length;
+    for (int i = 0; i < A.length; i++)
+        if (A.Ids[i] != B.Ids[i])
+            return A.Ids[i] < B.Ids[i];
+    return false;
+}
+
+
+bool _treePathFree(TJournal *R, TOverlay *O, TGraph *G, int spurId, int stopId) {
+    // Sprawdzenie czy sciezka drzewa najkrotszych sciezek z wezla
+    // odgalezienia do wezla koncowego omija wezly i krawedzie pominiete
+    for (int v = spurId; v != stopId; v = entryPrev(R, v))
+        if (arcWeight(O, G, v, entryPrev(R, v)) == 0)
+            return false;
+    return true;
+}
+
+
+template <typename TQueue>
+void _exploreSpur(TJournal *J, TGraph *G, TJournal *R, int spurId, int stopId) {
+    // Ustawienie wartosci poczatkowych we wszystkich wpisach ...
+    clearJournal(J);
+    // ... i wyzerowanie dystansu we wpisie wezla odgalezienia
+    setDistance(J, spurId, 0);
+
+    // Przydzial kolejki wybranego rodzaju i wprowadzenie do niej wpisu
+    // wezla odgalezienia (z kluczem rownym jego potencjalowi)
+    TQueue *Q;
+    journalQueue(J, Q, maxArcWeight(J->overlay, G));
+    enqueue(Q, spurId, entryDistance(R, spurId));
+
+    J->settled = 0;
+    // Tak dlugo jak w kolejce czekaja niegotowe wpisy, ...
+    while (queueSize(Q) > 0) {
+        // ... zdjecie z czola kolejki wpisu o najmniejszym kluczu, ...
+        int currId = dequeue(Q);
+        setVisited(J, currId, true);
+        J->settled++;
+        // ... (zwiedzenie wezla koncowego konczy obliczenia) ...
+        if (currId == stopId)
+            break;
+        // ... i dla kazdego wezla sasiadujacego z nim, ...
+        for (int i = 0; i < nodeDegree(G, currId); i++) {
+            int nextId = G->adjList[currId][i];
+            if (isVisited(J, nextId))
+                continue;
+            // ... (z pominieciem wezlow, z ktorych nie da sie dotrzec do wezla
+            // koncowego, oraz krawedzi pominietych w nakladce) ...
+            INT64 h = entryDistance(R, nextId);
+            int w = arcWeight(J->overlay, G, currId, nextId);
+            if (h == INF || w == 0)
+                continue;
+            // ... gdy droga krotsza -- ZAPIS, z kluczem kolejki powiekszonym
+            // o potencjal wezla (dystans do wezla koncowego w grafie bez
+            // pominiec)
+            INT64 d = entryDistance(J, currId) + w;
+            if (entryDistance(J, nextId) > d) {
+                setDistance(J, nextId, d);
+                setPrev(J, nextId, currId);
+                requeue(Q, nextId, d + h);
+            }
+        }
+    }
+
+    // Zapamietanie statystyki obliczen ...
+    J->sifts = queueSifts(Q);
+    // ... i oproznienie kolejki priorytetowej
+    clearQueue(Q);
+}
+
+
+void _spurTask(void *context, int index, int worker) {
+    TSpurTask *T = (TSpurTask *)context;
+    TJournal *J = T->journals[worker];
+    TOverlay *O = T->overlays[worker];
+    TYenPath &S = T->spurs[index];
+
+    // Alias na korzen (poczatek poprzedniej sciezki) i wezel odgalezienia
+    const int *root = T->path->Ids;
+    const int spurId = root[index];
+
+    S.Ids = NULL;
+    S.length = 0;
+    S.cost = INF;
+    T->searched[index] = false;
+    T->settled[index] = 0;
+    // Zakonczenie, gdy z wezla odgalezienia nie da sie dotrzec do koncowego
+    if (entryDistance(T->R, spurId) == INF)
+        return;
+
+    // Pominiecie wezlow korzenia (poza wezlem odgalezienia) ...
+    clearOverlay(O);
+    for (int j = 0; j < index; j++)
+        blockNode(O, root[j]);
+    // ... i krawedzi wychodzacych z wezla odgalezienia po sciezkach juz
+    // wyznaczonych o tym samym korzeniu
+    for (int p = 0; p < T->accepted->count; p++) {
+        TYenPath &A = T->accepted->paths[p];
+        if (A.length <= index +1)
+            continue;
+        bool same = true;
+        for (int j = 0; j <= index && same; j++)
+            same = (A.Ids[j] == root[j]);
+        if (same)
+            blockEdge(O, T->G, spurId, A.Ids[index +1]);
+    }
+
+    // Sciezka odgalezienia z drzewa najkrotszych sciezek (o ile omija
+    // pominiecia), ...
+    if (_treePathFree(T->R, O, T->G, spurId, T->stopId)) {
+        S.length = 1;
+        for (int v = spurId; v != T->stopId; v = entryPrev(T->R, v))
+            S.length++;
+        S.Ids = new int[S.length];
+        S.length = 0;
+        for (int v = spurId; v != -1; v = entryPrev(T->R, v))
+            S.Ids[S.length++] = v;
+        S.cost = entryDistance(T->R, spurId);
+        return;
+    }
+
+    // ... a w przeciwnym razie przeszukanie grafu z nakladka pominiec
+    // (A* z potencjalami z drzewa najkrotszych sciezek)
+    J->overlay = O;
+    switch (J->queue) {
+        case qkQuadHeap    : _exploreSpur<TQuadHeap>(J, T->G, T->R, spurId, T->stopId);
+                             break;
+        case qkPairingHeap : _exploreSpur<TPairingHeap>(J, T->G, T->R, spurId, T->stopId);
+                             break;
+        case qkBuckets     :
+        case qkRadix       : _exploreSpur<TRadixHeap>(J, T->G, T->R, spurId, T->stopId);
+                             break;
+        default            : _exploreSpur<TIndexHeap>(J, T->G, T->R, spurId, T->stopId);
+    }
+    J->overlay = NULL;
+    T->searched[index] = true;
+    T->settled[index] = J->settled;
+
+    // Odczyt sciezki odgalezienia z dziennika obliczen (o ile wezel koncowy
+    // zostal osiagniety)
+    if (! isVisited(J, T->stopId))
+        return;
+    S.cost = entryDistance(J, T->stopId);
+    for (int v = T->stopId; v != -1; v = entryPrev(J, v))
+        S.length++;
+    S.Ids = new int[S.length];
+    int i = S.length;
+    for (int v = T->stopId; v != -1; v = entryPrev(J, v))
+        S.Ids[--i] = v;
+}
+
+
+TPathSet* initPathSet(TGraph *G, int startId, int stopId, int k, int threads) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub graf nie ma modelu)
+    if (G == NULL || G->profile == NULL)
+        return NULL;
+
+    // Poczatek pomiaru czasu obliczen
+    steady_clock::time_point t0 = steady_clock::now();
+
+    // Alias na rzad grafu
+    const int &n = G->order;
+
+    // Alokacja nowego zbioru sciezek
+    TPathSet *S = new TPathSet;
+    S->searches = 0;
+    S->reused = 0;
+
+    // Przeszukanie grafu wstecz od wezla koncowego (drzewo najkrotszych
+    // sciezek do wezla koncowego)
+    TJournal *R = initJournal(n);
+    R->queue = chooseQueue(G);
+    exploreReverse(R, G, stopId);
+    S->settled = R->settled;
+
+    // Listy sciezek wyznaczonych i kandydujacych
+    TYenList accepted = { 0, 0, NULL };
+    TYenList candidates = { 0, 0, NULL };
+
+    // Pierwsza sciezka - z drzewa najkrotszych sciezek (o ile wezel koncowy
+    // jest osiagalny)
+    if (k > 0 && entryDistance(R, startId) != INF) {
+        TYenPath P;
+        P.length = 0;
+        for (int v = startId; v != -1; v = entryPrev(R, v))
+            P.length++;
+        P.Ids = new int[P.length];
+        P.length = 0;
+        for (int v = startId; v != -1; v = entryPrev(R, v))
+            P.Ids[P.length++] = v;
+        P.cost = entryDistance(R, startId);
+        _appendPath(accepted, P);
+    }
+
+    // Dzienniki obliczen i nakladki zmian grafu dla kazdego z watkow
+    // (pierwsza iteracja - obliczenia sekwencyjne)
+    int t = workerCount(threads, n);
+    bool parallel = false;
+    TJournal **journals = new TJournal*[t];
+    TOverlay **overlays = new TOverlay*[t];
+    for (int w = 0; w < t; w++) {
+        journals[w] = initJournal(n);
+        journals[w]->queue = R->queue;
+        overlays[w] = initOverlay(G);
+    }
+
+// *** Kolejne sciezki z odgalezien sciezki poprzedniej ***
+
+    while (accepted.count > 0 && accepted.count < k) {
+        // Poprzednia sciezka i jej dystanse od wezla startowego (dystanse
+        // korzeni)
+        TYenPath *prev = &accepted.paths[accepted.count -1];
+        int m = prev->length -1;
+        // (sciezka jednowezlowa nie ma odgalezien)
+        if (m == 0)
+            break;
+        INT64 *rootCost = new INT64[prev->length];
+        rootCost[0] = 0;
+        for (int i = 1; i < prev->length; i++)
+            rootCost[i] = rootCost[i -1] + edgeWeight(G, prev->Ids[i -1], prev->Ids[i]);
+
+        // Rownolegle wyszukanie sciezek odgalezien (po jednym zadaniu na
+        // wezel odgalezienia)
+        TSpurTask T;
+        T.G = G;
+        T.R = R;
+        T.stopId = stopId;
+        T.path = prev;
+        T.accepted = &accepted;
+        T.journals = journals;
+        T.overlays = overlays;
+        T.spurs = new TYenPath[m];
+        T.searched = new bool[m];
+        T.settled = new int[m];
+        runParallel(m, parallel ? t : 1, _spurTask, &T);
+
+        // Zlozenie kandydatow (korzen + sciezka odgalezienia) z pominieciem
+        // powtorzen
+        int searches = 0;
+        INT64 settled = 0;
+        for (int i = 0; i < m; i++) {
+            if (T.searched[i])
+                searches++;
+            else if (T.spurs[i].Ids != NULL)
+                S->reused++;
+            settled += T.settled[i];
+            if (T.spurs[i].Ids == NULL)
+                continue;
+            TYenPath C;
+            C.length = i + T.spurs[i].length;
+            C.Ids = new int[C.length];
+            for (int j = 0; j < i; j++)
+                C.Ids[j] = prev->Ids[j];
+            for (int j = 0; j < T.spurs[i].length; j++)
+                C.Ids[i + j] = T.spurs[i].Ids[j];
+            C.cost = rootCost[i] + T.spurs[i].cost;
+            delete[] T.spurs[i].Ids;
+
+            bool known = false;
+            for (int c = 0; c < candidates.count && ! known; c++)
+                known = _samePath(candidates.paths[c], C);
+            if (known)
+                delete[] C.Ids;
+            else _appendPath(candidates, C);
+        }
+        // Uaktualnienie statystyki i wybor obliczen rownoleglych w nastepnej
+        // iteracji (gdy przeszukania sa dlugie)
+        S->searches += searches;
+        S->settled += settled;
+        parallel = (t > 1 && searches > 0 && settled / searches >= SPUR_PARALLEL_WORK);
+        delete[] T.spurs;
+        delete[] T.searched;
+        delete[] T.settled;
+        delete[] rootCost;
+
+        // Zakonczenie, gdy brak kandydatow (nie ma wiecej sciezek prostych)
+        if (candidates.count == 0)
+            break;
+        // Wybor najlepszego kandydata na kolejna sciezke
+        int best = 0;
+        for (int c = 1; c < candidates.count; c++)
+            if (_betterPath(candidates.paths[c], candidates.paths[best]))
+                best = c;
+        TYenPath B = candidates.paths[best];
+        candidates.paths[best] = candidates.paths[--candidates.count];
+        _appendPath(accepted, B);
+    }
+
+    // Skasowanie dziennikow, nakladek i kandydatow
+    for (int w = 0; w < t; w++) {
+        killJournal(journals[w]);
+        killOverlay(overlays[w]);
+    }
+    delete[] journals;
+    delete[] overlays;
+    killJournal(R);
+    for (int c = 0; c < candidates.count; c++)
+        delete[] candidates.paths[c].Ids;
+    delete[] candidates.paths;
+
+// *** Przepisanie sciezek do zwartych tablic wyniku ***
+
+    S->count = accepted.count;
+    S->costs = new INT64[S->count];
+    S->offsets = new int[S->count +1];
+    S->offsets[0] = 0;
+    for (int p = 0; p < S->count; p++) {
+        S->costs[p] = accepted.paths[p].cost;
+        S->offsets[p +1] = S->offsets[p] + accepted.paths[p].length;
+    }
+    S->Ids = new int[S->offsets[S->count]];
+    for (int p = 0; p < S->count; p++) {
+        for (int i = 0; i < accepted.paths[p].length; i++)
+            S->Ids[S->offsets[p] + i] = accepted.paths[p].Ids[i];
+        delete[] accepted.paths[p].Ids;
+    }
+    delete[] accepted.paths;
+
+    // Zapamietanie statystyki obliczen
+    S->time = duration_cast<microseconds>(steady_clock::now() - t0).count();
+
+    // Zwrocenie wskaznika na zainicjowany zbior sciezek
+    return S;
+}
+
+
+void killPathSet(TPathSet* &S) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (S == NULL)
+        return;
+
+    // Skasowanie tablic wyniku ...
+    delete[] S->costs;
+    delete[] S->offsets;
+    delete[] S->Ids;
+    S->costs = NULL;
+    S->offsets = NULL;
+    S->Ids = NULL;
+
+    // ... i zbioru sciezek oraz zwrocenie przez parametr wyzerowanego
+    // wskaznika
+    delete S;
+    S = NULL;
+}
+
+
+#undef INF
+#undef SPUR_PARALLEL_WORK
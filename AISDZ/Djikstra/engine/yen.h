@@ -0,0 +1,51 @@
+#ifndef AC_ENGINE_YEN_H
+#define AC_ENGINE_YEN_H
+
+#include "common.h"
+#include "graph.h"
+#include "dsp.h"
+
+
+/*
+  Struktura definiujaca zbior k najkrotszych sciezek prostych (bez petli)
+  pomiedzy para wezlow (algorytm J.Y.Yena)
+  count     - ilosc wyznaczonych sciezek (nie wieksza niz k)
+  costs     - count-elementowa tablica dystansow sciezek (niemalejaco)
+  offsets   - (count+1)-elementowa tablica poczatkow sciezek w tablicy Ids
+  Ids       - zwarta tablica Id wezlow kolejnych sciezek (od wezla
+              startowego do koncowego)
+  searches  - statystyka: ilosc przeszukan grafu od wezlow odgalezien
+  reused    - statystyka: ilosc odgalezien odczytanych z drzewa najkrotszych
+              sciezek do wezla koncowego (bez przeszukania grafu)
+  settled   - statystyka: ilosc wezlow zwiedzonych we wszystkich
+              przeszukaniach (lacznie z przeszukaniem wstecz)
+  time      - statystyka: czas obliczen [us]
+*/
+struct TPathSet {
+    int count;
+    INT64 *costs;
+    int *offsets;
+    int *Ids;
+    int searches;
+    int reused;
+    INT64 settled;
+    INT64 time;
+};
+
+
+inline int pathLength(TPathSet *S, int k) {
+    // Zwrocenie ilosci wezlow k-tej sciezki
+    return S->offsets[k +1] - S->offsets[k];
+}
+
+inline int* pathNodes(TPathSet *S, int k) {
+    // Zwrocenie wskaznika na sekwencje Id wezlow k-tej sciezki
+    return S->Ids + S->offsets[k];
+}
+
+
+TPathSet* initPathSet(TGraph *G, int startId, int stopId, int k, int threads);
+void killPathSet(TPathSet* &S);
+
+
+#endif // AC_ENGINE_YEN_H
@@ -8,7 +8,44 @@
   - wyspecjalizowane funkcje logiczne badaja czy caly zbior danych zrodlowych
     mozna zamienic na liczby naturalne, a takze czy ilosc danych jest liczba
     kwadratowa;
-  - funkcje na strukturze uruchamiaja i zatrzymuja silnik obliczeniowy.
+  - funkcje na strukturze uruchamiaja i zatrzymuja silnik obliczeniowy,
+    a takze zlecaja mu wyszukanie najkrotszej sciezki pomiedzy para wezlow
+    w trybie wybranym w projekcie;
+  - tryby wymagajace obliczen wstepnych (ALT, hierarchia skrotow, flagi)
+    przygotowywane sa po zbudowaniu modelu grafu, o ile sa wybrane
+    w projekcie, albo z chwila ich wyboru; wyniki obliczen wstepnych
+    kasowane sa wraz z zatrzymaniem silnika obliczeniowego;
+  - najkrotsze sciezki do wszystkich wezlow wyznacza w duzych grafach
+    rownolegly algorytm delta-stepping (o ile przydzielono wiecej niz jeden
+    watek), ktorego wyniki sa identyczne z wynikami silnika sekwencyjnego;
+    ilosc watkow obowiazuje rowniez w rownoleglych obliczeniach wstepnych;
+  - zapytania o sam dystans (bez sciezki) obsluguja etykiety wezlow (wyrocznia
+    dystansow), o ile zostaly zbudowane lub wczytane z pliku - w przeciwnym
+    razie dystans wyznacza silnik obliczeniowy w trybie wybranym w projekcie;
+  - macierz odleglosci (w krawedziach), macierze dystansow i nastepnikow
+    oraz tablica dystansow od wszystkich wezlow zrodlowych budowane sa na
+    zadanie i kasowane wraz z zatrzymaniem silnika;
+  - tablice dystansow pomiedzy zbiorami wezlow (wiele do wielu) wyznacza sie
+    w hierarchii skrotow, o ile zostala zbudowana, a zwrocona tablice kasuje
+    wywolujacy;
+  - wyniki pelnych eksploracji grafu trafiaja do pamieci podrecznej drzew
+    najkrotszych sciezek (w budzecie CACHE_BUDGET), skad obsluguje sie
+    kolejne zapytania z tego samego wezla zrodlowego; pamiec podreczna
+    kasowana jest wraz z zatrzymaniem silnika;
+  - zmiany wag krawedzi wprowadzane sa do dzialajacego silnika bez ponownego
+    wczytywania danych; drzewo najkrotszych sciezek w dzienniku obliczen
+    (o ile jest w nim wynik pelnej eksploracji grafu) jest naprawiane
+    przyrostowo, a pozostale wyniki obliczen (wstepnych, budowanych na
+    zadanie i pamieci podrecznej) - jako nieaktualne - sa kasowane;
+    obliczenia wstepne powtarza dopiero pierwsze zapytanie, ktore ich
+    wymaga (kolejne pakiety zmian nie wykonuja ich wiec na prozno);
+  - sciezki objazdu (z nakladka zmian grafu, bez zmiany grafu) wyszukuje
+    silnik trybu wybranego w projekcie, z pominieciem pamieci podrecznej
+    i obliczen wstepnych zaleznych od wag (hierarchie skrotow zastepuje
+    wyszukiwanie dwukierunkowe, a flag krawedzi silnik nie uzywa);
+  - sciezki alternatywne (k najkrotszych sciezek prostych) wyznacza algorytm
+    Yena na watkach przydzielonych w projekcie, a zwrocony zbior sciezek
+    kasuje wywolujacy.
 
   Autor:  Artur Cyrwus                                    Data:  09-06-2021 r.
 
@@ -20,10 +57,30 @@
 #include "project.h"
 #include "engine/graph.h"
 #include "engine/dsp.h"
+#include "engine/alt.h"
+#include "engine/ch.h"
+#include "engine/hub.h"
+#include "engine/flags.h"
+#include "engine/bfs.h"
+#include "engine/floyd.h"
+#include "engine/table.h"
+#include "engine/many.h"
+#include "engine/cache.h"
+#include "engine/dynamic.h"
+#include "engine/overlay.h"
+#include "engine/yen.h"
+#include "engine/delta.h"
+#include "engine/parallel.h"
 
 using namespace std;
 
 
+#define ALT_LANDMARKS   8
+#define ARC_FLAG_CELLS  32
+#define PARALLEL_ORDER  2048
+#define CACHE_BUDGET    ((INT64)64 << 20)
+
+
 TProject* initProject() {
     // Alokacja nowego projektu ...
     TProject *P = new TProject;
@@ -37,6 +94,19 @@ TProject* initProject() {
     // (do czasu uruchomienia silnika obliczeniowego, po wczytaniu danych)
     P->graph = NULL;
     P->journal = NULL;
+    P->trees = NULL;
+    P->source = -1;
+    P->landmarks = NULL;
+    P->hierarchy = NULL;
+    P->arcFlags = NULL;
+    P->labels = NULL;
+    P->hops = NULL;
+    P->distances = NULL;
+    P->table = NULL;
+    // Domyslny tryb wyszukiwania najkrotszej sciezki pomiedzy para wezlow
+    P->mode = pmBidirectional;
+    // Domyslnie obliczenia rownolegle na wszystkich watkach sprzetowych
+    P->threads = 0;
 
     // Zwrocenie wskaznika na zainicjowany projekt
     return P;
@@ -189,6 +259,17 @@ bool startEngine(TProject *P) {
 
     // Zainicjowanie dziennika obliczen DSP
     P->journal = initJournal(n);
+    // ... z wyborem rodzaju kolejki priorytetowej dopasowanej do grafu (dla
+    // grafow o co najwyzej 64 wezlach - silnik maski bitowej, dla gestych -
+    // tablica przegladana liniowo, w pozostalych - wg wag krawedzi)
+    P->journal->queue = chooseQueue(P->graph);
+    // Zainicjowanie (pustej) pamieci podrecznej drzew najkrotszych sciezek
+    P->trees = initTreeCache(n, CACHE_BUDGET);
+    // (dziennik nie zawiera jeszcze wynikow pelnej eksploracji grafu)
+    P->source = -1;
+
+    // Obliczenia wstepne trybu wyszukiwania wybranego w projekcie
+    prepareEngine(P);
 
     // Silnik uruchomiony, zasilony danymi zrodlowymi i gotowy do analiz grafu
     return true;
@@ -200,10 +281,385 @@ void stopEngine(TProject *P) {
     if (P == NULL)
         return;
 
-    // Skasowanie (o ile zostaly zainicjowane) dziennika obliczen DSP, ...
+    // Skasowanie (o ile zostaly zainicjowane) wynikow obliczen wstepnych, ...
+    if (P->landmarks != NULL)
+        killLandmarks(P->landmarks);
+    if (P->hierarchy != NULL)
+        killHierarchy(P->hierarchy);
+    if (P->arcFlags != NULL)
+        killArcFlags(P->arcFlags);
+    if (P->labels != NULL)
+        killHubLabels(P->labels);
+    if (P->hops != NULL)
+        killHopMatrix(P->hops);
+    if (P->distances != NULL)
+        killDistMatrix(P->distances);
+    if (P->table != NULL)
+        killDistTable(P->table);
+    // ... pamieci podrecznej drzew, dziennika obliczen DSP, ...
+    if (P->trees != NULL)
+        killTreeCache(P->trees);
     if (P->journal != NULL)
         killJournal(P->journal);
     // ... i struktury grafu
     if (P->graph != NULL)
         killGraph(P->graph);
 }
+
+
+bool prepareEngine(TProject *P) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return false;
+
+    // Wybor punktow orientacyjnych i wyznaczenie wektorow dystansow
+    // (obliczenia rownolegle), o ile wybrano tryb ALT, a obliczen jeszcze
+    // nie wykonano
+    if (P->mode == pmLandmarks && P->landmarks == NULL) {
+        P->landmarks = initLandmarks(P->graph, ALT_LANDMARKS, P->threads);
+        return true;
+    }
+    // Kontrakcja wezlow i zbudowanie hierarchii skrotow, o ile wybrano
+    // tryb hierarchii skrotow, a obliczen jeszcze nie wykonano
+    if (P->mode == pmHierarchy && P->hierarchy == NULL) {
+        P->hierarchy = initHierarchy(P->graph);
+        return true;
+    }
+
+    // Flagi krawedzi obowiazuja w dzienniku obliczen tylko w trybie flag ...
+    P->journal->flags = (P->mode == pmArcFlags) ? P->arcFlags : NULL;
+    // ... a podzial grafu i wyznaczenie flag (obliczenia rownolegle)
+    // wykonywane sa, o ile wybrano ten tryb, a obliczen jeszcze nie wykonano
+    if (P->mode == pmArcFlags && P->arcFlags == NULL) {
+        P->arcFlags = initArcFlags(P->graph, ARC_FLAG_CELLS, P->threads);
+        P->journal->flags = P->arcFlags;
+        return true;
+    }
+    // Brak nowych obliczen wstepnych
+    return false;
+}
+
+
+void findPath(TProject *P, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return;
+
+    // Dziennik obliczen nie bedzie zawieral pelnego drzewa najkrotszych
+    // sciezek
+    P->source = -1;
+
+    // Odtworzenie sciezki z pamieci podrecznej (o ile jest w niej drzewo
+    // wezla startowego) - wystarczy przejscie po wezlach sciezki
+    TTree *T = findTree(P->trees, startId);
+    if (T != NULL) {
+        restorePath(P->journal, T, stopId);
+        return;
+    }
+
+    // Uzupelnienie (w razie potrzeby) obliczen wstepnych
+    prepareEngine(P);
+
+    // Wyszukanie najkrotszej sciezki pomiedzy podana para wezlow silnikiem
+    // obliczeniowym wybranym w projekcie (wynik zawsze trafia do dziennika
+    // obliczen DSP)
+    switch (P->mode) {
+        case pmBidirectional : exploreBidirectional(P->journal, P->graph, startId, stopId);
+                               break;
+        case pmLandmarks     : exploreLandmarks(P->journal, P->graph, P->landmarks, startId, stopId);
+                               break;
+        case pmHierarchy     : exploreHierarchy(P->journal, P->graph, P->hierarchy, startId, stopId);
+                               break;
+        default              : exploreGraph(P->journal, P->graph, startId, stopId);
+    }
+}
+
+
+void findAllPaths(TProject *P, int startId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return;
+
+    // Dziennik obliczen bedzie zawieral pelne drzewo najkrotszych sciezek
+    // z wezla startowego
+    P->source = startId;
+
+    // Odtworzenie wynikow z pamieci podrecznej (o ile jest w niej drzewo
+    // wezla startowego) ...
+    TTree *T = findTree(P->trees, startId);
+    if (T != NULL) {
+        restoreTree(P->journal, T);
+        return;
+    }
+
+    // ... a w przeciwnym razie wyznaczenie najkrotszych sciezek do wszystkich
+    // wezlow algorytmem
+    // delta-stepping, o ile graf jest duzy i przydzielono wiecej niz jeden
+    // watek, a w przeciwnym razie silnikiem sekwencyjnym (wynik zawsze
+    // trafia do dziennika obliczen DSP i jest w obu przypadkach identyczny)
+    if (P->graph->order >= PARALLEL_ORDER && workerCount(P->threads, P->graph->order) > 1)
+         exploreParallel(P->journal, P->graph, startId, P->threads, 0);
+    else exploreGraph(P->journal, P->graph, startId);
+
+    // Zapamietanie wynikow w pamieci podrecznej (z ewentualnym usunieciem
+    // drzewa uzytego najdawniej)
+    storeTree(P->trees, P->journal, startId);
+}
+
+
+void findDetour(TProject *P, TOverlay *O, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return;
+
+    // Dziennik obliczen nie bedzie zawieral pelnego drzewa najkrotszych
+    // sciezek
+    P->source = -1;
+
+    // Uzupelnienie (w razie potrzeby) obliczen wstepnych
+    prepareEngine(P);
+
+    // Wskazanie nakladki zmian grafu w dzienniku obliczen na czas
+    // wyszukiwania ...
+    P->journal->overlay = O;
+    // ... najkrotszej sciezki silnikiem wybranym w projekcie (o ile nie
+    // opiera sie na hierarchii skrotow grafu bez zmian)
+    switch (P->mode) {
+        case pmLandmarks : exploreLandmarks(P->journal, P->graph, P->landmarks, startId, stopId);
+                           break;
+        case pmDijkstra  :
+        case pmArcFlags  : exploreGraph(P->journal, P->graph, startId, stopId);
+                           break;
+        default          : exploreBidirectional(P->journal, P->graph, startId, stopId);
+    }
+    P->journal->overlay = NULL;
+}
+
+
+int findRange(TProject *P, int startId, INT64 range, int Ids[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return -1;
+
+    // Dziennik obliczen nie bedzie zawieral pelnego drzewa najkrotszych
+    // sciezek
+    P->source = -1;
+
+    // Wyznaczenie wezlow w zasiegu podanego dystansu od wezla startowego
+    // (wynik trafia do dziennika obliczen DSP, a Id wezlow - do podanej
+    // tablicy, w kolejnosci niemalejacych dystansow)
+    return exploreRange(P->journal, P->graph, startId, range, Ids);
+}
+
+
+int findNearest(TProject *P, int startId, int count, int targets[], int k, int Ids[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return -1;
+
+    // Dziennik obliczen nie bedzie zawieral pelnego drzewa najkrotszych
+    // sciezek
+    P->source = -1;
+
+    // Wyznaczenie k najblizszych wezlow docelowych (wynik trafia do dziennika
+    // obliczen DSP, a Id wezlow - do podanej tablicy, w kolejnosci
+    // niemalejacych dystansow)
+    return exploreNearest(P->journal, P->graph, startId, count, targets, k, Ids);
+}
+
+
+int findVoronoi(TProject *P, int count, int sites[], int owner[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return -1;
+
+    // Dziennik obliczen bedzie zawieral las najkrotszych sciezek (a nie
+    // drzewo jednego wezla startowego)
+    P->source = -1;
+
+    // Wyznaczenie dystansow od najblizszych wezlow zrodlowych w jednym
+    // przejsciu z wszystkich wezlow zrodlowych naraz - algorytmem
+    // delta-stepping, o ile graf jest duzy i przydzielono wiecej niz jeden
+    // watek, a w przeciwnym razie silnikiem sekwencyjnym (wynik w obu
+    // przypadkach identyczny) ...
+    if (P->graph->order >= PARALLEL_ORDER && workerCount(P->threads, P->graph->order) > 1)
+         exploreParallel(P->journal, P->graph, count, sites, P->threads, 0);
+    else exploreSources(P->journal, P->graph, count, sites);
+
+    // ... i przydzial wezlow do najblizszych wezlow zrodlowych (pozycje
+    // w tablicy wezlow zrodlowych trafiaja do podanej tablicy) ze zwroceniem
+    // ilosci wezlow osiagalnych
+    return assignSources(P->journal, count, sites, owner);
+}
+
+
+TPathSet* findAlternatives(TProject *P, int startId, int stopId, int k) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return NULL;
+
+    // Wyznaczenie k najkrotszych sciezek prostych pomiedzy para wezlow
+    // (algorytmem Yena), na watkach przydzielonych w projekcie
+    return initPathSet(P->graph, startId, stopId, k, P->threads);
+}
+
+
+INT64 findDistance(TProject *P, int startId, int stopId) {
+    // Zakonczenie, gdy podany wskaznik jest pusty
+    if (P == NULL)
+        return -1;
+
+    // Odczyt dystansu z etykiet wezlow (o ile sa), ...
+    if (P->labels != NULL)
+        return hubDistance(P->labels, startId, stopId);
+
+    // ... a w przeciwnym razie wyszukanie najkrotszej sciezki
+    findPath(P, startId, stopId);
+    return getDistance(P->journal, stopId);
+}
+
+
+int updateWeights(TProject *P, int count, TWeightUpdate updates[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return -1;
+
+    // Wprowadzenie zmian do grafu z przyrostowa naprawa drzewa najkrotszych
+    // sciezek w dzienniku obliczen (o ile zawiera wyniki pelnej eksploracji
+    // grafu), a w przeciwnym razie - bez naprawy dziennika
+    int affected = 0;
+    if (P->source >= 0)
+         affected = repairJournal(P->journal, P->graph, P->source, count, updates);
+    else updateGraph(P->graph, count, updates);
+
+    // Ponowny wybor rodzaju kolejki priorytetowej (zmienione wagi krawedzi
+    // moga np. wykluczac kolejke kubelkowa Diala)
+    P->journal->queue = chooseQueue(P->graph);
+
+    // Skasowanie nieaktualnych wynikow obliczen wstepnych ...
+    if (P->landmarks != NULL)
+        killLandmarks(P->landmarks);
+    if (P->hierarchy != NULL)
+        killHierarchy(P->hierarchy);
+    if (P->arcFlags != NULL)
+        killArcFlags(P->arcFlags);
+    P->journal->flags = NULL;
+    // ... i struktur budowanych na zadanie, ...
+    if (P->labels != NULL)
+        killHubLabels(P->labels);
+    if (P->hops != NULL)
+        killHopMatrix(P->hops);
+    if (P->distances != NULL)
+        killDistMatrix(P->distances);
+    if (P->table != NULL)
+        killDistTable(P->table);
+    // ... a takze wyczyszczenie pamieci podrecznej drzew (z zapamietaniem
+    // w niej naprawionego drzewa)
+    clearTreeCache(P->trees);
+    if (P->source >= 0)
+        storeTree(P->trees, P->journal, P->source);
+
+    // (obliczenia wstepne trybu wyszukiwania wybranego w projekcie
+    // uzupelni pierwsze zapytanie, ktore ich wymaga)
+
+    // Zwrocenie ilosci wpisow dziennika naprawionych przyrostowo
+    return affected;
+}
+
+
+bool buildLabels(TProject *P) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return false;
+
+    // Skasowanie poprzednich etykiet
+    killHubLabels(P->labels);
+
+    // Zbudowanie etykiet w porzadku rang hierarchii skrotow (o ile zostala
+    // zbudowana), a w przeciwnym razie - w porzadku stopni wezlow
+    if (P->hierarchy != NULL) {
+        int *order = new int[P->graph->order];
+        hierarchyOrder(P->hierarchy, order);
+        P->labels = initHubLabels(P->graph, order);
+        delete[] order;
+    }
+    else P->labels = initHubLabels(P->graph, NULL);
+
+    return (P->labels != NULL);
+}
+
+
+bool loadLabels(TProject *P, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return false;
+
+    // Wczytanie etykiet z pliku (odrzucanych, gdy nie pasuja do grafu)
+    THubLabels *L = loadHubLabels(filename, P->graph->order, P->graph->profile[gpDirected] > 0);
+    if (L == NULL)
+        return false;
+    // Zastapienie poprzednich etykiet wczytanymi
+    killHubLabels(P->labels);
+    P->labels = L;
+    return true;
+}
+
+
+bool buildHops(TProject *P) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return false;
+
+    // Skasowanie poprzedniej macierzy i wyznaczenie nowej (wielozrodlowym
+    // przeszukiwaniem wszerz, na watkach przydzielonych w projekcie)
+    killHopMatrix(P->hops);
+    P->hops = initHopMatrix(P->graph, P->threads);
+
+    return (P->hops != NULL);
+}
+
+
+bool buildDistances(TProject *P) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return false;
+
+    // Skasowanie poprzednich macierzy i wyznaczenie nowych (algorytmem
+    // Floyda-Warshalla, na watkach przydzielonych w projekcie)
+    killDistMatrix(P->distances);
+    P->distances = initDistMatrix(P->graph, P->threads);
+
+    return (P->distances != NULL);
+}
+
+
+bool buildTable(TProject *P, string filename) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return false;
+
+    // Skasowanie poprzedniej tablicy (z zakonczeniem odwzorowania pliku)
+    // i wyznaczenie nowej (algorytmem Dijkstry z kazdego wezla, z kolejka
+    // wybrana w projekcie i na watkach przydzielonych w projekcie)
+    killDistTable(P->table);
+    P->table = initDistTable(P->graph, P->journal->queue, P->threads, filename);
+
+    return (P->table != NULL);
+}
+
+
+TManyTable* findDistances(TProject *P, int rows, int sourceIds[], int cols, int targetIds[]) {
+    // Zakonczenie, gdy podany wskaznik jest pusty (lub silnik nie pracuje)
+    if (P == NULL || P->graph == NULL)
+        return NULL;
+
+    // Uzupelnienie (w razie potrzeby, np. po zmianach wag krawedzi) hierarchii
+    // skrotow, o ile wybrano ja w projekcie
+    if (P->mode == pmHierarchy)
+        prepareEngine(P);
+
+    // Wyznaczenie tablicy dystansow pomiedzy zbiorami wezlow (metoda
+    // kubelkow w hierarchii skrotow, o ile zostala zbudowana), na watkach
+    // przydzielonych w projekcie
+    return initManyTable(P->graph, P->hierarchy, P->threads, rows, sourceIds, cols, targetIds);
+}
@@ -5,6 +5,18 @@
 #include "book.h"
 #include "engine/graph.h"
 #include "engine/dsp.h"
+#include "engine/alt.h"
+#include "engine/ch.h"
+#include "engine/hub.h"
+#include "engine/flags.h"
+#include "engine/bfs.h"
+#include "engine/floyd.h"
+#include "engine/table.h"
+#include "engine/many.h"
+#include "engine/cache.h"
+#include "engine/dynamic.h"
+#include "engine/overlay.h"
+#include "engine/yen.h"
 
 using namespace std;
 
@@ -16,6 +28,28 @@ using namespace std;
   data      - ksiazka danych zrodlowych (jednokierunkowa lista stron z danymi)
   graph     - struktura szkieletowa grafu
   journal   - dziennik obliczen DSP (Dijkstra Shortest Path)
+  trees     - pamiec podreczna drzew najkrotszych sciezek (wyniki pelnych
+              eksploracji grafu z ostatnio uzytych wezlow zrodlowych)
+  source    - wezel zrodlowy pelnej eksploracji grafu, ktorej wyniki sa
+              w dzienniku obliczen (-1 - dziennik zawiera inne obliczenia)
+  mode      - tryb wyszukiwania najkrotszej sciezki pomiedzy para wezlow
+              (EPathMode)
+  landmarks - punkty orientacyjne metody ALT (wynik obliczen wstepnych dla
+              trybu pmLandmarks)
+  hierarchy - hierarchia skrotow (wynik obliczen wstepnych dla trybu
+              pmHierarchy)
+  arcFlags  - flagi krawedzi z podzialem grafu na komorki (wynik obliczen
+              wstepnych dla trybu pmArcFlags)
+  labels    - etykiety wezlow, tj. wyrocznia dystansow (budowane na zadanie,
+              odpowiadaja na zapytania o sam dystans)
+  hops      - macierz odleglosci (w krawedziach) pomiedzy wszystkimi parami
+              wezlow (budowana na zadanie)
+  distances - macierze dystansow i nastepnikow pomiedzy wszystkimi parami
+              wezlow (budowane na zadanie)
+  table     - tablica dystansow od wszystkich wezlow zrodlowych (budowana na
+              zadanie, w pamieci albo odwzorowana z pliku)
+  threads   - ilosc watkow obliczen rownoleglych (0 - wszystkie watki
+              sprzetowe, 1 - obliczenia sekwencyjne)
   summary   - karta charakterystyki zadania projektowego
 */
 struct TProject {
@@ -24,6 +58,37 @@ struct TProject {
     TBook *data;
     TGraph *graph;
     TJournal *journal;
+    TTreeCache *trees;
+    int source;
+    int mode;
+    TLandmarks *landmarks;
+    THierarchy *hierarchy;
+    TArcFlags *arcFlags;
+    THubLabels *labels;
+    THopMatrix *hops;
+    TDistMatrix *distances;
+    TDistTable *table;
+    int threads;
+};
+
+
+/*
+  Enumerator trybow wyszukiwania najkrotszej sciezki pomiedzy para wezlow
+  pmDijkstra      - algorytm Dijkstry, przerywany po zwiedzeniu wezla koncowego
+  pmBidirectional - dwukierunkowy algorytm Dijkstry
+  pmLandmarks     - algorytm A* z potencjalami wyznaczonymi z punktow
+                    orientacyjnych (ALT)
+  pmHierarchy     - dwukierunkowe przeszukiwanie hierarchii skrotow
+                    (contraction hierarchies)
+  pmArcFlags      - algorytm Dijkstry z pomijaniem krawedzi wg flag krawedzi
+                    (arc flags)
+*/
+enum EPathMode {
+    pmDijkstra,
+    pmBidirectional,
+    pmLandmarks,
+    pmHierarchy,
+    pmArcFlags
 };
 
 
@@ -35,6 +100,26 @@ int checkData(TProject *P);
 
 bool startEngine(TProject *P);
 void stopEngine(TProject *P);
+bool prepareEngine(TProject *P);
+
+void findPath(TProject *P, int startId, int stopId);
+void findAllPaths(TProject *P, int startId);
+void findDetour(TProject *P, TOverlay *O, int startId, int stopId);
+TPathSet* findAlternatives(TProject *P, int startId, int stopId, int k);
+int findRange(TProject *P, int startId, INT64 range, int Ids[]);
+int findNearest(TProject *P, int startId, int count, int targets[], int k, int Ids[]);
+int findVoronoi(TProject *P, int count, int sites[], int owner[]);
+INT64 findDistance(TProject *P, int startId, int stopId);
+
+int updateWeights(TProject *P, int count, TWeightUpdate updates[]);
+
+bool buildLabels(TProject *P);
+bool loadLabels(TProject *P, string filename);
+
+bool buildHops(TProject *P);
+bool buildDistances(TProject *P);
+bool buildTable(TProject *P, string filename);
+TManyTable* findDistances(TProject *P, int rows, int sourceIds[], int cols, int targetIds[]);
 
 
 #endif // AC_PROJECT_H
@@ -98,6 +98,182 @@ void msgNodeNotFound() {
 }
 
 
+void msgLandmarks(int count, long long time, long long memory) {
+    // Wypisanie raportu z obliczen wstepnych metody ALT
+    cout << "\nWybrano punkty orientacyjne: " << count;
+    cout << "\nCzas obliczen wstepnych [us]: " << time;
+    cout << "\nPamiec wektorow dystansow [B]: " << memory << "\n";
+    cout << endl;
+}
+
+
+void msgHierarchy(int shortcuts, long long time) {
+    // Wypisanie raportu z obliczen wstepnych hierarchii skrotow
+    cout << "\nUtworzone skroty: " << shortcuts;
+    cout << "\nCzas obliczen wstepnych [us]: " << time << "\n";
+    cout << endl;
+}
+
+
+void msgArcFlags(int cells, int boundary, long long time, long long memory) {
+    // Wypisanie raportu z obliczen wstepnych flag krawedzi
+    cout << "\nIlosc komorek podzialu grafu: " << cells;
+    cout << "\nIlosc wezlow brzegowych: " << boundary;
+    cout << "\nCzas obliczen wstepnych [us]: " << time;
+    cout << "\nPamiec flag krawedzi [B]: " << memory << "\n";
+    cout << endl;
+}
+
+
+void msgBatchInfo() {
+    // Wydrukowanie informacji o pliku zapytan do obliczen wsadowych
+    cout << "\nObliczenia wsadowe wyszukuja najkrotsze sciezki dla par wezlow zapisanych w pliku tekstowym.";
+    cout << "\nPlik musi zawierac pary liczb (Id wezla zrodlowego i koncowego) rozdzielone spacjami, tabulacja lub nowa linia.";
+    cout << "\nDystanse odczytywane sa z etykiet wezlow (polecenie O), o ile je zbudowano lub wczytano,";
+    cout << "\na w przeciwnym razie sciezki wyszukiwane sa w trybie wybranym poleceniem M.";
+    cout << endl;
+}
+
+
+void msgHubLabels(long long entries, int nodes, int maxLabel, long long memory, long long time) {
+    // Wypisanie statystyki etykiet wezlow
+    cout << "\nIlosc wpisow w etykietach: " << entries;
+    cout << "\nSrednia wielkosc etykiety: " << ((nodes > 0) ? (double)entries / nodes : 0);
+    cout << "\nNajwieksza etykieta: " << maxLabel;
+    cout << "\nPamiec etykiet [B]: " << memory;
+    cout << "\nCzas budowy etykiet [us]: " << time << "\n";
+    cout << endl;
+}
+
+
+void msgNoHubLabels() {
+    // Wypisanie komunikatu o braku etykiet wezlow
+    cout << "\nBrak etykiet wezlow!";
+    cout << "\nNajpierw nalezy zbudowac etykiety lub wczytac je z pliku.\n";
+    cout << endl;
+}
+
+
+void msgHopMatrix(int diameter, double average, long long unreachable, long long memory, long long time) {
+    // Wypisanie statystyki macierzy odleglosci (w krawedziach)
+    cout << "\nSrednica grafu (w krawedziach): " << diameter;
+    cout << "\nSrednia odleglosc (w krawedziach): " << average;
+    cout << "\nIlosc par wezlow bez drogi: " << unreachable;
+    cout << "\nPamiec macierzy odleglosci [B]: " << memory;
+    cout << "\nCzas obliczen [us]: " << time << "\n";
+    cout << endl;
+}
+
+
+void msgDistMatrix(long long diameter, long long memory, long long time) {
+    // Wypisanie statystyki macierzy dystansow i nastepnikow
+    cout << "\nNajwiekszy dystans pomiedzy wezlami: " << diameter;
+    cout << "\nPamiec macierzy dystansow i nastepnikow [B]: " << memory;
+    cout << "\nCzas obliczen [us]: " << time << "\n";
+    cout << endl;
+}
+
+
+void msgDistTable(long long settled, long long memory, long long time) {
+    // Wypisanie statystyki tablicy dystansow od wszystkich wezlow zrodlowych
+    cout << "\nIlosc zwiedzonych wezlow (lacznie): " << settled;
+    cout << "\nPamiec tablicy dystansow [B]: " << memory;
+    cout << "\nCzas obliczen [us]: " << time << "\n";
+    cout << endl;
+}
+
+
+void msgUpdateInfo() {
+    // Wydrukowanie informacji o pliku zmian wag krawedzi
+    cout << "\nZmiany wag krawedzi wprowadzane sa do grafu bez ponownego wczytywania danych.";
+    cout << "\nPlik musi zawierac trojki liczb (Id wezla poczatkowego i koncowego oraz nowa waga krawedzi, 0 - usuniecie).";
+    cout << "\nW grafie nieskierowanym zmiana obowiazuje w obu kierunkach krawedzi.";
+    cout << "\nDrzewo najkrotszych sciezek z ostatniego wyznaczenia sciezek do wszystkich wezlow (polecenie P, opcja 1)";
+    cout << "\njest naprawiane przyrostowo, a pozostale wyniki obliczen - jako nieaktualne - sa kasowane.";
+    cout << endl;
+}
+
+
+void msgOverlayInfo() {
+    // Wydrukowanie informacji o pliku scenariusza zmian grafu ("what-if")
+    cout << "\nScenariusz zmian grafu sluzy do wyszukania objazdu, bez zmiany samego grafu.";
+    cout << "\nPlik musi zawierac zmiany w postaci (po jednej na linie):";
+    cout << "\n  n Id                 - zablokowanie wezla";
+    cout << "\n  e startId stopId     - zamkniecie krawedzi";
+    cout << "\n  w startId stopId waga - zmiana wagi krawedzi";
+    cout << "\nW grafie nieskierowanym zmiana krawedzi obowiazuje w obu kierunkach.";
+    cout << endl;
+}
+
+
+void msgFacilityInfo() {
+    // Wydrukowanie informacji o pliku wezlow obiektow uslugowych
+    cout << "\nObiekty uslugowe (np. szpitale, magazyny) to wyrozniony zbior wezlow grafu.";
+    cout << "\nPlik musi zawierac Id wezlow obiektow rozdzielone spacjami, tabulacja lub nowa linia.";
+    cout << endl;
+}
+
+
+void msgPathSet(int searches, int reused, long long settled, long long time) {
+    // Wypisanie statystyki wyznaczania sciezek alternatywnych
+    cout << "\nIlosc przeszukan grafu od wezlow odgalezien: " << searches;
+    cout << "\nOdgalezienia odczytane z drzewa najkrotszych sciezek: " << reused;
+    cout << "\nIlosc zwiedzonych wezlow (lacznie): " << settled;
+    cout << "\nCzas obliczen [us]: " << time << "\n";
+    cout << endl;
+}
+
+
+void msgWeightUpdates(int count, int rejected, int affected, long long settled, long long time,
+                      long long fullTime, string same) {
+    // Wypisanie statystyki zmian wag krawedzi
+    cout << "\nIlosc zmian wag: " << count;
+    if (rejected > 0)
+        cout << " (pominieto bledne: " << rejected << ")";
+    if (affected >= 0) {
+        cout << "\nIlosc naprawionych wpisow drzewa najkrotszych sciezek: " << affected;
+        cout << "\nIlosc zwiedzonych wezlow: " << settled;
+    }
+    else cout << "\nBrak drzewa najkrotszych sciezek do naprawy (dziennik zawiera inne obliczenia)";
+    cout << "\nCzas obliczen [us]: " << time;
+    if (affected >= 0) {
+        cout << "\nCzas ponownej eksploracji grafu [us]: " << fullTime;
+        cout << "\nZgodnosc z ponowna eksploracja grafu: " << same;
+    }
+    cout << "\n";
+    cout << endl;
+}
+
+
+void msgNoMatrix() {
+    // Wypisanie komunikatu o braku macierzy odleglosci
+    cout << "\nBrak macierzy odleglosci!";
+    cout << "\nNajpierw nalezy wyznaczyc odleglosci (lub dystanse) pomiedzy wszystkimi parami wezlow.\n";
+    cout << endl;
+}
+
+
+void msgManyInfo() {
+    // Wydrukowanie informacji o pliku zbiorow wezlow
+    cout << "\nTablica dystansow wyznaczana jest pomiedzy zbiorem wezlow zrodlowych i zbiorem wezlow docelowych.";
+    cout << "\nPlik musi zawierac dwie linie: Id wezlow zrodlowych oraz Id wezlow docelowych (rozdzielone spacjami lub tabulacja).";
+    cout << "\nDystanse wyznaczane sa metoda kubelkow w hierarchii skrotow, o ile ja zbudowano (tryb M),";
+    cout << "\na w przeciwnym razie - algorytmem Dijkstry z kazdego wezla zrodlowego (do zwiedzenia wszystkich docelowych).";
+    cout << endl;
+}
+
+
+void msgManyTable(long long buckets, long long settled, int searches, long long time) {
+    // Wypisanie statystyki tablicy dystansow pomiedzy zbiorami wezlow
+    if (buckets > 0)
+        cout << "\nIlosc wpisow w kubelkach wezlow: " << buckets;
+    cout << "\nSrednia ilosc zwiedzonych wezlow (na przeszukiwanie): ";
+    cout << ((searches > 0) ? (double)settled / searches : 0);
+    cout << "\nCzas obliczen [us]: " << time << "\n";
+    cout << endl;
+}
+
+
 void msgUnknownError() {
     // Wypisanie komunikatu o nieznanym bledzie
     cout << "\nCos poszlo nie tak :(";
@@ -106,6 +282,15 @@ void msgUnknownError() {
 }
 
 
+void msgNoBuckets(int maxWeight, int limit) {
+    // Wypisanie komunikatu o zbyt duzych wagach krawedzi dla kolejki Diala
+    cout << "\nKolejka kubelkowa Diala nie jest dostepna dla tego grafu!";
+    cout << "\nNajwieksza waga krawedzi (" << maxWeight << ") przekracza " << limit;
+    cout << " - kolejka wymagalaby tylu kubelkow. Wybierz kopiec pozycyjny.\n";
+    cout << endl;
+}
+
+
 void mnuOptionsDSP() {
     // Wypisanie informacji o grafie i dostepnych opcjach poszukiwania najkrotszych sciezek
     cout << "\nWyznaczanie najkrotszych sciezek w grafie (algorytm E.Dijkstry)";
@@ -114,6 +299,116 @@ void mnuOptionsDSP() {
     cout << "\nW zadanym grafie mozesz wyznaczyc:\n";
     cout << "[1] dlugosci najkrotszych sciezek z podanego wezla zrodlowego do wszystkich pozostalych wezlow\n";
     cout << "[2] sposob przejscia po najkrotszej sciezce z podanego wezla zrodlowego do innego wezla w grafie\n";
+    cout << "[3] wezly w zasiegu podanego dystansu od wezla zrodlowego (izochrona) wraz z ich dystansami\n";
+    cout << endl;
+}
+
+
+void mnuOptionsQueue(int current) {
+    // Lista dostepnych rodzajow kolejki priorytetowej
+    const string names[7] = {
+        "kopiec binarny (indeksowany)",
+        "kopiec 4-arny (wyrownany do linii pamieci podrecznej)",
+        "kopiec parujacy",
+        "kolejka kubelkowa Diala (dla niewielkich wag krawedzi)",
+        "kopiec pozycyjny (radix heap)",
+        "tablica dystansow przegladana liniowo (dla grafow gestych)",
+        "maska bitowa wezlow (dla grafow do 64 wezlow)"
+    };
+
+    // Wypisanie dostepnych rodzajow kolejki priorytetowej silnika obliczeniowego,
+    // z zaznaczeniem rodzaju biezacego
+    cout << "\nKolejka priorytetowa silnika obliczeniowego";
+    cout << "\n-------------------------------------------";
+    cout << endl;
+    cout << "\nDostepne rodzaje kolejki:\n";
+    for (int i = 0; i < 7; i++) {
+        cout << "[" << i +1 << "] " << names[i];
+        cout << ((i == current) ? "  <-- biezaca" : "") << "\n";
+    }
+    cout << endl;
+}
+
+
+void mnuOptionsMode(int current) {
+    // Lista dostepnych trybow wyszukiwania najkrotszej sciezki
+    const string names[5] = {
+        "algorytm Dijkstry (przerywany po zwiedzeniu wezla koncowego)",
+        "dwukierunkowy algorytm Dijkstry",
+        "algorytm A* z punktami orientacyjnymi (ALT, obliczenia wstepne)",
+        "hierarchia skrotow (contraction hierarchies, obliczenia wstepne)",
+        "algorytm Dijkstry z flagami krawedzi (arc flags, obliczenia wstepne)"
+    };
+
+    // Wypisanie dostepnych trybow wyszukiwania najkrotszej sciezki pomiedzy
+    // para wezlow, z zaznaczeniem trybu biezacego
+    cout << "\nTryb wyszukiwania najkrotszej sciezki pomiedzy para wezlow";
+    cout << "\n----------------------------------------------------------";
+    cout << endl;
+    cout << "\nDostepne tryby:\n";
+    for (int i = 0; i < 5; i++) {
+        cout << "[" << i +1 << "] " << names[i];
+        cout << ((i == current) ? "  <-- biezacy" : "") << "\n";
+    }
+    cout << endl;
+}
+
+
+void mnuOptionsOracle() {
+    // Wypisanie dostepnych opcji wyroczni dystansow
+    cout << "\nWyrocznia dystansow (etykiety wezlow, ang. hub labeling)";
+    cout << "\n--------------------------------------------------------";
+    cout << endl;
+    cout << "\nDostepne opcje:\n";
+    cout << "[1] zbudowanie etykiet wezlow (w porzadku hierarchii skrotow, o ile zostala zbudowana)\n";
+    cout << "[2] dystans pomiedzy para wezlow odczytany z etykiet\n";
+    cout << "[3] zapis etykiet w pliku na dysku (postac zwarta)\n";
+    cout << "[4] odczyt etykiet z pliku na dysku\n";
+    cout << endl;
+}
+
+
+void mnuOptionsParallel(int threads, int hardware) {
+    // Wypisanie dostepnych opcji obliczen rownoleglych
+    cout << "\nObliczenia rownolegle (algorytm delta-stepping)";
+    cout << "\n-----------------------------------------------";
+    cout << endl;
+    cout << "\nIlosc watkow: " << threads;
+    cout << " (0 - wszystkie watki sprzetowe, tj. " << hardware << ")\n";
+    cout << "\nDostepne opcje:\n";
+    cout << "[1] zmiana ilosci watkow obliczen rownoleglych\n";
+    cout << "[2] test skalowania algorytmu delta-stepping (najkrotsze sciezki z podanego wezla do wszystkich pozostalych)\n";
+    cout << endl;
+}
+
+
+void mnuOptionsFacilities(int count) {
+    // Wypisanie dostepnych opcji zapytan o obiekty uslugowe
+    cout << "\nObiekty uslugowe (najblizsze obiekty, diagram Woronoja grafu)";
+    cout << "\n-------------------------------------------------------------";
+    cout << endl;
+    cout << "\nIlosc obiektow: " << count << "\n";
+    cout << "\nDostepne opcje:\n";
+    cout << "[1] k obiektow najblizszych podanemu wezlowi zrodlowemu (wraz z ich dystansami)\n";
+    cout << "[2] przydzial wszystkich wezlow do najblizszych obiektow (jedno przejscie z wszystkich obiektow naraz)\n";
+    cout << endl;
+}
+
+
+void mnuOptionsAllPairs() {
+    // Wypisanie dostepnych opcji obliczen dla wszystkich par wezlow
+    cout << "\nOdleglosci pomiedzy wszystkimi parami wezlow";
+    cout << "\n--------------------------------------------";
+    cout << endl;
+    cout << "\nDostepne opcje:\n";
+    cout << "[1] odleglosci w krawedziach (wielozrodlowe przeszukiwanie wszerz, bez wzgledu na wagi)\n";
+    cout << "[2] dystanse (algorytm Floyda-Warshalla, z macierza nastepnikow)\n";
+    cout << "[3] dystanse od wszystkich wezlow zrodlowych (rownolegle, algorytm Dijkstry), z opcjonalnym odwzorowaniem w pliku\n";
+    cout << "[4] najkrotsza sciezka pomiedzy para wezlow odczytana z macierzy nastepnikow\n";
+    cout << "[5] wydruk wyznaczonych macierzy\n";
+    cout << "[6] zapis macierzy odleglosci (w krawedziach) w pliku na dysku\n";
+    cout << "[7] zapis macierzy dystansow w pliku na dysku\n";
+    cout << "[8] tablica dystansow pomiedzy zbiorami wezlow z pliku (wiele do wielu)\n";
     cout << endl;
 }
 
@@ -124,7 +419,7 @@ void mnuOptionsDSP() {
 void wndHelp() {
     // Inicjalizacja siatki napisow
     SGrid *S = new SGrid;
-    initGrid(S, 8, 2);
+    initGrid(S, 18, 2);
 
     cout << endl;
     // Ustawienie tytulu i naglowkow siatki
@@ -139,8 +434,18 @@ void wndHelp() {
     S->cells[3][0] = "n, N";
     S->cells[4][0] = "e, E";
     S->cells[5][0] = "p, P";
-    S->cells[6][0] = "h, H";
-    S->cells[7][0] = "q, Q";
+    S->cells[6][0] = "k, K";
+    S->cells[7][0] = "m, M";
+    S->cells[8][0] = "b, B";
+    S->cells[9][0] = "o, O";
+    S->cells[10][0] = "w, W";
+    S->cells[11][0] = "a, A";
+    S->cells[12][0] = "u, U";
+    S->cells[13][0] = "z, Z";
+    S->cells[14][0] = "y, Y";
+    S->cells[15][0] = "f, F";
+    S->cells[16][0] = "h, H";
+    S->cells[17][0] = "q, Q";
     // ... lista z opisami funkcji
     S->cells[0][1] = "wyczyszczenie okna terminala";
     S->cells[1][1] = "wczytanie danych o grafie z pliku na dysku";
@@ -148,8 +453,18 @@ void wndHelp() {
     S->cells[3][1] = "zestawienie danych o wezlach (wierzcholkach) grafu tj. listy wezlow, listy sasiedztwa, ...";
     S->cells[4][1] = "zestawienie danych o krawedziach grafu tj. wezly incydentne, wagi krawedzi, ...";
     S->cells[5][1] = "poszukiwanie najkrotszych sciezek w grafie (wg algorytmu Dijkstry) i prezentacja wynikow.";
-    S->cells[6][1] = "ekran pomocy o dostepnych funkcjach programu";
-    S->cells[7][1] = "zakonczenie programu";
+    S->cells[6][1] = "wybor rodzaju kolejki priorytetowej silnika obliczeniowego";
+    S->cells[7][1] = "wybor trybu wyszukiwania najkrotszej sciezki pomiedzy para wezlow";
+    S->cells[8][1] = "obliczenia wsadowe, tj. wyszukiwanie najkrotszych sciezek dla par wezlow z pliku na dysku";
+    S->cells[9][1] = "wyrocznia dystansow, tj. budowa, zapis i odczyt etykiet wezlow oraz zapytania o dystans";
+    S->cells[10][1] = "obliczenia rownolegle, tj. ilosc watkow i test skalowania algorytmu delta-stepping";
+    S->cells[11][1] = "odleglosci i dystanse pomiedzy wszystkimi parami wezlow, tj. macierze z wydrukiem i zapisem";
+    S->cells[12][1] = "zmiany wag krawedzi z pliku na dysku, z przyrostowa naprawa drzewa najkrotszych sciezek";
+    S->cells[13][1] = "objazdy, tj. najkrotsza sciezka przy zmianach grafu z pliku (zamkniecia, blokady, wagi)";
+    S->cells[14][1] = "sciezki alternatywne, tj. k najkrotszych sciezek prostych pomiedzy para wezlow (Yen)";
+    S->cells[15][1] = "obiekty uslugowe z pliku, tj. k najblizszych obiektow i przydzial wezlow do obiektow";
+    S->cells[16][1] = "ekran pomocy o dostepnych funkcjach programu";
+    S->cells[17][1] = "zakonczenie programu";
 
     // Ustawienie szerokosci kolumn dopasowanych do tresci, ...
     adjustWidths(S);
@@ -297,6 +612,110 @@ void wndPaths(int startId, string *itinerary[], int n) {
 }
 
 
+void wndQueries(string *queries[], int n) {
+    // Inicjalizacja siatki napisow
+    SGrid *S = new SGrid;
+    initGrid(S, n, 3);
+
+    cout << endl;
+    // Ustawienie tytulu i naglowkow siatki
+    S->title = "Tablica wynikow obliczen wsadowych";
+    S->headers[0] = "z wezla";
+    S->headers[1] = "do wezla";
+    S->headers[2] = "  dystans  ";
+
+    // Wypelnienie siatki z lista wynikow zapytan, tj. ...
+    for (int i = 0; i < n; i++) {
+        S->cells[i][0] = queries[i][0] + "  ";      // z wezla
+        S->cells[i][1] = queries[i][1] + "  ";      // do wezla
+        S->cells[i][2] = queries[i][2] + "  ";      // dystans
+    }
+    // Ustawienie szerokosci kolumn dopasowanych do tresci, ...
+    adjustWidths(S);
+    // ... a takze kierunkow wyrownywania napisow ...
+    S->align[0] = 1;
+    S->align[1] = 1;
+    S->align[2] = 1;
+    // ... i wydrukowanie siatki napisow
+    printGrid(S);
+    cout << n << " wierszy";
+
+    // Skasowanie siatki napisow
+    killGrid(S);
+    delete S;
+}
+
+
+void wndScaling(string *rows[], int n) {
+    // Inicjalizacja siatki napisow
+    SGrid *S = new SGrid;
+    initGrid(S, n, 4);
+
+    cout << endl;
+    // Ustawienie tytulu i naglowkow siatki
+    S->title = "Skalowanie algorytmu delta-stepping";
+    S->headers[0] = "watki";
+    S->headers[1] = "czas [us]";
+    S->headers[2] = "przyspieszenie";
+    S->headers[3] = "zgodnosc";
+
+    // Wypelnienie siatki wynikami pomiarow, tj. ...
+    for (int i = 0; i < n; i++) {
+        S->cells[i][0] = rows[i][0] + "  ";      // watki
+        S->cells[i][1] = rows[i][1] + "  ";      // czas
+        S->cells[i][2] = rows[i][2] + "  ";      // przyspieszenie
+        S->cells[i][3] = rows[i][3];             // zgodnosc
+    }
+    // Ustawienie szerokosci kolumn dopasowanych do tresci, ...
+    adjustWidths(S);
+    // ... a takze kierunkow wyrownywania napisow ...
+    S->align[0] = 1;
+    S->align[1] = 1;
+    S->align[2] = 1;
+    // ... i wydrukowanie siatki napisow
+    printGrid(S);
+    cout << endl;
+
+    // Skasowanie siatki napisow
+    killGrid(S);
+    delete S;
+}
+
+
+void wndMatrix(string title, string *cells[], int rows, int cols) {
+    // Inicjalizacja siatki napisow
+    SGrid *S = new SGrid;
+    initGrid(S, rows, cols +1);
+
+    cout << endl;
+    // Ustawienie tytulu i naglowkow siatki (pierwszy wiersz tablicy napisow
+    // - Id wezlow koncowych)
+    S->title = title;
+    S->headers[0] = "wezel ";
+    for (int j = 1; j <= cols; j++)
+        S->headers[j] = cells[0][j];
+
+    // Wypelnienie siatki wierszami macierzy, tj. ...
+    for (int i = 0; i < rows; i++) {
+        S->cells[i][0] = cells[i +1][0] + " ";    // wezel zrodlowy
+        for (int j = 1; j <= cols; j++)
+            S->cells[i][j] = cells[i +1][j];      // odleglosci
+    }
+    // Ustawienie szerokosci kolumn dopasowanych do tresci, ...
+    adjustWidths(S);
+    // ... a takze kierunkow wyrownywania napisow ...
+    for (int j = 0; j <= cols; j++)
+        S->align[j] = 1;
+    // ... i wydrukowanie siatki napisow
+    printGrid(S);
+    cout << endl;
+
+    // Skasowanie siatki napisow
+    killGrid(S);
+    delete S;
+}
+
+
 /* Funkcje wydruku i obslugi dialogow */
 
 
@@ -363,6 +782,24 @@ int dlgQuit() {
 }
 
 
+int dlgMapFile() {
+    // Wydrukowanie zapytania o odwzorowanie tablicy w pliku,
+    // wczytanie, interpretacja i zwrocenie kodu decyzji uzytkownika
+    return dlgYesNo(
+        "\nCzy zapisac tablice w pliku binarnym (odwzorowanym w pamieci)? [T/N]  "
+    );
+}
+
+
+int dlgSaveTable() {
+    // Wydrukowanie zapytania o zapis tablicy w pliku,
+    // wczytanie, interpretacja i zwrocenie kodu decyzji uzytkownika
+    return dlgYesNo(
+        "Czy zapisac tablice w pliku na dysku? [T/N]  "
+    );
+}
+
+
 int dlgOptionsDSP() {
     // Wydrukowanie tresci dialogowej
     cout << "Wybierz opcje:  ";
@@ -383,12 +820,15 @@ int dlgOptionsDSP() {
             // Interakcja: opcja 2.
             case '2': return 2;
 
+            // Interakcja: opcja 3.
+            case '3': return 3;
+
             case 'c': cKey = 'c';
             case 'C': cout << endl;
                 return DLG_CANCEL;
 
             // Interakcja: nieznany skrot
-            default: cout << "Opcja 1, 2, czy przerwac? [1/2/C]  ";
+            default: cout << "Opcja 1, 2, 3, czy przerwac? [1/2/3/C]  ";
             cKey = '?';
         }
     } while (cKey == '?');
@@ -398,6 +838,37 @@ int dlgOptionsDSP() {
 }
 
 
+int dlgOptions(int count) {
+    // Wydrukowanie tresci dialogowej
+    cout << "Wybierz opcje:  ";
+
+    char cKey;
+    do {
+        // Wczytanie skrotu decyzji
+        cin >> cKey;
+        cin.ignore(80, '\n');
+        cin.clear();
+
+        // Interakcja: opcja od 1. do podanej ilosci opcji
+        if ('1' <= cKey && cKey < '1' + count)
+            return cKey - '0';
+
+        // Interakcja: rezygnacja
+        if (cKey == 'c' || cKey == 'C') {
+            cout << endl;
+            return DLG_CANCEL;
+        }
+
+        // Interakcja: nieznany skrot
+        cout << "Opcja od 1 do " << count << ", czy przerwac? [1-" << count << "/C]  ";
+        cKey = '?';
+    } while (cKey == '?');
+
+    // Zwrocenie kodu bledu
+    return DLG_ERROR;
+}
+
+
 bool _isCardinal(string s) {
     // Proba konwersji napisu na wartosc calkowita
     int v = atoi(s.c_str());
@@ -454,3 +925,50 @@ int dlgNodeId(string ask, int lBound, int uBound, int &Id) {
     // Zwrocenie kodu bledu
     return DLG_ERROR;
 }
+
+
+int dlgNumber(string ask, int lBound, int uBound, int &value) {
+    // Dodaj informacje o oczekiwanym zakresie wartosci
+    ask = ask + " (od " + to_string(lBound) + " do " + to_string(uBound) + "):  ";
+
+    int tries = 3;
+    do {
+        cout << ask;
+        // Interakcja: wczytanie wartosci
+        string text;
+        cin >> text;
+        cin.ignore(80, '\n');
+        cin.clear();
+
+        // Proba konwersji napisu na wartosc calkowita i sprawdzenie,
+        // czy wartosc ta lezy w odpowiednim zakresie
+        value = _isCardinal(text) ? atoi(text.c_str()) : -1;
+        if (lBound <= value && value <= uBound)
+            return DLG_OK;
+        // W razie wyczerpania limitu prob - przerwanie dialogu
+        if (--tries)
+            cout << "Wartosc spoza zakresu!";
+        else {
+            cout << "\nPrzerwano wprowadzanie wartosci.\n\n";
+            return DLG_CANCEL;
+        }
+    } while (tries);
+
+    // Zwrocenie kodu bledu
+    return DLG_ERROR;
+}
+
+
+string dlgFilename() {
+    // Wydrukowanie tresci dialogowej
+    cout << "\nPodaj nazwe pliku:  ";
+
+    // Interakcja: wczytanie nazwy pliku
+    string name;
+    cin >> name;
+    cin.ignore(80, '\n');
+    cin.clear();
+
+    // Zwrocenie nazwy pliku
+    return name;
+}
@@ -21,19 +21,52 @@ void msgDataIncorrect(string filename);
 void msgDataIncomplete(string filename);
 void msgNodeNotFound();
 void msgUnknownError();
+void msgNoBuckets(int maxWeight, int limit);
+void msgLandmarks(int count, long long time, long long memory);
+void msgHierarchy(int shortcuts, long long time);
+void msgArcFlags(int cells, int boundary, long long time, long long memory);
+void msgBatchInfo();
+void msgHubLabels(long long entries, int nodes, int maxLabel, long long memory, long long time);
+void msgNoHubLabels();
+void msgHopMatrix(int diameter, double average, long long unreachable, long long memory, long long time);
+void msgNoMatrix();
+void msgManyInfo();
+void msgManyTable(long long buckets, long long settled, int searches, long long time);
+void msgDistMatrix(long long diameter, long long memory, long long time);
+void msgDistTable(long long settled, long long memory, long long time);
+void msgUpdateInfo();
+void msgOverlayInfo();
+void msgPathSet(int searches, int reused, long long settled, long long time);
+void msgFacilityInfo();
+void msgWeightUpdates(int count, int rejected, int affected, long long settled, long long time,
+                      long long fullTime, string same);
 
 void mnuOptionsDSP();
+void mnuOptionsQueue(int current);
+void mnuOptionsMode(int current);
+void mnuOptionsOracle();
+void mnuOptionsParallel(int threads, int hardware);
+void mnuOptionsAllPairs();
+void mnuOptionsFacilities(int count);
 
 void wndHelp();
 void wndGraph(string properties[]);
 void wndNodes(string *nodes[], int n);
 void wndEdges(string *edges[], int n);
 void wndPaths(int startId, string *itinerary[], int n);
+void wndQueries(string *queries[], int n);
+void wndScaling(string *rows[], int n);
+void wndMatrix(string title, string *cells[], int rows, int cols);
 
 int dlgNodeId(string ask, int lBound, int uBound, int &Id);
+int dlgNumber(string ask, int lBound, int uBound, int &value);
 int dlgOverride();
 int dlgRetry();
 int dlgQuit();
+int dlgMapFile();
+int dlgSaveTable();
 int dlgOptionsDSP();
+int dlgOptions(int count);
+string dlgFilename();
 
 #endif // AC_SHELL_DLGS_H